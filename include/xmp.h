@@ -1,6 +1,8 @@
 #ifndef XMP_H
 #define XMP_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -43,6 +45,7 @@ extern "C" {
 #define XMP_FORMAT_8BIT		(1 << 0) /* Mix to 8-bit instead of 16 */
 #define XMP_FORMAT_UNSIGNED	(1 << 1) /* Mix to unsigned samples */
 #define XMP_FORMAT_MONO		(1 << 2) /* Mix to mono instead of stereo */
+#define XMP_FORMAT_FLOAT	(1 << 3) /* Mix to 32-bit float samples */
 
 /* player parameters */
 #define XMP_PLAYER_AMP		0	/* Amplification factor */
@@ -59,11 +62,16 @@ extern "C" {
 #define XMP_PLAYER_MODE 	11	/* Player personality */
 #define XMP_PLAYER_MIXER_TYPE	12	/* Current mixer (read only) */
 #define XMP_PLAYER_VOICES	13	/* Maximum number of mixer voices */
+#define XMP_PLAYER_THREADS	14	/* Number of mixer threads */
+#define XMP_PLAYER_BYPASS	15	/* Advance without mixing */
+#define XMP_PLAYER_SCAN		16	/* Sequence scan control */
+#define XMP_PLAYER_SEEK_MEMORY	17	/* Memory for seek snapshots */
 
 /* interpolation types */
 #define XMP_INTERP_NEAREST	0	/* Nearest neighbor */
 #define XMP_INTERP_LINEAR	1	/* Linear (default) */
 #define XMP_INTERP_SPLINE	2	/* Cubic spline */
+#define XMP_INTERP_SINC		3	/* Windowed sinc (8-tap FIR) */
 
 /* dsp effect types */
 #define XMP_DSP_LOWPASS		(1 << 0) /* Lowpass filter effect */
@@ -100,6 +108,11 @@ extern "C" {
 
 /* sample flags */
 #define XMP_SMPCTL_SKIP		(1 << 0) /* Don't load samples */
+#define XMP_SMPCTL_LAZY		(1 << 1) /* Load samples when first played */
+
+/* sequence scan control */
+#define XMP_SCAN_LOAD		0	/* Scan sequences when loading (default) */
+#define XMP_SCAN_DEFER		1	/* Scan sequences when first needed */
 
 /* limits */
 #define XMP_MAX_KEYS		121	/* Number of valid keys */
@@ -325,6 +338,8 @@ LIBXMP_EXPORT void        xmp_release_module  (xmp_context);
 LIBXMP_EXPORT int         xmp_start_player    (xmp_context, int, int);
 LIBXMP_EXPORT int         xmp_play_frame      (xmp_context);
 LIBXMP_EXPORT int         xmp_play_buffer     (xmp_context, void *, int, int);
+LIBXMP_EXPORT int         xmp_render          (xmp_context, void *, int, int);
+LIBXMP_EXPORT long        xmp_render_module   (xmp_context, void *, long, int);
 LIBXMP_EXPORT void        xmp_get_frame_info  (xmp_context, struct xmp_frame_info *);
 LIBXMP_EXPORT void        xmp_end_player      (xmp_context);
 LIBXMP_EXPORT void        xmp_inject_event    (xmp_context, int, struct xmp_event *);
@@ -338,6 +353,9 @@ LIBXMP_EXPORT int         xmp_set_tempo_factor(xmp_context, double);
 LIBXMP_EXPORT void        xmp_stop_module     (xmp_context);
 LIBXMP_EXPORT void        xmp_restart_module  (xmp_context);
 LIBXMP_EXPORT int         xmp_seek_time       (xmp_context, int);
+LIBXMP_EXPORT int         xmp_get_state_size  (xmp_context);
+LIBXMP_EXPORT int         xmp_save_state      (xmp_context, void *, int);
+LIBXMP_EXPORT int         xmp_restore_state   (xmp_context, const void *, int);
 LIBXMP_EXPORT int         xmp_channel_mute    (xmp_context, int, int);
 LIBXMP_EXPORT int         xmp_channel_vol     (xmp_context, int, int);
 LIBXMP_EXPORT int         xmp_set_player      (xmp_context, int, int);
@@ -345,6 +363,10 @@ LIBXMP_EXPORT int         xmp_get_player      (xmp_context, int);
 LIBXMP_EXPORT int         xmp_set_instrument_path (xmp_context, char *);
 LIBXMP_EXPORT int         xmp_load_module_from_memory (xmp_context, void *, long);
 LIBXMP_EXPORT int         xmp_load_module_from_file (xmp_context, void *, long);
+LIBXMP_EXPORT int         xmp_load_shared     (xmp_context, char *);
+LIBXMP_EXPORT int         xmp_attach_module   (xmp_context, xmp_context);
+LIBXMP_EXPORT int         xmp_set_allocator   (void *(*)(size_t), void *(*)(size_t, size_t), void *(*)(void *, size_t), void (*)(void *));
+LIBXMP_EXPORT int         xmp_set_scan_cache  (xmp_context, char *);
 
 /* External sample mixer API */
 LIBXMP_EXPORT int         xmp_start_smix       (xmp_context, int, int);
@@ -44,6 +44,29 @@ const struct format_loader *const format_loader[5] = {
 	NULL
 };
 
+#define MAGIC(l,o,m) { &libxmp_loader_##l, o, sizeof (m) - 1, m, 1 }
+#define MAGIC_ALSO(l,o,m) { &libxmp_loader_##l, o, sizeof (m) - 1, m, 0 }
+
+/* Loaders matching these signatures are tested before the others. Loaders
+ * listed with MAGIC() accept no other signatures and aren't tested for
+ * modules without one of them, loaders listed with MAGIC_ALSO() may also
+ * accept other modules and are probed for all of them.
+ */
+const struct format_magic format_magic[] = {
+	MAGIC(xm,	0,	"Extended Module: "),
+	MAGIC_ALSO(mod,	1080,	"M.K."),
+	MAGIC_ALSO(mod,	1080,	"M!K!"),
+	MAGIC_ALSO(mod,	1080,	"M&K!"),
+	MAGIC_ALSO(mod,	1080,	"N.T."),
+	MAGIC_ALSO(mod,	1080,	"6CHN"),
+	MAGIC_ALSO(mod,	1080,	"8CHN"),
+#ifndef LIBXMP_CORE_DISABLE_IT
+	MAGIC(it,	0,	"IMPM"),
+#endif
+	MAGIC(s3m,	44,	"SCRM"),
+	{ NULL }
+};
+
 static const char *_farray[5] = { NULL };
 
 char **format_list()
@@ -0,0 +1,102 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2018 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* Allocation hooks set with xmp_set_allocator(). This file must not use
+ * the allocation macros from common.h, since it calls the C library
+ * functions by default.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+#undef strdup
+
+/* NULL hooks use the C library functions */
+void *(*libxmp_malloc_func)(size_t);
+void *(*libxmp_calloc_func)(size_t, size_t);
+void *(*libxmp_realloc_func)(void *, size_t);
+void (*libxmp_free_func)(void *);
+
+void libxmp_reset_allocator(void)
+{
+	libxmp_malloc_func = NULL;
+	libxmp_calloc_func = NULL;
+	libxmp_realloc_func = NULL;
+	libxmp_free_func = NULL;
+}
+
+void *libxmp_malloc(size_t size)
+{
+	if (libxmp_malloc_func != NULL) {
+		return libxmp_malloc_func(size);
+	}
+
+	return malloc(size);
+}
+
+void *libxmp_calloc(size_t num, size_t size)
+{
+	if (libxmp_calloc_func != NULL) {
+		return libxmp_calloc_func(num, size);
+	}
+
+	return calloc(num, size);
+}
+
+void *libxmp_realloc(void *ptr, size_t size)
+{
+	if (libxmp_realloc_func != NULL) {
+		return libxmp_realloc_func(ptr, size);
+	}
+
+	return realloc(ptr, size);
+}
+
+void libxmp_free(void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+	if (libxmp_free_func != NULL) {
+		libxmp_free_func(ptr);
+	} else {
+		free(ptr);
+	}
+}
+
+char *libxmp_strdup(const char *s)
+{
+	size_t len = strlen(s) + 1;
+	char *ret = libxmp_malloc(len);
+
+	if (ret != NULL) {
+		memcpy(ret, s, len);
+	}
+
+	return ret;
+}
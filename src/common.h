@@ -7,6 +7,7 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "xmp.h"
 
@@ -152,6 +153,26 @@ int libxmp_snprintf (char *, size_t, const char *, ...);
 #define vsnprintf libxmp_vsnprintf
 #endif
 
+/* Memory allocation, in alloc.c. Everything allocated by the library goes
+ * through the functions set with xmp_set_allocator().
+ */
+void	*libxmp_malloc	(size_t);
+void	*libxmp_calloc	(size_t, size_t);
+void	*libxmp_realloc	(void *, size_t);
+void	libxmp_free	(void *);
+char	*libxmp_strdup	(const char *);
+void	libxmp_reset_allocator(void);
+extern void *(*libxmp_malloc_func)(size_t);
+extern void *(*libxmp_calloc_func)(size_t, size_t);
+extern void *(*libxmp_realloc_func)(void *, size_t);
+extern void (*libxmp_free_func)(void *);
+#undef strdup
+#define malloc  libxmp_malloc
+#define calloc  libxmp_calloc
+#define realloc libxmp_realloc
+#define free    libxmp_free
+#define strdup  libxmp_strdup
+
 /* Quirks */
 #define QUIRK_S3MLOOP	(1 << 0)	/* S3M loop mode */
 #define QUIRK_ENVFADE	(1 << 1)	/* Fade at end of envelope */
@@ -250,6 +271,11 @@ struct extra_sample_data {
 	double c5spd;
 };
 
+struct shared_module;
+struct module_arena;
+struct lazy_data;
+struct scan_job;
+
 struct module_data {
 	struct xmp_module mod;
 
@@ -280,16 +306,22 @@ struct module_data {
 	int period_type;
 	int smpctl;			/* sample control flags */
 	int defpan;			/* default pan setting */
+	int scanctl;			/* sequence scan control */
 	struct ord_data xxo_info[XMP_MAX_MOD_LENGTH];
 	int num_sequences;
 	struct xmp_sequence seq_data[MAX_SEQUENCES];
 	char *instrument_path;
+	char *scan_cache;		/* scan cache directory */
 	void *extra;			/* format-specific extra fields */
 	char **scan_cnt;		/* scan counters */
+	struct scan_job *scan_job;	/* deferred sequence scan */
 	struct extra_sample_data *xtra;
 #ifndef LIBXMP_CORE_DISABLE_IT
 	struct xmp_sample *xsmp;	/* sustain loop samples */
 #endif
+	struct shared_module *shared;	/* module data shared with other contexts */
+	struct module_arena *arena;	/* patterns, tracks and subinstruments */
+	struct lazy_data *lazy;		/* samples loaded when first played */
 };
 
 
@@ -306,6 +338,7 @@ struct player_data {
 
 	double current_time;
 	double frame_time;
+	double play_time;		/* time played since the start */
 
 	int loop_count;
 	int sequence;
@@ -357,6 +390,13 @@ struct player_data {
 		} *virt_channel;
 	
 		struct mixer_voice *voice_array;
+
+		struct virt_heap {
+			int *voc;	/* voice numbers in heap order */
+			int *pos;	/* heap index of each voice or -1 */
+			int num;	/* number of voices in the heap */
+			int by_vol;	/* order by volume, then voice number */
+		} free_heap, steal_heap;
 	} virt;
 
 	struct xmp_event inject_event[XMP_MAX_CHANNELS];
@@ -367,8 +407,23 @@ struct player_data {
 		char *in_buffer;
 	} buffer_data;
 
+	struct {
+		int consumed;		/* frames of this tick already rendered */
+		int in_size;		/* frames in this tick */
+	} render_data;
+
+	struct {
+		int sequence;		/* sequence the snapshots belong to */
+		int interval;		/* time between snapshots in ms */
+		int num;		/* number of snapshot slots */
+		int record;		/* player is on the snapshot timeline */
+		int memory;		/* memory for snapshots in KB, or 0 */
+		struct player_snapshot *slot;
+	} snapshot;
+
 #ifndef LIBXMP_CORE_PLAYER
 	int st26_speed;			/* For IceTracker speed effect */
+	unsigned char **invloop_data;	/* samples changed by invert loop */
 #endif
 	int filter;			/* Amiga led filter */
 };
@@ -383,6 +438,11 @@ struct mixer_data {
 	char* buffer;		/* output buffer */
 	int32* buf32;		/* temporary buffer for 32 bit samples */
 	int numvoc;		/* default softmixer voices number */
+	int numthreads;		/* number of mixer threads */
+	struct mixer_pool *pool;	/* mixer threads, NULL if single thread */
+	char *voice_reset;	/* voices to reset after threaded mixing */
+	struct filter_cache *filter;	/* IT filter coefficients */
+	int bypass;		/* advance voices without mixing */
 	int ticksize;
 	int dtright;		/* anticlick control, right channel */
 	int dtleft;		/* anticlick control, left channel */
@@ -404,8 +464,21 @@ char	*libxmp_adjust_string	(char *);
 int	libxmp_exclude_match	(const char *);
 int	libxmp_prepare_scan	(struct context_data *);
 int	libxmp_scan_sequences	(struct context_data *);
+int	libxmp_scan_defer	(struct context_data *);
+void	libxmp_scan_wait	(struct context_data *);
+void	libxmp_scan_poll	(struct context_data *);
+void	libxmp_scan_cancel	(struct context_data *);
+int	libxmp_scan_visit	(struct context_data *);
+int	libxmp_scan_cache_load	(struct context_data *);
+void	libxmp_scan_cache_save	(struct context_data *);
 int	libxmp_get_sequence	(struct context_data *, int);
 int	libxmp_set_player_mode	(struct context_data *);
+void	libxmp_reset_player_mode(struct context_data *);
+void	*libxmp_arena_alloc	(struct module_data *, size_t);
+void	libxmp_arena_free	(struct module_data *);
+void	libxmp_lazy_done	(struct module_data *);
+void	libxmp_lazy_release	(struct module_data *);
+void	libxmp_lazy_load	(struct module_data *, int);
 
 int8	read8s			(FILE *, int *err);
 uint8	read8			(FILE *, int *err);
@@ -28,7 +28,10 @@
 
 #include "format.h"
 #include "virtual.h"
+#include "player.h"
 #include "mixer.h"
+#include "mix_thread.h"
+#include "state.h"
 
 const char *xmp_version = XMP_VERSION;
 const unsigned int xmp_vercode = XMP_VERCODE;
@@ -45,6 +48,7 @@ xmp_context xmp_create_context()
 	ctx->state = XMP_STATE_UNLOADED;
 	ctx->m.defpan = 100;
 	ctx->s.numvoc = SMIX_NUMVOC;
+	ctx->s.numthreads = 1;
 
 	return (xmp_context)ctx;
 }
@@ -56,6 +60,7 @@ void xmp_free_context(xmp_context opaque)
 	if (ctx->state > XMP_STATE_UNLOADED)
 		xmp_release_module(opaque);
 
+	free(ctx->m.scan_cache);
 	free(opaque);
 }
 
@@ -68,6 +73,8 @@ static void set_position(struct context_data *ctx, int pos, int dir)
 	int seq;
 	int has_marker;
 
+	libxmp_scan_wait(ctx);
+
 	/* If dir is 0, we can jump to a different sequence */
 	if (dir == 0) {
 		seq = libxmp_get_sequence(ctx, pos);
@@ -79,6 +86,9 @@ static void set_position(struct context_data *ctx, int pos, int dir)
 		return;
 	}
 
+	/* We're leaving the snapshot timeline */
+	p->snapshot.record = 0;
+
 	has_marker = HAS_QUIRK(QUIRK_MARKER);
 
 	if (seq >= 0) {
@@ -149,6 +159,8 @@ int xmp_prev_position(xmp_context opaque)
 	if (ctx->state < XMP_STATE_PLAYING)
 		return -XMP_ERROR_STATE;
 
+	libxmp_scan_wait(ctx);
+
 	if (p->pos == m->seq_data[p->sequence].entry_point) {
 		set_position(ctx, -1, -1);
 	} else if (p->pos > m->seq_data[p->sequence].entry_point) {
@@ -194,10 +206,13 @@ int xmp_set_row(xmp_context opaque, int row)
 	if (row >= mod->xxp[pattern]->rows)
 		return -XMP_ERROR_INVALID;
 
+	libxmp_scan_wait(ctx);
+
 	/* See set_position. */
 	if (p->pos < 0)
 		p->pos = 0;
 	p->ord = p->pos;
+	p->snapshot.record = 0;
 	p->row = row;
 	p->frame = -1;
 	f->num_rows = mod->xxp[mod->xxo[p->ord]]->rows;
@@ -214,6 +229,7 @@ void xmp_stop_module(xmp_context opaque)
 		return;
 
 	p->pos = -2;
+	p->snapshot.record = 0;
 }
 
 void xmp_restart_module(xmp_context opaque)
@@ -226,6 +242,7 @@ void xmp_restart_module(xmp_context opaque)
 
 	p->loop_count = 0;
 	p->pos = -1;
+	p->snapshot.record = 0;
 }
 
 int xmp_seek_time(xmp_context opaque, int time)
@@ -233,32 +250,100 @@ int xmp_seek_time(xmp_context opaque, int time)
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
-	int i, t;
+	struct mixer_data *s = &ctx->s;
+	int i, t, loop_count, bypass;
 
 	if (ctx->state < XMP_STATE_PLAYING)
 		return -XMP_ERROR_STATE;
 
-	for (i = m->mod.len - 1; i >= 0; i--) {
-		int pat = m->mod.xxo[i];
-		if (pat >= m->mod.pat) {
-			continue;
-		}
-		if (libxmp_get_sequence(ctx, i) != p->sequence) {
-			continue;
+	libxmp_scan_wait(ctx);
+
+	/* Don't play past the end of the sequence */
+	if (time > p->scan[p->sequence].time) {
+		time = p->scan[p->sequence].time;
+	}
+
+	/* Without a snapshot to start from, go to the nearest order */
+	if (libxmp_snapshot_seek(ctx, time) < 0) {
+		for (i = m->mod.len - 1; i >= 0; i--) {
+			int pat = m->mod.xxo[i];
+			if (pat >= m->mod.pat) {
+				continue;
+			}
+			if (libxmp_get_sequence(ctx, i) != p->sequence) {
+				continue;
+			}
+			t = m->xxo_info[i].time;
+			if (time >= t) {
+				set_position(ctx, i, 1);
+				break;
+			}
 		}
-		t = m->xxo_info[i].time;
-		if (time >= t) {
-			set_position(ctx, i, 1);
-			break;
+		if (i < 0) {
+			xmp_set_position(opaque, 0);
 		}
+
+		return p->pos < 0 ? 0 : p->pos;
 	}
-	if (i < 0) {
-		xmp_set_position(opaque, 0);
+
+	/* Play up to the tick containing the requested time */
+	loop_count = p->loop_count;
+	bypass = s->bypass;
+	s->bypass = 1;
+	while (p->play_time + p->frame_time <= time) {
+		if (libxmp_play_frame(ctx) < 0 || p->loop_count != loop_count)
+			break;
 	}
+	s->bypass = bypass;
 
 	return p->pos < 0 ? 0 : p->pos;
 }
 
+int xmp_get_state_size(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+
+	if (ctx->state < XMP_STATE_PLAYING)
+		return -XMP_ERROR_STATE;
+
+	return libxmp_state_size(ctx);
+}
+
+int xmp_save_state(xmp_context opaque, void *buffer, int size)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+
+	if (ctx->state < XMP_STATE_PLAYING)
+		return -XMP_ERROR_STATE;
+
+	if (size < 0 || (size_t)size < libxmp_state_size(ctx))
+		return -XMP_ERROR_INVALID;
+
+	libxmp_scan_wait(ctx);
+	libxmp_state_save(ctx, buffer);
+
+	return 0;
+}
+
+int xmp_restore_state(xmp_context opaque, const void *buffer, int size)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+
+	if (ctx->state < XMP_STATE_PLAYING)
+		return -XMP_ERROR_STATE;
+
+	libxmp_scan_wait(ctx);
+
+	if (size < 0 || libxmp_state_restore(ctx, buffer, size) < 0)
+		return -XMP_ERROR_INVALID;
+
+	/* We can't tell where this state came from */
+	p->snapshot.record = 0;
+
+	return 0;
+}
+
 int xmp_channel_mute(xmp_context opaque, int chn, int status)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -333,16 +418,19 @@ int xmp_set_player__(xmp_context opaque, int parm, int val)
 	int ret = -XMP_ERROR_INVALID;
 
 
-	if (parm == XMP_PLAYER_SMPCTL || parm == XMP_PLAYER_DEFPAN) {
+	if (parm == XMP_PLAYER_SMPCTL || parm == XMP_PLAYER_DEFPAN ||
+	    parm == XMP_PLAYER_SCAN) {
 		/* these should be set before loading the module */
 		if (ctx->state >= XMP_STATE_LOADED) {
 			return -XMP_ERROR_STATE;
 		}
-	} else if (parm == XMP_PLAYER_VOICES) {
+	} else if (parm == XMP_PLAYER_VOICES || parm == XMP_PLAYER_THREADS) {
 		/* these should be set before start playing */
 		if (ctx->state >= XMP_STATE_PLAYING) {
 			return -XMP_ERROR_STATE;
 		}
+	} else if (parm == XMP_PLAYER_SEEK_MEMORY) {
+		/* this can be set at any time */
 	} else if (ctx->state < XMP_STATE_PLAYING) {
 		return -XMP_ERROR_STATE;
 	}
@@ -361,7 +449,7 @@ int xmp_set_player__(xmp_context opaque, int parm, int val)
 		}
 		break;
 	case XMP_PLAYER_INTERP:
-		if (val >= XMP_INTERP_NEAREST && val <= XMP_INTERP_SPLINE) {
+		if (val >= XMP_INTERP_NEAREST && val <= XMP_INTERP_SINC) {
 			s->interp = val;
 			ret = 0;
 		}
@@ -381,6 +469,7 @@ int xmp_set_player__(xmp_context opaque, int parm, int val)
 		p->flags = val;
 		if (vblank != (p->flags & XMP_FLAGS_VBLANK))
 			libxmp_scan_sequences(ctx);
+		libxmp_snapshot_free(ctx);
 		ret = 0;
 		break; }
 	case XMP_PLAYER_SMPCTL:
@@ -413,11 +502,48 @@ int xmp_set_player__(xmp_context opaque, int parm, int val)
 		p->mode = val;
 		libxmp_set_player_mode(ctx);
 		libxmp_scan_sequences(ctx);
+		libxmp_snapshot_free(ctx);
 		ret = 0;
 		break;
 	case XMP_PLAYER_VOICES:
 		s->numvoc = val;
 		break;
+
+	/* 4.5 */
+	case XMP_PLAYER_THREADS:
+#ifdef MIXER_THREADS
+		if (val >= 1 && val <= MIXER_MAX_THREADS) {
+#else
+		if (val == 1) {
+#endif
+			s->numthreads = val;
+			ret = 0;
+		}
+		break;
+	case XMP_PLAYER_BYPASS:
+		s->bypass = val != 0;
+		if (s->bypass) {
+			/* Nothing is mixed from now on, so make the rest of
+			 * the current tick and the frame buffer silent */
+			memset(s->buf32, 0, XMP_MAX_FRAMESIZE * sizeof(int));
+			libxmp_mixer_downmix(ctx, s->buffer, 0, XMP_MAX_FRAMESIZE);
+		}
+		ret = 0;
+		break;
+	case XMP_PLAYER_SCAN:
+		if (val == XMP_SCAN_LOAD || val == XMP_SCAN_DEFER) {
+			m->scanctl = val;
+			ret = 0;
+		}
+		break;
+	case XMP_PLAYER_SEEK_MEMORY:
+		if (val >= 0) {
+			p->snapshot.memory = val;
+			/* Recording starts again with the new budget */
+			libxmp_snapshot_free(ctx);
+			ret = 0;
+		}
+		break;
 	}
 
 	return ret;
@@ -453,7 +579,8 @@ int xmp_get_player__(xmp_context opaque, int parm)
 	struct mixer_data *s = &ctx->s;
 	int ret = -XMP_ERROR_INVALID;
 
-	if (parm == XMP_PLAYER_SMPCTL || parm == XMP_PLAYER_DEFPAN) {
+	if (parm == XMP_PLAYER_SMPCTL || parm == XMP_PLAYER_DEFPAN ||
+	    parm == XMP_PLAYER_SCAN || parm == XMP_PLAYER_SEEK_MEMORY) {
 		// can read these at any time
 	} else if (parm != XMP_PLAYER_STATE && ctx->state < XMP_STATE_PLAYING) {
 		return -XMP_ERROR_STATE;
@@ -521,6 +648,18 @@ int xmp_get_player__(xmp_context opaque, int parm)
 	case XMP_PLAYER_VOICES:
 		ret = s->numvoc;
 		break;
+	case XMP_PLAYER_THREADS:
+		ret = s->numthreads;
+		break;
+	case XMP_PLAYER_BYPASS:
+		ret = s->bypass;
+		break;
+	case XMP_PLAYER_SCAN:
+		ret = m->scanctl;
+		break;
+	case XMP_PLAYER_SEEK_MEMORY:
+		ret = p->snapshot.memory;
+		break;
 	}
 
 	return ret;
@@ -541,6 +680,7 @@ void xmp_inject_event(xmp_context opaque, int channel, struct xmp_event *e)
 
 	memcpy(&p->inject_event[channel], e, sizeof(struct xmp_event));
 	p->inject_event[channel]._flag = 1;
+	p->snapshot.record = 0;
 }
 
 int xmp_set_instrument_path(xmp_context opaque, char *path)
@@ -559,6 +699,50 @@ int xmp_set_instrument_path(xmp_context opaque, char *path)
 	return 0;
 }
 
+int xmp_set_scan_cache(xmp_context opaque, char *path)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct module_data *m = &ctx->m;
+
+	free(m->scan_cache);
+	m->scan_cache = NULL;
+
+	if (path == NULL) {
+		return 0;
+	}
+
+	m->scan_cache = strdup(path);
+	if (m->scan_cache == NULL) {
+		return -XMP_ERROR_SYSTEM;
+	}
+
+	return 0;
+}
+
+int xmp_set_allocator(void *(*malloc_fn)(size_t),
+		      void *(*calloc_fn)(size_t, size_t),
+		      void *(*realloc_fn)(void *, size_t),
+		      void (*free_fn)(void *))
+{
+	if (malloc_fn == NULL && calloc_fn == NULL &&
+	    realloc_fn == NULL && free_fn == NULL) {
+		libxmp_reset_allocator();
+		return 0;
+	}
+
+	if (malloc_fn == NULL || calloc_fn == NULL ||
+	    realloc_fn == NULL || free_fn == NULL) {
+		return -XMP_ERROR_INVALID;
+	}
+
+	libxmp_malloc_func = malloc_fn;
+	libxmp_calloc_func = calloc_fn;
+	libxmp_realloc_func = realloc_fn;
+	libxmp_free_func = free_fn;
+
+	return 0;
+}
+
 int xmp_set_tempo_factor(xmp_context opaque, double val)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -578,5 +762,8 @@ int xmp_set_tempo_factor(xmp_context opaque, double val)
 	}
 	m->time_factor = val;
 
+	/* Snapshot times don't match the new tempo */
+	libxmp_snapshot_free(ctx);
+
 	return 0;
 }
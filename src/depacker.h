@@ -20,9 +20,25 @@ extern struct depacker libxmp_depacker_s404;
 extern struct depacker libxmp_depacker_xfd;
 extern struct depacker libxmp_depacker_oxm;
 
+/* Depack the input file of the given size to a malloc'd buffer and
+ * return the buffer and its size in the last two parameters.
+ */
 struct depacker {
 	int (*const test)(unsigned char *);
-	int (*const depack)(FILE *, FILE *);
+	int (*const depack)(FILE *, long, void **, long *);
 };
 
+/* Output buffer for depackers that don't know the depacked size */
+struct depack_buffer {
+	unsigned char *data;
+	long size;		/* bytes written */
+	long alloc;		/* bytes allocated */
+};
+
+int	libxmp_depack_init	(struct depack_buffer *, long);
+int	libxmp_depack_write	(struct depack_buffer *, const void *, long);
+int	libxmp_depack_putc	(struct depack_buffer *, int);
+int	libxmp_depack_done	(struct depack_buffer *, void **, long *);
+void	libxmp_depack_free	(struct depack_buffer *);
+
 #endif
@@ -128,11 +128,10 @@ static unsigned char *read_file_data(FILE *in,
 	return NULL;
 }
 
-static int arcfs_extract(FILE *in, FILE *out)
+static int arcfs_extract(FILE *in, void **out, long *outlen)
 {
 	struct archived_file_header_tag hdr;
 	unsigned char *data, *orig_data;
-	int exitval = 0;
 
 	if (read_file_header(in, &hdr) < 0)
 		return -1;
@@ -153,6 +152,10 @@ static int arcfs_extract(FILE *in, FILE *out)
 	 */
 	switch (hdr.method) {
 	case 2:		/* no compression */
+		if (hdr.orig_size > hdr.compressed_size) {
+			free(data);
+			return -1;
+		}
 		orig_data = data;
 		break;
 
@@ -182,15 +185,13 @@ static int arcfs_extract(FILE *in, FILE *out)
 		return -1;
 	}
 
-	if (fwrite(orig_data, 1, hdr.orig_size, out) != hdr.orig_size)
-		exitval = -1;
-
 	if (orig_data != data)	/* don't free uncompressed stuff twice :-) */
-		free(orig_data);
+		free(data);
 
-	free(data);
+	*out = orig_data;
+	*outlen = hdr.orig_size;
 
-	return exitval;
+	return 0;
 }
 
 static int test_arcfs(unsigned char *b)
@@ -198,18 +199,9 @@ static int test_arcfs(unsigned char *b)
 	return !memcmp(b, "Archive\0", 8);
 }
 
-static int decrunch_arcfs(FILE * f, FILE * fo)
+static int decrunch_arcfs(FILE *f, long inlen, void **out, long *outlen)
 {
-	int ret;
-
-	if (fo == NULL)
-		return -1;
-
-	ret = arcfs_extract(f, fo);
-	if (ret < 0)
-		return -1;
-
-	return 0;
+	return arcfs_extract(f, out, outlen);
 }
 
 struct depacker libxmp_depacker_arcfs = {
@@ -562,20 +562,22 @@ static int test_bzip2(unsigned char *b)
 
 /* Example usage: decompress src_fd to dst_fd.  (Stops at end of bzip data,
    not end of file.) */
-static int decrunch_bzip2(FILE *src, FILE *dst)
+static int decrunch_bzip2(FILE *src, long inlen, void **out, long *outlen)
 {
+	struct depack_buffer dst;
 	char *outbuf;
 	bunzip_data *bd;
 	int i;
 
 	libxmp_crc32_init_B();
 
-	if(!(outbuf=malloc(IOBUF_SIZE))) return RETVAL_OUT_OF_MEMORY;
+	if(!(outbuf=malloc(IOBUF_SIZE))) return -1;
+	libxmp_depack_init(&dst,0);
 	if(!(i=start_bunzip(&bd,src,0,0))) {
 		for(;;) {
 			if((i=read_bunzip(bd,outbuf,IOBUF_SIZE)) <= 0) break;
-			if(i!=fwrite(outbuf,1,i,dst)) {
-				i=RETVAL_UNEXPECTED_OUTPUT_EOF;
+			if(libxmp_depack_write(&dst,outbuf,i) < 0) {
+				i=RETVAL_OUT_OF_MEMORY;
 				break;
 			}
 		}
@@ -585,7 +587,11 @@ static int decrunch_bzip2(FILE *src, FILE *dst)
 	if(bd->dbuf) free(bd->dbuf);
 	free(bd);
 	free(outbuf);
-	return i == 0 ? 0 : -1;
+	if (i != 0) {
+		libxmp_depack_free(&dst);
+		return -1;
+	}
+	return libxmp_depack_done(&dst, out, outlen);
 }
 
 struct depacker libxmp_depacker_bzip2 = {
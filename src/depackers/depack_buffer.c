@@ -0,0 +1,112 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2018 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * This file is part of the Extended Module Player and is distributed
+ * under the terms of the GNU Lesser General Public License. See COPYING.LIB
+ * for more information.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "depacker.h"
+
+#define MIN_ALLOC 65536
+
+static int grow(struct depack_buffer *b, long size)
+{
+	unsigned char *data;
+	long alloc;
+
+	if (size < 0) {
+		return -1;
+	}
+
+	alloc = b->alloc > 0 ? b->alloc : MIN_ALLOC;
+	while (alloc < size) {
+		if (alloc > 0x3fffffff) {
+			return -1;
+		}
+		alloc *= 2;
+	}
+
+	data = realloc(b->data, alloc);
+	if (data == NULL) {
+		return -1;
+	}
+
+	b->data = data;
+	b->alloc = alloc;
+
+	return 0;
+}
+
+/* Start an empty buffer, optionally with room for size bytes */
+int libxmp_depack_init(struct depack_buffer *b, long size)
+{
+	b->data = NULL;
+	b->size = 0;
+	b->alloc = 0;
+
+	if (size > 0) {
+		b->data = malloc(size);
+		if (b->data == NULL) {
+			return -1;
+		}
+		b->alloc = size;
+	}
+
+	return 0;
+}
+
+int libxmp_depack_write(struct depack_buffer *b, const void *buf, long len)
+{
+	if (b->size + len > b->alloc && grow(b, b->size + len) < 0) {
+		return -1;
+	}
+
+	memcpy(b->data + b->size, buf, len);
+	b->size += len;
+
+	return 0;
+}
+
+int libxmp_depack_putc(struct depack_buffer *b, int c)
+{
+	if (b->size >= b->alloc && grow(b, b->size + 1) < 0) {
+		return -1;
+	}
+
+	b->data[b->size++] = c;
+
+	return 0;
+}
+
+/* Hand the data over to the caller */
+int libxmp_depack_done(struct depack_buffer *b, void **out, long *outlen)
+{
+	unsigned char *data;
+
+	/* Give back the unused space */
+	if (b->size > 0 && b->size < b->alloc) {
+		data = realloc(b->data, b->size);
+		if (data != NULL) {
+			b->data = data;
+		}
+	}
+
+	*out = b->data;
+	*outlen = b->size;
+	b->data = NULL;
+
+	return 0;
+}
+
+void libxmp_depack_free(struct depack_buffer *b)
+{
+	free(b->data);
+	b->data = NULL;
+	b->size = 0;
+	b->alloc = 0;
+}
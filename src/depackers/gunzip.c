@@ -47,14 +47,24 @@ static int test_gzip(unsigned char *b)
 	return b[0] == 31 && b[1] == 139;
 }
 
-static int decrunch_gzip(FILE *in, FILE *out)
+static int decrunch_gzip(FILE *in, long inlen, void **out, long *outlen)
 {
 	struct member member;
+	struct depack_buffer buf;
 	int val, c;
-	uint32 crc;
+	uint32 crc, size;
 
 	libxmp_crc32_init_A();
 
+	/* The depacked size is stored at the end of the file */
+	if (fseek(in, inlen - 4, SEEK_SET) < 0) {
+		return -1;
+	}
+	size = read32l(in, NULL);
+	if (fseek(in, 0, SEEK_SET) < 0) {
+		return -1;
+	}
+
 	member.id1 = read8(in, NULL);
 	member.id2 = read8(in, NULL);
 	member.cm  = read8(in, NULL);
@@ -90,24 +100,33 @@ static int decrunch_gzip(FILE *in, FILE *out)
 		read16l(in, NULL);
 	}
 	
-	val = libxmp_inflate(in, out, &crc, 1);
-	if (val != 0) {
+	/* The size is only a hint, it's checked after depacking */
+	if (libxmp_depack_init(&buf, size < 0x10000000 ? size : 0) < 0) {
 		return -1;
 	}
 
+	val = libxmp_inflate(in, &buf, &crc, 1);
+	if (val != 0) {
+		goto err;
+	}
+
 	/* Check CRC32 */
 	val = read32l(in, NULL);
 	if (val != crc) {
-		return -1;
+		goto err;
 	}
 
 	/* Check file size */
 	val = read32l(in, NULL);
-	if (val != ftell(out)) {
-		return -1;
+	if (val != buf.size) {
+		goto err;
 	}
 
-	return 0;
+	return libxmp_depack_done(&buf, out, outlen);
+
+    err:
+	libxmp_depack_free(&buf);
+	return -1;
 }
 
 struct depacker libxmp_depacker_gzip = {
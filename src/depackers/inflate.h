@@ -1,10 +1,8 @@
 #ifndef LIBXMP_INFLATE_H
 #define LIBXMP_INFLATE_H
 
-struct inflate_data {
-	struct huffman_tree_t *huffman_tree_len_static;
-};
+struct depack_buffer;
 
-int	libxmp_inflate	(FILE *, FILE *, uint32 *, int);
+int	libxmp_inflate	(FILE *, struct depack_buffer *, uint32 *, int);
 
 #endif
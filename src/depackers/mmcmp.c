@@ -104,18 +104,21 @@ static uint32 get_bits(FILE *f, int n, struct bit_buffer *bb)
 }
 
 static void block_copy(struct block *block, struct sub_block *sub,
-		       FILE *in, FILE *out)
+		       FILE *in, uint8 *out)
 {
 	int i;
 
 	for (i = 0; i < block->sub_blk; i++, sub++) {
-		move_data(out, in, sub->unpk_size);
+		if (fread(out + sub->unpk_pos, 1, sub->unpk_size, in) == 0) {
+			break;
+		}
 	}
 }
 
 static int block_unpack_16bit(struct block *block, struct sub_block *sub,
-			       FILE *in, FILE *out)
+			       FILE *in, uint8 *out)
 {
+	uint8 *dst = out + sub->unpk_pos;
 	struct bit_buffer bb;
 	uint32 pos = 0;
 	uint32 numbits = block->num_bits;
@@ -124,9 +127,6 @@ static int block_unpack_16bit(struct block *block, struct sub_block *sub,
 	bb.count = 0;
 	bb.buffer = 0;
 
-	if (fseek(out, sub->unpk_pos, SEEK_SET) < 0) {
-		return -1;
-	}
 	if (fseek(in, block->tt_entries, SEEK_SET) < 0) {
 		return -1;
 	}
@@ -171,7 +171,8 @@ static int block_unpack_16bit(struct block *block, struct sub_block *sub,
 			}
 
 			pos++;
-			write16l(out, newval);
+			*dst++ = newval & 0xff;
+			*dst++ = (newval >> 8) & 0xff;
 		}
 
 		if (pos >= size) {
@@ -179,9 +180,7 @@ static int block_unpack_16bit(struct block *block, struct sub_block *sub,
 				break;
 
 			pos = 0;
-			if (fseek(out, sub[j].unpk_pos, SEEK_SET) < 0) {
-				return -1;
-			}
+			dst = out + sub[j].unpk_pos;
 		}
 	}
 
@@ -189,8 +188,9 @@ static int block_unpack_16bit(struct block *block, struct sub_block *sub,
 }
 
 static int block_unpack_8bit(struct block *block, struct sub_block *sub,
-			      FILE *in, FILE *out)
+			      FILE *in, uint8 *out)
 {
+	uint8 *dst = out + sub->unpk_pos;
 	struct bit_buffer bb;
 	uint32 pos = 0;
 	uint32 numbits = block->num_bits;
@@ -204,9 +204,6 @@ static int block_unpack_8bit(struct block *block, struct sub_block *sub,
 	bb.count = 0;
 	bb.buffer = 0;
 
-	if (fseek(out, sub->unpk_pos, SEEK_SET) < 0) {
-		return -1;
-	}
 	if (fseek(in, block->tt_entries, SEEK_SET) < 0) {
 		return -1;
 	}
@@ -244,7 +241,7 @@ static int block_unpack_8bit(struct block *block, struct sub_block *sub,
 			}
 
 			pos++;
-			write8(out, n);
+			*dst++ = n;
 		}
 
 		if (pos >= size) {
@@ -252,9 +249,7 @@ static int block_unpack_8bit(struct block *block, struct sub_block *sub,
 				break;
 
 			pos = 0;
-			if (fseek(out, sub[j].unpk_pos, SEEK_SET) < 0) {
-				return -1;
-			}
+			dst = out + sub[j].unpk_pos;
 		}
 	}
 
@@ -266,9 +261,10 @@ static int test_mmcmp(unsigned char *b)
 	return memcmp(b, "ziRCONia", 8) == 0;
 }
 
-static int decrunch_mmcmp(FILE *in, FILE *out)
+static int decrunch_mmcmp(FILE *in, long inlen, void **dest, long *destlen)
 {
 	struct header h;
+	uint8 *out;
 	uint32 *table;
 	uint32 i, j;
 	int error;
@@ -297,6 +293,8 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 
 	if (h.nblocks == 0)
 		goto err;
+	if (h.filesize <= 0 || h.filesize > 0x10000000)
+		goto err;
 
 	/* Block table */
 	if (fseek(in, h.blktable, SEEK_SET) < 0) {
@@ -307,9 +305,14 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 		goto err;
 	}
 
+	/* Sub-blocks that aren't unpacked are left empty */
+	if ((out = calloc(1, h.filesize)) == NULL) {
+		goto err2;
+	}
+
 	for (i = 0; i < h.nblocks; i++) {
 		table[i] = read32l(in, &error);
-		if (error != 0) goto err2;
+		if (error != 0) goto err3;
 	}
 
 	for (i = 0; i < h.nblocks; i++) {
@@ -318,11 +321,11 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 		uint8 buf[20];
 
 		if (fseek(in, table[i], SEEK_SET) < 0) {
-			goto err2;
+			goto err3;
 		}
 
 		if (fread(buf, 1, 20, in) != 20) {
-			goto err2;
+			goto err3;
 		}
 
 		block.unpk_size  = readmem32l(buf);
@@ -335,33 +338,33 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 
                 /* Sanity check */
 		if (block.unpk_size <= 0 || block.pk_size <= 0)
-			goto err2;
+			goto err3;
 		if (block.tt_entries < 0 || block.pk_size <= block.tt_entries)
-			goto err2;
+			goto err3;
 		if (block.sub_blk <= 0)
-			goto err2;
+			goto err3;
 		if (block.flags & MMCMP_COMP) {
 			if (block.flags & MMCMP_16BIT) {
 				if (block.num_bits >= 16) {
-					goto err2;
+					goto err3;
 				}
 			} else {
 				if (block.num_bits >= 8) {
-					goto err2;
+					goto err3;
 				}
 			}
 		}
 
 		sub_block = malloc(block.sub_blk * sizeof (struct sub_block));
 		if (sub_block == NULL)
-			goto err2;
+			goto err3;
 
 		for (j = 0; j < block.sub_blk; j++) {
 			uint8 buf[8];
 
 			if (fread(buf, 1, 8, in) != 8) {
 				free(sub_block);
-				goto err2;
+				goto err3;
 			}
 
 			sub_block[j].unpk_pos  = readmem32l(buf);
@@ -369,9 +372,11 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 
 	                /* Sanity check */
 			if (sub_block[j].unpk_pos < 0 ||
-			    sub_block[j].unpk_size < 0) {
+			    sub_block[j].unpk_size < 0 ||
+			    sub_block[j].unpk_size >
+					h.filesize - sub_block[j].unpk_pos) {
 				free(sub_block);
-				goto err2;
+				goto err3;
 			}
 		}
 
@@ -384,13 +389,13 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 			/* Data is 16-bit packed */
 			if (block_unpack_16bit(&block, sub_block, in, out) < 0) {
 				free(sub_block);
-				goto err2;
+				goto err3;
 			}
 		} else {
 			/* Data is 8-bit packed */
 			if (block_unpack_8bit(&block, sub_block, in, out) < 0) {
 				free(sub_block);
-				goto err2;
+				goto err3;
 			}
 		}
 
@@ -398,8 +403,14 @@ static int decrunch_mmcmp(FILE *in, FILE *out)
 	}
 
 	free(table);
+
+	*dest = out;
+	*destlen = h.filesize;
+
 	return 0;
 
+    err3:
+	free(out);
     err2:
 	free(table);
     err:
@@ -25,15 +25,22 @@ static int test_muse(unsigned char *b)
 	return 0;
 }
 
-static int decrunch_muse(FILE *f, FILE *fo)                          
-{                                                          
+static int decrunch_muse(FILE *f, long inlen, void **out, long *outlen)
+{
+	struct depack_buffer buf;
 	uint32 checksum;
-  
+
 	if (fseek(f, 24, SEEK_SET) < 0) {
 		return -1;
 	}
 
-	return libxmp_inflate(f, fo, &checksum, 0);
+	libxmp_depack_init(&buf, 0);
+	if (libxmp_inflate(f, &buf, &checksum, 0) < 0) {
+		libxmp_depack_free(&buf);
+		return -1;
+	}
+
+	return libxmp_depack_done(&buf, out, outlen);
 }
 
 struct depacker libxmp_depacker_muse = {
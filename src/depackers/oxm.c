@@ -196,8 +196,25 @@ static char *oggdec(FILE *f, int len, int res, int *newlen)
 	return (char *)pcm;
 }
 
-static int decrunch_oxm(FILE *f, FILE *fo)
+static int copy_data(struct depack_buffer *out, FILE *in, int len)
 {
+	uint8 buf[1024];
+	int l;
+
+	while (len > 0) {
+		l = fread(buf, 1, len > 1024 ? 1024 : len, in);
+		if (l <= 0 || libxmp_depack_write(out, buf, l) < 0) {
+			return -1;
+		}
+		len -= l;
+	}
+
+	return 0;
+}
+
+static int decrunch_oxm(FILE *f, long inlen, void **out, long *outlen)
+{
+	struct depack_buffer fo;
 	int i, j, pos;
 	int hlen, npat, len, plen;
 	int nins, nsmp, size;
@@ -242,22 +259,27 @@ static int decrunch_oxm(FILE *f, FILE *fo)
 	if (fseek(f, 0, SEEK_SET) < 0) {
 		return -1;
 	}
-	move_data(fo, f, pos);			/* module header + patterns */
+	libxmp_depack_init(&fo, inlen);
+	if (copy_data(&fo, f, pos) < 0) {	/* module header + patterns */
+		goto err;
+	}
 
 	for (i = 0; i < nins; i++) {
 		ilen = read32l(f, NULL);
 		if (ilen > 1024) {
 			D_(D_CRIT "ilen=%d\n", ilen);
-			return -1;
+			goto err;
 		}
 		if (fseek(f, -4, SEEK_CUR) < 0) {
-			return -1;
+			goto err;
 		}
 		if (fread(buf, ilen, 1, f) != 1) {	/* instrument header */
-			return -1;
+			goto err;
 		}
 		buf[26] = 0;
-		fwrite(buf, ilen, 1, fo);
+		if (libxmp_depack_write(&fo, buf, ilen) < 0) {
+			goto err;
+		}
 		nsmp = readmem16l(buf + 27);
 		size = readmem32l(buf + 29);
 
@@ -268,7 +290,7 @@ static int decrunch_oxm(FILE *f, FILE *fo)
 		/* Sanity check */
 		if (nsmp > 0x10 || (nsmp > 0 && size > 0x100)) {
 			D_(D_CRIT "Sanity check: nsmp=%d size=%d", nsmp, size);
-			return -1;
+			goto err;
 		}
 
 		/* Read sample headers */
@@ -276,10 +298,10 @@ static int decrunch_oxm(FILE *f, FILE *fo)
 			xi[j].len = read32l(f, NULL);
 			if (xi[j].len > MAX_SAMPLE_SIZE) {
 				D_(D_CRIT "sample %d len = %d", j, xi[j].len);
-				return -1;
+				goto err;
 			}
 			if (fread(xi[j].buf, 1, 36, f) != 36) {
-				return -1;
+				goto err;
 			}
 		}
 
@@ -294,27 +316,41 @@ static int decrunch_oxm(FILE *f, FILE *fo)
 				xi[j].len = newlen;
 
 				if (pcm[j] == NULL) {
-					return -1;
+					goto err;
 				}
 			}
 		}
 
 		/* Write sample headers */
 		for (j = 0; j < nsmp; j++) {
-			write32l(fo, xi[j].len);
-			fwrite(xi[j].buf, 1, 36, fo);
+			uint8 len32[4];
+			len32[0] = xi[j].len & 0xff;
+			len32[1] = (xi[j].len >> 8) & 0xff;
+			len32[2] = (xi[j].len >> 16) & 0xff;
+			len32[3] = (xi[j].len >> 24) & 0xff;
+			if (libxmp_depack_write(&fo, len32, 4) < 0 ||
+			    libxmp_depack_write(&fo, xi[j].buf, 36) < 0) {
+				goto err;
+			}
 		}
 
 		/* Write samples */
 		for (j = 0; j < nsmp; j++) {
 			if (xi[j].len > 0) {
-				fwrite(pcm[j], 1, xi[j].len, fo);
+				int ret = libxmp_depack_write(&fo, pcm[j], xi[j].len);
 				free(pcm[j]);
+				if (ret < 0) {
+					goto err;
+				}
 			}
 		}
 	}
 
-	return 0;
+	return libxmp_depack_done(&fo, out, outlen);
+
+    err:
+	libxmp_depack_free(&fo);
+	return -1;
 }
 
 struct depacker libxmp_depacker_oxm = {
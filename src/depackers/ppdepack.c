@@ -29,13 +29,6 @@
 /* #define val(p) ((p)[0]<<16 | (p)[1] << 8 | (p)[2]) */
 
 
-static int savefile(FILE *fo, void *mem, size_t length)
-{
-  int ok = fo && (fwrite(mem, 1, length, fo) == length);
-  return ok;
-}
-
-
 #define PP_READ_BITS(nbits, var) do {                          \
   bit_cnt = (nbits);                                           \
   while (bits_left < bit_cnt) {                                \
@@ -106,7 +99,7 @@ static int ppDecrunch(uint8 *src, uint8 *dest, uint8 *offset_lens,
   /* return (src == buf_src) ? 1 : 0; */
 }                     
 
-static int ppdepack(uint8 *data, size_t len, FILE *fo)
+static int ppdepack(uint8 *data, size_t len, void **out, long *size)
 {
   /* PP FORMAT:
    *      1 longword identifier           'PP20' or 'PX20'
@@ -159,14 +152,15 @@ static int ppdepack(uint8 *data, size_t len, FILE *fo)
     /*fprintf(stderr, "not encrypted, decrunching anyway\n"); */
     if (ppDecrunch(&data[8], output, &data[4], len-12, outlen, data[len-1])) {
       /* fprintf(stderr, "Decrunch successful! "); */
-      savefile(fo, (void *) output, outlen);
+      *out = output;
+      *size = outlen;
     } else {
+      free(output);
       success=-1;
     } 
   /*} else {
     success=-1;
   }*/
-  free(output);
   return success;
 }
 
@@ -175,19 +169,12 @@ static int test_pp(unsigned char *b)
 	return memcmp(b, "PP20", 4) == 0;
 }
 
-static int decrunch_pp(FILE *f, FILE *fo)
+static int decrunch_pp(FILE *f, long inlen, void **out, long *outlen)
 {
     uint8 *packed /*, *unpacked */;
     int plen, unplen;
-    struct stat st;
-
-    if (fo == NULL)
-        goto err;
-
-    if (fstat(fileno(f), &st) < 0)
-	goto err;
 
-    plen = st.st_size;
+    plen = inlen;
     //counter = 0;
 
     /* Amiga longwords are only on even addresses.
@@ -239,7 +226,7 @@ static int decrunch_pp(FILE *f, FILE *fo)
          goto err1;
     }
     
-    if (ppdepack (packed, plen, fo) == -1) {
+    if (ppdepack (packed, plen, out, outlen) == -1) {
 	 /*fprintf(stderr, "error while decrunching data...");*/
          goto err1;
     }
@@ -248,7 +248,7 @@ unsigned char *libxmp_convert_lzw_dynamic(unsigned char *data_in,
 	return NULL;
 }
 
-unsigned char *libxmp_read_lzw_dynamic(FILE *f, uint8 *buf, int max_bits,int use_rle,
+unsigned char *libxmp_read_lzw_dynamic(HIO_HANDLE *f, uint8 *buf, int max_bits,int use_rle,
 			unsigned long in_len, unsigned long orig_len, int q)
 {
 	uint8 *buf2, *b;
@@ -265,8 +265,8 @@ unsigned char *libxmp_read_lzw_dynamic(FILE *f, uint8 *buf, int max_bits,int use
 		goto err2;
 	}
 
-	pos = ftell(f);
-	if (fread(buf2, 1, in_len, f) != in_len) {
+	pos = hio_tell(f);
+	if (hio_read(buf2, 1, in_len, f) != in_len) {
 		if (~q & XMP_LZW_QUIRK_DSYM) {
 			goto err3;
 		}
@@ -275,7 +275,7 @@ unsigned char *libxmp_read_lzw_dynamic(FILE *f, uint8 *buf, int max_bits,int use
 	memcpy(buf, b, orig_len);
 	size = q & NOMARCH_QUIRK_ALIGN4 ? ALIGN4(data->nomarch_input_size) :
 						data->nomarch_input_size;
-	if (fseek(f, pos + size, SEEK_SET) < 0) {
+	if (hio_seek(f, pos + size, SEEK_SET) < 0) {
 		goto err4;
 	}
 	free(b);
@@ -372,20 +372,16 @@ static int test_s404(unsigned char *b)
 	return memcmp(b, "S404", 4) == 0;
 }
 
-static int decrunch_s404(FILE *in, /* size_t s, */ FILE *out)
+static int decrunch_s404(FILE *in, long inlen, void **out, long *outlen)
 {
   int32 oLen, sLen, pLen;
   uint8 *dst = NULL;
-  struct stat st;
   uint8 *buf, *src;
 
-  if (fstat(fileno(in), &st))
-    return -1;
-        
-  src = buf = malloc(st.st_size);
+  src = buf = malloc(inlen);
   if (src == NULL)
     return -1;
-  if (fread(buf, 1, st.st_size, in) != st.st_size) {
+  if (fread(buf, 1, inlen, in) != inlen) {
     goto error;
   }
 
@@ -395,7 +391,7 @@ static int decrunch_s404(FILE *in, /* size_t s, */ FILE *out)
   }
 
   /* Sanity check */
-  if (oLen < 0 || pLen < 0 || pLen + 16 < 0 || pLen + 16 >= st.st_size) {
+  if (oLen <= 0 || pLen < 0 || pLen + 16 < 0 || pLen + 16 >= inlen) {
     goto error;
   }
 
@@ -409,13 +405,10 @@ static int decrunch_s404(FILE *in, /* size_t s, */ FILE *out)
       goto error1;
   }
 
-  if (fwrite(dst, oLen, 1, out) == 0) {
-      /*fprintf(stderr,"S404 Error: fwrite() failed..\n");*/
-      goto error1;
-  }
-
-  free(dst);
   free(src);
+
+  *out = dst;
+  *outlen = oLen;
   return 0;
 
  error1:
@@ -187,12 +187,11 @@ static int skip_file_data(FILE *in,struct archived_file_header_tag *hdrp)
 }
 #endif
 
-static int arc_extract(FILE *in, FILE *out)
+static int arc_extract(FILE *in, void **out, long *outlen)
 {
 	struct archived_file_header_tag hdr;
 	/* int done = 0; */
 	unsigned char *data, *orig_data;
-	int exitval = 0;
 
 	if (!skip_sfx_header(in) || !read_file_header(in, &hdr))
 		return -1;
@@ -295,15 +294,13 @@ static int arc_extract(FILE *in, FILE *out)
 		return -1;
 	}
 
-	if (fwrite(orig_data, 1, hdr.orig_size, out) != hdr.orig_size)
-		exitval = -1;
-
 	if (orig_data != data)	/* don't free uncompressed stuff twice :-) */
-		free(orig_data);
+		free(data);
 
-	free(data);
+	*out = orig_data;
+	*outlen = hdr.orig_size;
 
-	return exitval;
+	return 0;
 }
 
 static int test_arc(unsigned char *b)
@@ -344,9 +341,9 @@ static int test_arc(unsigned char *b)
 	return 0;
 }
 
-static int decrunch_arc(FILE *f, FILE *fo)
+static int decrunch_arc(FILE *f, long inlen, void **out, long *outlen)
 {
-	return arc_extract(f, fo);
+	return arc_extract(f, out, outlen);
 }
 
 struct depacker libxmp_depacker_arc = {
@@ -52,7 +52,7 @@ static int test_compress(unsigned char *b)
  * with those of the compress() routine.  See the definitions above.
  */
 
-static int decrunch_compress(FILE * in, FILE * out)
+static int uncompress(FILE * in, struct depack_buffer *out)
 {
 	char_type *stackp;
 	code_int code;
@@ -230,7 +230,7 @@ static int decrunch_compress(FILE * in, FILE * out)
 					}
 
 					if (outpos >= OBUFSIZ) {
-						if (fwrite(outbuf, 1, outpos, out) != outpos) {
+						if (libxmp_depack_write(out, outbuf, outpos) < 0) {
 							return -1;
 							/*write_error(); */
 						}
@@ -258,12 +258,25 @@ static int decrunch_compress(FILE * in, FILE * out)
 	}
 	while (rsize > 0);
 
-	if (outpos > 0 && fwrite(outbuf, 1, outpos, out) != outpos)
+	if (outpos > 0 && libxmp_depack_write(out, outbuf, outpos) < 0)
 		return -1;
 
 	return 0;
 }
 
+static int decrunch_compress(FILE *in, long inlen, void **out, long *outlen)
+{
+	struct depack_buffer buf;
+
+	libxmp_depack_init(&buf, 0);
+	if (uncompress(in, &buf) < 0) {
+		libxmp_depack_free(&buf);
+		return -1;
+	}
+
+	return libxmp_depack_done(&buf, out, outlen);
+}
+
 struct depacker libxmp_depacker_compress = {
 	test_compress,
 	decrunch_compress
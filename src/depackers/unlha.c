@@ -1390,7 +1390,7 @@ static void decode_start_lz5(struct LhADecrData *dat)
 
 #endif
 
-static int32 LhA_Decrunch(FILE *in, FILE *out, int size, uint32 Method)
+static int32 LhA_Decrunch(FILE *in, struct depack_buffer *out, int size, uint32 Method)
 {
   struct LhADecrData *dd;
   int32 err = 0;
@@ -1514,11 +1514,10 @@ static int32 LhA_Decrunch(FILE *in, FILE *out, int size, uint32 Method)
 	
           if(c <= UCHAR_MAX)
           {
-            int res = fputc(c, out);
-            if (res < 0) {
+            if (libxmp_depack_putc(out, c) < 0) {
               goto error;
             }
-            text[dd->loc++] = res;
+            text[dd->loc++] = c;
             dd->loc &= dicsiz;
             dd->count++;
           }
@@ -1529,10 +1528,10 @@ static int32 LhA_Decrunch(FILE *in, FILE *out, int size, uint32 Method)
             dd->count += c;
             while(c--)
             {
-              int res = fputc(text[i++ & dicsiz], out);
-              if (res < 0) {
+              int res = text[i++ & dicsiz];
+              if (libxmp_depack_putc(out, res) < 0) {
                 goto error;
-              }        
+              }
               text[dd->loc++] = res;
               dd->loc &= dicsiz;
             }
@@ -1815,9 +1814,10 @@ static int test_lha(unsigned char *b) {
 		b[20] <= 3;
 }
 
-static int decrunch_lha(FILE *in, FILE *out)
+static int decrunch_lha(FILE *in, long inlen, void **out, long *outlen)
 {
 	struct lha_data data;
+	struct depack_buffer buf;
 
 	while (1) {
 		if (get_header(in, &data) < 0)
@@ -1837,7 +1837,18 @@ static int decrunch_lha(FILE *in, FILE *out)
 			}
 			continue;
 		}
-		return LhA_Decrunch(in, out, data.original_size, data.method);
+
+		/* Sanity check */
+		if (data.original_size <= 0 || data.original_size > 0x10000000)
+			return -1;
+
+		if (libxmp_depack_init(&buf, data.original_size) < 0)
+			return -1;
+		if (LhA_Decrunch(in, &buf, data.original_size, data.method) < 0) {
+			libxmp_depack_free(&buf);
+			return -1;
+		}
+		return libxmp_depack_done(&buf, out, outlen);
 	}
 
 	return -1;
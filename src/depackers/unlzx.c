@@ -119,7 +119,7 @@ struct LZXDecrData {
     uint32 crc;
     uint8 pack_mode;
     uint32 sum;
-    FILE *outfile;
+    struct depack_buffer *outfile;
 
     struct filename_node *filename_list;
 
@@ -812,7 +812,7 @@ static void decrunch(struct LZXDecrData *decr)
 static int extract_normal(FILE * in_file, struct LZXDecrData *decr)
 {
     struct filename_node *node;
-    FILE *out_file = 0;
+    struct depack_buffer *out_file = NULL;
     uint8 *pos;
     uint8 *temp;
     uint32 count;
@@ -917,7 +917,7 @@ static int extract_normal(FILE * in_file, struct LZXDecrData *decr)
 
 	    if (out_file) {	/* Write the data to the file */
 		abort = 1;
-		if (fwrite(pos, 1, count, out_file) != count) {
+		if (libxmp_depack_write(out_file, pos, count) < 0) {
 #if 0
 		    perror("FWrite");	/* argh! write error */
 		    fclose(out_file);
@@ -1096,12 +1096,10 @@ static int test_lzx(unsigned char *b)
 	return memcmp(b, "LZX", 3) == 0;
 }
 
-static int decrunch_lzx(FILE *f, FILE *fo)
+static int decrunch_lzx(FILE *f, long inlen, void **out, long *outlen)
 {
 	struct LZXDecrData *decr;
-
-	if (fo == NULL)
-		goto err;
+	struct depack_buffer buf;
 
 	decr = calloc(1, sizeof(struct LZXDecrData));
 	if (decr == NULL)
@@ -1111,12 +1109,13 @@ static int decrunch_lzx(FILE *f, FILE *fo)
 		goto err2;
 
 	libxmp_crc32_init_A();
-	decr->outfile = fo;
+	libxmp_depack_init(&buf, 0);
+	decr->outfile = &buf;
 	extract_archive(f, decr);
 
 	free(decr);
 
-	return 0;
+	return libxmp_depack_done(&buf, out, outlen);
 
     err2:
 	free(decr);
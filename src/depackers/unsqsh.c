@@ -329,7 +329,7 @@ static int test_sqsh(unsigned char *b)
 	return memcmp(b, "XPKF", 4) == 0 && memcmp(b + 8, "SQSH", 4) == 0;
 }
 
-static int decrunch_sqsh(FILE * f, FILE * fo)
+static int decrunch_sqsh(FILE *f, long inlen, void **out, long *outlen)
 {
 	unsigned char *src, *dest;
 	int srclen, destlen;
@@ -362,12 +362,11 @@ static int decrunch_sqsh(FILE * f, FILE * fo)
 	if (unsqsh(src, srclen, dest, destlen) != destlen)
 		goto err3;
 
-	if (fwrite(dest, destlen, 1, fo) != 1)
-		goto err3;
-
-	free(dest);
 	free(src);
 
+	*out = dest;
+	*outlen = destlen;
+
 	return 0;
 
     err3:
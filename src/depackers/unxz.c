@@ -20,8 +20,9 @@ static int test_xz(unsigned char *b)
 	return b[0] == 0xfd && b[3] == 'X' && b[4] == 'Z' && b[5] == 0x00;
 }
 
-static int decrunch_xz(FILE *in, FILE *out)
+static int decrunch_xz(FILE *in, long inlen, void **out, long *outlen)
 {
+	struct depack_buffer buf;
 	struct xz_buf b;
 	struct xz_dec *state;
 	unsigned char *membuf;
@@ -33,6 +34,8 @@ static int decrunch_xz(FILE *in, FILE *out)
 	if ((membuf = malloc(2 * BUFFER_SIZE)) == NULL)
 		return -1;
 
+	libxmp_depack_init(&buf, 0);
+
 	b.in = membuf;
 	b.out = membuf + BUFFER_SIZE;
 	b.out_size = BUFFER_SIZE;
@@ -56,7 +59,10 @@ static int decrunch_xz(FILE *in, FILE *out)
 		r = xz_dec_run(state, &b);
 
 		if (b.out_pos) {
-			fwrite(b.out, 1, b.out_pos, out);
+			if (libxmp_depack_write(&buf, b.out, b.out_pos) < 0) {
+				ret = -1;
+				break;
+			}
 			b.out_pos = 0;
 		}
 
@@ -73,7 +79,12 @@ static int decrunch_xz(FILE *in, FILE *out)
 	xz_dec_end(state);
 	free(membuf);
 
-	return ret;
+	if (ret < 0) {
+		libxmp_depack_free(&buf);
+		return -1;
+	}
+
+	return libxmp_depack_done(&buf, out, outlen);
 }
 
 struct depacker libxmp_depacker_xz = {
@@ -79,17 +79,12 @@ int t;
   return t;
 }
 
-static int write_buffer(FILE *out, unsigned char *buffer, int len)
+static int write_buffer(struct depack_buffer *out, unsigned char *buffer, int len)
 {
-int t;
-
-  t=0;
-  while (t<len)
-  {
-    t=t+fwrite(buffer+t,1,len-t,out);
-  }
+  if (libxmp_depack_write(out,buffer,len) < 0)
+  { return -1; }
 
-  return t;
+  return len;
 }
 
 /*----------------------- end of fileio.c -----------------------*/
@@ -97,13 +92,12 @@ int t;
 #define BUFFER_SIZE 16738
 
 
-static unsigned int copy_file(FILE *in, FILE *out, int len, struct inflate_data *data)
+static int copy_file(FILE *in, struct depack_buffer *out, int len, uint32 *checksum)
 {
 unsigned char buffer[BUFFER_SIZE];
-unsigned int checksum;
 int t,r;
 
-  checksum=0xffffffff;
+  *checksum=0xffffffff;
 
   t=0;
 
@@ -115,12 +109,15 @@ int t,r;
     { r=len-t; }
 
     read_buffer(in,buffer,r);
-    write_buffer(out,buffer,r);
-    checksum=libxmp_crc32_A2(buffer,r,checksum);
+    if (write_buffer(out,buffer,r) < 0)
+    { return -1; }
+    *checksum=libxmp_crc32_A2(buffer,r,*checksum);
     t=t+r;
   }
 
-  return checksum^0xffffffff;
+  *checksum^=0xffffffff;
+
+  return 0;
 }
 
 static int read_zip_header(FILE *in, struct zip_file_header *header)
@@ -147,13 +144,12 @@ static int read_zip_header(FILE *in, struct zip_file_header *header)
  * pass an array of patterns containing files we want to exclude from
  * our search (such as README, *.nfo, etc)
  */
-static int kunzip_file_with_name(FILE *in, FILE *out)
+static int kunzip_file_with_name(FILE *in, struct depack_buffer *out)
 {
 struct zip_file_header header;
 int ret_code;
 uint32 checksum=0;
 long marker;
-struct inflate_data data;
 
   ret_code=0;
 
@@ -181,7 +177,8 @@ struct inflate_data data;
   {
     if (header.compression_method==0)
     {
-      checksum=copy_file(in,out,header.uncompressed_size,&data);
+      if (copy_file(in,out,header.uncompressed_size,&checksum) < 0)
+	goto err3;
     }
     else
     {
@@ -286,8 +283,9 @@ static int test_zip(unsigned char *b)
 		b[4] == 'P' && b[5] == 'K' && b[6] == 3 && b[7] == 4));
 }
 
-static int decrunch_zip(FILE *in, FILE *out)
+static int decrunch_zip(FILE *in, long inlen, void **out, long *outlen)
 {
+  struct depack_buffer buf;
   int offset;
 
   offset = kunzip_get_offset_excluding(in);
@@ -297,10 +295,13 @@ static int decrunch_zip(FILE *in, FILE *out)
   if (fseek(in, offset, SEEK_SET) < 0)
     return -1;
 
-  if (kunzip_file_with_name(in,out) < 0)
+  libxmp_depack_init(&buf, 0);
+  if (kunzip_file_with_name(in,&buf) < 0) {
+    libxmp_depack_free(&buf);
     return -1;
+  }
 
-  return 0;
+  return libxmp_depack_done(&buf, out, outlen);
 }
 
 struct depacker libxmp_depacker_zip = {
@@ -16,7 +16,8 @@
 #include <proto/xfdmaster.h>
 #include <exec/types.h>
 #include <stdio.h>
-#include <sys/stat.h>
+#include <stdlib.h>
+#include <string.h>
 #include "common.h"
 #include "depacker.h"
 
@@ -47,21 +48,16 @@ static int test_xfd(unsigned char *b)
 	return _test_xfd(b, 1024);
 }
 
-static int decrunch_xfd(FILE *f1, FILE *f2)
+static int decrunch_xfd(FILE *f1, long inlen, void **out, long *outlen)
 {
     struct xfdBufferInfo *xfdobj;
     uint8 *packed;
     int plen,ret=-1;
-    struct stat st;
 
     if (xfdMasterBase == NULL)
 	return -1;
 
-    if (f2 == NULL)
-	return -1;
-
-    fstat(fileno(f1), &st);
-    plen = st.st_size;
+    plen = inlen;
 
     packed = AllocVec(plen,MEMF_CLEAR);
     if (!packed) return -1;
@@ -80,7 +76,15 @@ static int decrunch_xfd(FILE *f1, FILE *f2)
 			xfdobj->xfdbi_TargetBufMemType = MEMF_ANY;
 			if(xfdDecrunchBuffer(xfdobj))
 			{
-				if(fwrite(xfdobj->xfdbi_TargetBuffer,1,xfdobj->xfdbi_TargetBufSaveLen,f2) == xfdobj->xfdbi_TargetBufSaveLen) ret=0;
+				long len = xfdobj->xfdbi_TargetBufSaveLen;
+				uint8 *data = (uint8 *) malloc(len > 0 ? len : 1);
+				if(data)
+				{
+					memcpy(data,xfdobj->xfdbi_TargetBuffer,len);
+					*out = data;
+					*outlen = len;
+					ret=0;
+				}
 				FreeMem(xfdobj->xfdbi_TargetBuffer,xfdobj->xfdbi_TargetBufLen);
 			}
 			else
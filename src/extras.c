@@ -70,6 +70,18 @@ void libxmp_release_channel_extras(struct context_data *ctx, struct channel_data
 		libxmp_hmn_release_channel_extras(xc);
 }
 
+size_t libxmp_channel_extras_size(struct context_data *ctx)
+{
+	struct module_data *m = &ctx->m;
+
+	if (HAS_MED_MODULE_EXTRAS(*m))
+		return sizeof(struct med_channel_extras);
+	else if (HAS_HMN_MODULE_EXTRAS(*m))
+		return sizeof(struct hmn_channel_extras);
+
+	return 0;
+}
+
 void libxmp_reset_channel_extras(struct context_data *ctx, struct channel_data *xc)
 {
 	struct module_data *m = &ctx->m;
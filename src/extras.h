@@ -5,6 +5,7 @@ void libxmp_release_module_extras(struct context_data *);
 int  libxmp_new_channel_extras(struct context_data *, struct channel_data *);
 void libxmp_release_channel_extras(struct context_data *, struct channel_data *);
 void libxmp_reset_channel_extras(struct context_data *, struct channel_data *);
+size_t libxmp_channel_extras_size(struct context_data *);
 void libxmp_play_extras(struct context_data *, struct channel_data *, int);
 int  libxmp_extras_get_volume(struct context_data *, struct channel_data *);
 int  libxmp_extras_get_period(struct context_data *, struct channel_data *);
@@ -76,16 +76,13 @@ static const float resonance_table[128] = {
  * Simple 2-poles resonant filter
  */
 #define FREQ_PARAM_MULT (128.0f / (24.0f * 256.0f))
-void libxmp_filter_setup(int srate, int cutoff, int res, int *a0, int *b0, int *b1)
+static void filter_coef(int srate, int cutoff, int res, int *coef)
 {
 	float fc, fs = (float)srate;
 	float fg, fb0, fb1;
 	float r, d, e;
 
 	/* [0-255] => [100Hz-8000Hz] */
-	CLAMP(cutoff, 0, 255);
-	CLAMP(res, 0, 255);
-
         fc = 110.0f * powf(2.0f, (float)cutoff * FREQ_PARAM_MULT + 0.25f);
         if (fc > fs / 2.0f) {
                 fc = fs / 2.0f;
@@ -99,9 +96,91 @@ void libxmp_filter_setup(int srate, int cutoff, int res, int *a0, int *b0, int *
         fb0 = (d + e + e) / (1.0 + d + e);
         fb1 = -e / (1.0 + d + e);
 
-	*a0 = (int)(fg  * (1 << FILTER_SHIFT));
-	*b0 = (int)(fb0 * (1 << FILTER_SHIFT));
-	*b1 = (int)(fb1 * (1 << FILTER_SHIFT));
+	coef[0] = (int)(fg  * (1 << FILTER_SHIFT));
+	coef[1] = (int)(fb0 * (1 << FILTER_SHIFT));
+	coef[2] = (int)(fb1 * (1 << FILTER_SHIFT));
+}
+
+/*
+ * Coefficients are cached in one table per resonance value, each with
+ * the coefficients for all cutoff values. Tables are built when first
+ * used, and thrown away if the sampling rate changes.
+ */
+#define FILTER_TABLES	128
+
+struct filter_cache {
+	int srate;
+	int *coef[FILTER_TABLES];	/* a0, b0, b1 for each cutoff */
+};
+
+void libxmp_filter_free(struct mixer_data *s)
+{
+	int i;
+
+	if (s->filter == NULL) {
+		return;
+	}
+
+	for (i = 0; i < FILTER_TABLES; i++) {
+		free(s->filter->coef[i]);
+	}
+	free(s->filter);
+	s->filter = NULL;
+}
+
+static int *filter_table(struct mixer_data *s, int res)
+{
+	struct filter_cache *f;
+	int *coef;
+	int i;
+
+	if (s->filter != NULL && s->filter->srate != s->freq) {
+		libxmp_filter_free(s);
+	}
+
+	if (s->filter == NULL) {
+		s->filter = calloc(1, sizeof(struct filter_cache));
+		if (s->filter == NULL) {
+			return NULL;
+		}
+		s->filter->srate = s->freq;
+	}
+	f = s->filter;
+
+	coef = f->coef[res >> 1];
+	if (coef == NULL) {
+		coef = malloc(256 * 3 * sizeof(int));
+		if (coef == NULL) {
+			return NULL;
+		}
+		for (i = 0; i < 256; i++) {
+			filter_coef(s->freq, i, res, coef + i * 3);
+		}
+		f->coef[res >> 1] = coef;
+	}
+
+	return coef;
+}
+
+void libxmp_filter_setup(struct mixer_data *s, int cutoff, int res, int *a0, int *b0, int *b1)
+{
+	int buf[3], *coef;
+
+	CLAMP(cutoff, 0, 255);
+	CLAMP(res, 0, 255);
+
+	coef = filter_table(s, res);
+	if (coef != NULL) {
+		coef += cutoff * 3;
+	} else {
+		/* out of memory, compute them here */
+		coef = buf;
+		filter_coef(s->freq, cutoff, res, coef);
+	}
+
+	*a0 = coef[0];
+	*b0 = coef[1];
+	*b1 = coef[2];
 }
 
 #endif
@@ -156,6 +156,76 @@ const struct format_loader *const format_loader[NUM_FORMATS + 2] = {
 	NULL
 };
 
+#define MAGIC(l,o,m) { &libxmp_loader_##l, o, sizeof (m) - 1, m, 1 }
+#define MAGIC_ALSO(l,o,m) { &libxmp_loader_##l, o, sizeof (m) - 1, m, 0 }
+
+/* Loaders matching these signatures are tested before the others. Loaders
+ * listed with MAGIC() accept no other signatures and aren't tested for
+ * modules without one of them, loaders listed with MAGIC_ALSO() may also
+ * accept other modules and are probed for all of them.
+ */
+const struct format_magic format_magic[] = {
+	MAGIC(xm,	0,	"Extended Module: "),
+	MAGIC_ALSO(mod,	1080,	"M.K."),
+	MAGIC_ALSO(mod,	1080,	"M!K!"),
+	MAGIC_ALSO(mod,	1080,	"M&K!"),
+	MAGIC_ALSO(mod,	1080,	"N.T."),
+	MAGIC_ALSO(mod,	1080,	"6CHN"),
+	MAGIC_ALSO(mod,	1080,	"8CHN"),
+	MAGIC(flt,	1080,	"FLT"),
+	MAGIC(flt,	1080,	"EXO"),
+	MAGIC(it,	0,	"IMPM"),
+	MAGIC(s3m,	44,	"SCRM"),
+	MAGIC(stm,	20,	"!Scream!"),
+	MAGIC(stm,	20,	"BMOD2STM"),
+	MAGIC(stm,	20,	"WUZAMOD!"),
+	MAGIC(stx,	20,	"!Scream!"),
+	MAGIC(stx,	20,	"BMOD2STM"),
+	MAGIC(mtm,	0,	"MTM"),
+	MAGIC(ice,	1464,	"MTN\0"),
+	MAGIC(ice,	1464,	"IT10"),
+	MAGIC(imf,	60,	"IM10"),
+	MAGIC(ptm,	44,	"PTMF"),
+	MAGIC(mdl,	0,	"DMDL"),
+	MAGIC(ult,	0,	"MAS_UTrack_V00"),
+	MAGIC(liq,	0,	"Liquid Module:"),
+	MAGIC(no,	0,	"NO\0\0"),
+	MAGIC(masi,	0,	"PSM "),
+	MAGIC(gal5,	0,	"RIFF"),
+	MAGIC(gal4,	0,	"RIFF"),
+	MAGIC(psm,	0,	"PSM\xfe"),
+	MAGIC(amf,	0,	"AMF"),
+	MAGIC(asylum,	0,	"ASYLUM Music Format"),
+	MAGIC(gdm,	0,	"GDM\xfe"),
+	MAGIC(mmd1,	0,	"MMD0"),
+	MAGIC(mmd1,	0,	"MMD1"),
+	MAGIC(mmd3,	0,	"MMD2"),
+	MAGIC(mmd3,	0,	"MMD3"),
+	MAGIC(med2,	0,	"MED\x02"),
+	MAGIC(med3,	0,	"MED\x03"),
+	MAGIC(med4,	0,	"MED\x04"),
+	MAGIC(chip,	952,	"KRIS"),
+	MAGIC(rtm,	0,	"RTMM"),
+	MAGIC(pt3,	0,	"FORM"),
+	MAGIC(dt,	0,	"D.T."),
+	MAGIC(mgt,	0,	"MGT"),
+	MAGIC(arch,	0,	"MUSX"),
+	MAGIC(sym,	0,	"\x02\x01\x13\x13\x14\x12\x01\x0b"),
+	MAGIC(digi,	0,	"DIGI Booster module"),
+	MAGIC(dbm,	0,	"DBM0"),
+	MAGIC(emod,	0,	"FORM"),
+	MAGIC(okt,	0,	"OKTASONG"),
+	MAGIC(far,	0,	"FAR\xfe"),
+	MAGIC(umx,	0,	"\xc1\x83\x2a\x9e"),
+	MAGIC(hmn,	1080,	"FEST"),
+	MAGIC(hmn,	1080,	"M&K!"),
+	MAGIC(669,	0,	"if"),
+	MAGIC(669,	0,	"JN"),
+	MAGIC(fnk,	0,	"Funk"),
+	MAGIC(abk,	0,	"AmBk"),
+	{ NULL }
+};
+
 static const char *_farray[NUM_FORMATS + NUM_PW_FORMATS + 1] = { NULL };
 
 char **format_list()
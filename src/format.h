@@ -11,7 +11,23 @@ struct format_loader {
 	int (*const loader)(struct module_data *, HIO_HANDLE *, const int);
 };
 
+/* Signature at a fixed offset of the module header */
+struct format_magic {
+	const struct format_loader *loader;
+	int offset;
+	int len;
+	const char *magic;
+	int only;		/* loader accepts no other signatures */
+};
+
+#define FORMAT_MAGIC_SIZE 1468	/* header window covering all signatures */
+
+#define FORMAT_MATCH	1	/* signature found in the module header */
+#define FORMAT_PROBE	2	/* no signature, but may accept the module */
+
 char **format_list(void);
+void libxmp_match_formats(const struct format_loader *const *,
+			  const struct format_magic *, const uint8 *, int, char *);
 
 #ifndef LIBXMP_CORE_PLAYER
 
@@ -19,6 +35,9 @@ char **format_list(void);
 #define NUM_PW_FORMATS 43
 
 int pw_test_format(HIO_HANDLE *, char *, const int, struct xmp_test_info *);
+#else
+
+#define NUM_FORMATS 4
 #endif
 
 #endif
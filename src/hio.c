@@ -28,6 +28,11 @@
 #include "hio.h"
 #include "mdataio.h"
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#define USE_MMAP
+#endif
+
 static long get_size(FILE *f)
 {
 	long size, pos;
@@ -47,8 +52,62 @@ static long get_size(FILE *f)
 	}
 }
 
+/* Mapped files are read like memory but keep the stdio semantics of
+ * files: end of file is flagged by a read past the end, and seeking past
+ * the end is allowed.
+ */
+static const uint8 *map_get(HIO_HANDLE *h, int n)
+{
+	MFILE *m = h->handle.mem;
+	const uint8 *p;
+
+	if (m->pos + n > m->size) {
+		if (m->pos < m->size) {
+			m->pos = m->size;
+		}
+		h->error = EOF;
+		h->eof = 1;
+		return NULL;
+	}
+
+	p = m->start + m->pos;
+	m->pos += n;
+
+	return p;
+}
+
+static int map_seek(HIO_HANDLE *h, long offset, int whence)
+{
+	MFILE *m = h->handle.mem;
+	long pos;
+
+	switch (whence) {
+	case SEEK_SET:
+		pos = offset;
+		break;
+	case SEEK_CUR:
+		pos = m->pos + offset;
+		break;
+	case SEEK_END:
+		pos = m->size + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if (pos < 0) {
+		return -1;
+	}
+
+	m->pos = pos;
+	h->eof = 0;
+
+	return 0;
+}
+
 int8 hio_read8s(HIO_HANDLE *h)
 {
+	const uint8 *p;
 	int err;
 	int8 ret = 0;
 
@@ -62,6 +121,10 @@ int8 hio_read8s(HIO_HANDLE *h)
 	case HIO_HANDLE_TYPE_MEMORY:
 		ret = mread8s(h->handle.mem);
 		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		p = map_get(h, 1);
+		ret = p != NULL ? (int8)*p : 0;
+		break;
 	}
 
 	return ret;
@@ -69,6 +132,7 @@ int8 hio_read8s(HIO_HANDLE *h)
 
 uint8 hio_read8(HIO_HANDLE *h)
 {
+	const uint8 *p;
 	int err;
 	uint8 ret = 0;
 
@@ -82,6 +146,10 @@ uint8 hio_read8(HIO_HANDLE *h)
 	case HIO_HANDLE_TYPE_MEMORY:
 		ret = mread8(h->handle.mem);
 		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		p = map_get(h, 1);
+		ret = p != NULL ? *p : 0xff;
+		break;
 	}
 
 	return ret;
@@ -89,6 +157,7 @@ uint8 hio_read8(HIO_HANDLE *h)
 
 uint16 hio_read16l(HIO_HANDLE *h)
 {
+	const uint8 *p;
 	int err;
 	uint16 ret = 0;
 
@@ -102,6 +171,10 @@ uint16 hio_read16l(HIO_HANDLE *h)
 	case HIO_HANDLE_TYPE_MEMORY:
 		ret = mread16l(h->handle.mem);
 		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		p = map_get(h, 2);
+		ret = p != NULL ? readmem16l(p) : 0xffff;
+		break;
 	}
 
 	return ret;
@@ -109,6 +182,7 @@ uint16 hio_read16l(HIO_HANDLE *h)
 
 uint16 hio_read16b(HIO_HANDLE *h)
 {
+	const uint8 *p;
 	int err;
 	uint16 ret = 0;
 
@@ -122,6 +196,10 @@ uint16 hio_read16b(HIO_HANDLE *h)
 	case HIO_HANDLE_TYPE_MEMORY:
 		ret = mread16b(h->handle.mem);
 		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		p = map_get(h, 2);
+		ret = p != NULL ? readmem16b(p) : 0xffff;
+		break;
 	}
 
 	return ret;
@@ -129,6 +207,7 @@ uint16 hio_read16b(HIO_HANDLE *h)
 
 uint32 hio_read24l(HIO_HANDLE *h)
 {
+	const uint8 *p;
 	int err;
 	uint32 ret = 0;
 
@@ -140,7 +219,11 @@ uint32 hio_read24l(HIO_HANDLE *h)
 		}
 		break;
 	case HIO_HANDLE_TYPE_MEMORY:
-		ret = mread24l(h->handle.mem); 
+		ret = mread24l(h->handle.mem);
+		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		p = map_get(h, 3);
+		ret = p != NULL ? readmem24l(p) : 0xffffff;
 		break;
 	}
 
@@ -149,6 +232,7 @@ uint32 hio_read24l(HIO_HANDLE *h)
 
 uint32 hio_read24b(HIO_HANDLE *h)
 {
+	const uint8 *p;
 	int err;
 	uint32 ret = 0;
 
@@ -162,6 +246,10 @@ uint32 hio_read24b(HIO_HANDLE *h)
 	case HIO_HANDLE_TYPE_MEMORY:
 		ret = mread24b(h->handle.mem);
 		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		p = map_get(h, 3);
+		ret = p != NULL ? readmem24b(p) : 0xffffff;
+		break;
 	}
 
 	return ret;
@@ -169,6 +257,7 @@ uint32 hio_read24b(HIO_HANDLE *h)
 
 uint32 hio_read32l(HIO_HANDLE *h)
 {
+	const uint8 *p;
 	int err;
 	uint32 ret = 0;
 
@@ -182,6 +271,10 @@ uint32 hio_read32l(HIO_HANDLE *h)
 	case HIO_HANDLE_TYPE_MEMORY:
 		ret = mread32l(h->handle.mem);
 		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		p = map_get(h, 4);
+		ret = p != NULL ? readmem32l(p) : 0xffffffff;
+		break;
 	}
 
 	return ret;
@@ -189,6 +282,7 @@ uint32 hio_read32l(HIO_HANDLE *h)
 
 uint32 hio_read32b(HIO_HANDLE *h)
 {
+	const uint8 *p;
 	int err;
 	uint32 ret = 0;
 
@@ -201,6 +295,11 @@ uint32 hio_read32b(HIO_HANDLE *h)
 		break;
 	case HIO_HANDLE_TYPE_MEMORY:
 		ret = mread32b(h->handle.mem);
+		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		p = map_get(h, 4);
+		ret = p != NULL ? readmem32b(p) : 0xffffffff;
+		break;
 	}
 
 	return ret;
@@ -227,6 +326,13 @@ size_t hio_read(void *buf, size_t size, size_t num, HIO_HANDLE *h)
 			h->error = errno;
 		}
 		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		ret = mread(buf, size, num, h->handle.mem);
+		if (ret != num) {
+			h->error = EOF;
+			h->eof = 1;
+		}
+		break;
 	}
 
 	return ret;
@@ -249,6 +355,12 @@ int hio_seek(HIO_HANDLE *h, long offset, int whence)
 			h->error = errno;
 		}
 		break;
+	case HIO_HANDLE_TYPE_MMAP:
+		ret = map_seek(h, offset, whence);
+		if (ret < 0) {
+			h->error = EINVAL;
+		}
+		break;
 	}
 
 	return ret;
@@ -266,6 +378,7 @@ long hio_tell(HIO_HANDLE *h)
 		}
 		break;
 	case HIO_HANDLE_TYPE_MEMORY:
+	case HIO_HANDLE_TYPE_MMAP:
 		ret = mtell(h->handle.mem);
 		if (ret < 0) {
 			h->error = errno;
@@ -283,6 +396,8 @@ int hio_eof(HIO_HANDLE *h)
 		return feof(h->handle.file);
 	case HIO_HANDLE_TYPE_MEMORY:
 		return meof(h->handle.mem);
+	case HIO_HANDLE_TYPE_MMAP:
+		return h->eof;
 	default:
 		return EOF;
 	}
@@ -295,6 +410,52 @@ int hio_error(HIO_HANDLE *h)
 	return error;
 }
 
+#ifdef USE_MMAP
+/* Map a regular file opened for reading and serve reads from memory */
+static void map_file(HIO_HANDLE *h, const char *mode)
+{
+	struct stat st;
+	MFILE *m;
+	void *p;
+
+	if (strchr(mode, 'w') || strchr(mode, 'a') || strchr(mode, '+'))
+		return;
+
+	if (fstat(fileno(h->handle.file), &st) < 0 || !S_ISREG(st.st_mode))
+		return;
+
+	if (h->size <= 0 || st.st_size != h->size)
+		return;
+
+	p = mmap(NULL, h->size, PROT_READ, MAP_PRIVATE,
+					fileno(h->handle.file), 0);
+	if (p == MAP_FAILED)
+		return;
+
+	if ((m = mopen(p, h->size)) == NULL) {
+		munmap(p, h->size);
+		return;
+	}
+
+	h->type = HIO_HANDLE_TYPE_MMAP;
+	h->eof = 0;
+	h->map_file = h->handle.file;
+	h->handle.mem = m;
+}
+
+static int unmap_file(HIO_HANDLE *h)
+{
+	MFILE *m = h->handle.mem;
+	int ret;
+
+	ret = munmap((void *)m->start, h->size);
+	if (mclose(m) < 0 || fclose(h->map_file) < 0)
+		ret = -1;
+
+	return ret;
+}
+#endif
+
 HIO_HANDLE *hio_open(const void *path, const char *mode)
 {
 	HIO_HANDLE *h;
@@ -305,6 +466,8 @@ HIO_HANDLE *hio_open(const void *path, const char *mode)
 	
 	h->error = 0;
 	h->type = HIO_HANDLE_TYPE_FILE;
+	h->map_file = NULL;
+	h->path = NULL;
 	h->handle.file = fopen(path, mode);
 	if (h->handle.file == NULL)
 		goto err2;
@@ -313,6 +476,10 @@ HIO_HANDLE *hio_open(const void *path, const char *mode)
 	if (h->size < 0)
 		goto err3;
 
+#ifdef USE_MMAP
+	map_file(h, mode);
+#endif
+
 	return h;
 
     err3:
@@ -333,6 +500,8 @@ HIO_HANDLE *hio_open_mem(const void *ptr, long size)
 	
 	h->error = 0;
 	h->type = HIO_HANDLE_TYPE_MEMORY;
+	h->map_file = NULL;
+	h->path = NULL;
 	h->handle.mem = mopen(ptr, size);
 	h->size = size;
 
@@ -349,6 +518,8 @@ HIO_HANDLE *hio_open_file(FILE *f)
 	
 	h->error = 0;
 	h->type = HIO_HANDLE_TYPE_FILE;
+	h->map_file = NULL;
+	h->path = NULL;
 	h->handle.file = f /*fdopen(fileno(f), "rb")*/;
 	h->size = get_size(f);
 
@@ -366,6 +537,11 @@ int hio_close(HIO_HANDLE *h)
 	case HIO_HANDLE_TYPE_MEMORY:
 		ret = mclose(h->handle.mem);
 		break;
+#ifdef USE_MMAP
+	case HIO_HANDLE_TYPE_MMAP:
+		ret = unmap_file(h);
+		break;
+#endif
 	default:
 		ret = -1;
 	}
@@ -11,15 +11,23 @@
 typedef struct {
 #define HIO_HANDLE_TYPE_FILE	0
 #define HIO_HANDLE_TYPE_MEMORY	1
+#define HIO_HANDLE_TYPE_MMAP	2
 	int type;
 	long size;
 	union {
 		FILE *file;
-		MFILE *mem;
+		MFILE *mem;		/* memory and mapped files */
 	} handle;
 	int error;
+	int eof;			/* end of mapped file reached */
+	FILE *map_file;			/* file backing a mapped handle */
+	const char *path;		/* file a memory handle was depacked from */
 } HIO_HANDLE;
 
+/* Stdio stream of a file handle, or NULL for memory handles */
+#define HIO_HANDLE_FILE(x) (HIO_HANDLE_TYPE(x) == HIO_HANDLE_TYPE_FILE ? \
+			(x)->handle.file : (x)->map_file)
+
 int8	hio_read8s	(HIO_HANDLE *);
 uint8	hio_read8	(HIO_HANDLE *);
 uint16	hio_read16l	(HIO_HANDLE *);
@@ -34,7 +34,11 @@
 #include "format.h"
 #include "list.h"
 #include "hio.h"
-#include "tempfile.h"
+#include "mix_thread.h"
+
+#ifdef MIXER_THREADS
+#include <pthread.h>
+#endif
 
 #ifndef LIBXMP_CORE_PLAYER
 #if !defined(HAVE_POPEN) && defined(WIN32)
@@ -51,11 +55,13 @@
 #endif
 
 
-extern struct format_loader *format_loader[];
+extern const struct format_loader *const format_loader[];
+extern const struct format_magic format_magic[];
 
 void libxmp_load_prologue(struct context_data *);
 void libxmp_load_epilogue(struct context_data *);
 int  libxmp_prepare_scan(struct context_data *);
+int  libxmp_lazy_init(struct module_data *, HIO_HANDLE *, const char *);
 
 #ifndef LIBXMP_CORE_PLAYER
 
@@ -87,11 +93,13 @@ int test_oxm		(FILE *);
 #define BUFLEN 16384
 
 #ifndef HAVE_POPEN
-static int execute_command(const char *cmd, const char *filename, FILE *t) {
+static int execute_command(const char *cmd, const char *filename,
+			   struct depack_buffer *out) {
 	return -1;
 }
 #else
-static int execute_command(const char *cmd, const char *filename, FILE *t)
+static int execute_command(const char *cmd, const char *filename,
+			   struct depack_buffer *out)
 {
 	char line[1024], buf[BUFLEN];
 	FILE *p;
@@ -118,7 +126,10 @@ static int execute_command(const char *cmd, const char *filename, FILE *t)
 	}
 
 	while ((n = fread(buf, 1, BUFLEN, p)) > 0) {
-	    fwrite(buf, 1, n, t);
+	    if (libxmp_depack_write(out, buf, n) < 0) {
+		pclose(p);
+		return -1;
+	    }
 	}
 
 	pclose (p);
@@ -127,20 +138,25 @@ static int execute_command(const char *cmd, const char *filename, FILE *t)
 }
 #endif
 
-static int decrunch(HIO_HANDLE **h, const char *filename, char **temp)
+/* Depack the module to memory. If the file is packed, *h is replaced by
+ * a memory handle on the depacked data and *data is set to the buffer,
+ * which must be freed by the caller after closing the handle.
+ */
+static int decrunch(HIO_HANDLE **h, const char *filename, void **data)
 {
 	unsigned char b[1024];
 	const char *cmd;
-	FILE *f, *t;
-	int res;
+	FILE *f;
+	HIO_HANDLE *t;
 	int headersize;
 	int i;
 	struct depacker *depacker = NULL;
+	void *out = NULL;
+	long outlen = 0;
 
 	cmd = NULL;
-	res = 0;
-	*temp = NULL;
-	f = (*h)->handle.file;
+	*data = NULL;
+	f = HIO_HANDLE_FILE(*h);
 
 	headersize = fread(b, 1, 1024, f);
 	if (headersize < 100) {	/* minimum valid file size */
@@ -192,39 +208,43 @@ static int decrunch(HIO_HANDLE **h, const char *filename, char **temp)
 
 	D_(D_WARN "Depacking file... ");
 
-	if ((t = make_temp_file(temp)) == NULL) {
-		goto err;
-	}
-
 	/* Depack file */
 	if (cmd) {
+		struct depack_buffer buf;
+
 		D_(D_INFO "External depacker: %s", cmd);
-		if (execute_command(cmd, filename, t) < 0) {
+		libxmp_depack_init(&buf, 0);
+		if (execute_command(cmd, filename, &buf) < 0) {
 			D_(D_CRIT "failed");
-			goto err2;
+			libxmp_depack_free(&buf);
+			goto err;
+		}
+		if (libxmp_depack_done(&buf, &out, &outlen) < 0) {
+			goto err;
 		}
 	} else if (depacker) {
 		D_(D_INFO "Internal depacker");
-		if (depacker->depack(f, t) < 0) {
+		if (depacker->depack(f, hio_size(*h), &out, &outlen) < 0) {
 			D_(D_CRIT "failed");
-			goto err2;
+			goto err;
 		}
 	}
 
 	D_(D_INFO "done");
 
-	if (fseek(t, 0, SEEK_SET) < 0) {
-		D_(D_CRIT "fseek error");
+	if ((t = hio_open_mem(out, outlen)) == NULL) {
 		goto err2;
 	}
+	t->path = filename;	/* loaders may look up companion files */
 
 	hio_close(*h);
-	*h = hio_open_file(t);
+	*h = t;
+	*data = out;
 
-	return res;
+	return 0;
 
     err2:
-	fclose(t);
+	free(out);
     err:
 	return -1;
 }
@@ -282,6 +302,48 @@ static char *get_basename(char *name)
 }
 #endif /* LIBXMP_CORE_PLAYER */
 
+static int test_loader(HIO_HANDLE *h, int i, char *t)
+{
+	hio_seek(h, 0, SEEK_SET);
+
+	if (hio_error(h)) {
+		/* reset error flag */
+	}
+
+	D_(D_WARN "test %s", format_loader[i]->name);
+	return format_loader[i]->test(h, t, 0);
+}
+
+/* Find the loader for the module. Formats with a signature matching the
+ * module header are tested first, then the formats that may accept it
+ * without a signature are probed in order. Returns the loader index or -1
+ * if the format is unknown.
+ */
+static int find_loader(HIO_HANDLE *h, char *t)
+{
+	uint8 buf[FORMAT_MAGIC_SIZE];
+	char match[NUM_FORMATS + 1];
+	int i, len;
+
+	hio_seek(h, 0, SEEK_SET);
+	len = hio_read(buf, 1, FORMAT_MAGIC_SIZE, h);
+	libxmp_match_formats(format_loader, format_magic, buf, len, match);
+
+	for (i = 0; format_loader[i] != NULL; i++) {
+		if (match[i] == FORMAT_MATCH && test_loader(h, i, t) == 0) {
+			return i;
+		}
+	}
+
+	for (i = 0; format_loader[i] != NULL; i++) {
+		if (match[i] == FORMAT_PROBE && test_loader(h, i, t) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 int xmp_test_module(char *path, struct xmp_test_info *info)
 {
 	HIO_HANDLE *h;
@@ -290,7 +352,7 @@ int xmp_test_module(char *path, struct xmp_test_info *info)
 	int i;
 	int ret = -XMP_ERROR_FORMAT;
 #ifndef LIBXMP_CORE_PLAYER
-	char *temp = NULL;
+	void *data = NULL;
 #endif
 
 	if (stat(path, &st) < 0)
@@ -307,7 +369,7 @@ int xmp_test_module(char *path, struct xmp_test_info *info)
 		return -XMP_ERROR_SYSTEM;
 
 #ifndef LIBXMP_CORE_PLAYER
-	if (decrunch(&h, path, &temp) < 0) {
+	if (decrunch(&h, path, &data) < 0) {
 		ret = -XMP_ERROR_DEPACK;
 		goto err;
 	}
@@ -324,45 +386,44 @@ int xmp_test_module(char *path, struct xmp_test_info *info)
 		*info->type = 0;	/* reset type prior to testing */
 	}
 
-	for (i = 0; format_loader[i] != NULL; i++) {
-		hio_seek(h, 0, SEEK_SET);
-		if (format_loader[i]->test(h, buf, 0) == 0) {
-			int is_prowizard = 0;
+	i = find_loader(h, buf);
+	if (i >= 0) {
+		int is_prowizard = 0;
 
 #ifndef LIBXMP_CORE_PLAYER
-			if (strcmp(format_loader[i]->name, "prowizard") == 0) {
-				hio_seek(h, 0, SEEK_SET);
-				pw_test_format(h, buf, 0, info);
-				is_prowizard = 1;
-			}
+		if (strcmp(format_loader[i]->name, "prowizard") == 0) {
+			hio_seek(h, 0, SEEK_SET);
+			pw_test_format(h, buf, 0, info);
+			is_prowizard = 1;
+		}
 #endif
 
-			fclose(h->handle.file);
+		hio_close(h);
 
 #ifndef LIBXMP_CORE_PLAYER
-			unlink_temp_file(temp);
+		free(data);
 #endif
 
-			if (info != NULL && !is_prowizard) {
-				strncpy(info->name, buf, XMP_NAME_SIZE - 1);
-				strncpy(info->type, format_loader[i]->name,
-							XMP_NAME_SIZE - 1);
-			}
-			return 0;
+		if (info != NULL && !is_prowizard) {
+			strncpy(info->name, buf, XMP_NAME_SIZE - 1);
+			strncpy(info->type, format_loader[i]->name,
+						XMP_NAME_SIZE - 1);
 		}
+		return 0;
 	}
 
 #ifndef LIBXMP_CORE_PLAYER
     err:
 	hio_close(h);
-	unlink_temp_file(temp);
+	free(data);
 #else
 	hio_close(h);
 #endif
 	return ret;
 }
 
-static int load_module(xmp_context opaque, HIO_HANDLE *h)
+/* Samples are loaded on first use if the module file path is given */
+static int load_module(xmp_context opaque, HIO_HANDLE *h, const char *path)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
 	struct module_data *m = &ctx->m;
@@ -374,21 +435,16 @@ static int load_module(xmp_context opaque, HIO_HANDLE *h)
 
 	D_(D_WARN "load");
 	test_result = load_result = -1;
-	for (i = 0; format_loader[i] != NULL; i++) {
+	i = find_loader(h, NULL);
+	if (i >= 0) {
+		test_result = 0;
 		hio_seek(h, 0, SEEK_SET);
-
-		if (hio_error(h)) {
-			/* reset error flag */
-		}
-
-		D_(D_WARN "test %s", format_loader[i]->name);
-		test_result = format_loader[i]->test(h, NULL, 0);
-		if (test_result == 0) {
-			hio_seek(h, 0, SEEK_SET);
-			D_(D_WARN "load format: %s", format_loader[i]->name);
-			load_result = format_loader[i]->loader(m, h, 0);
-			break;
+		D_(D_WARN "load format: %s", format_loader[i]->name);
+		if (path != NULL && m->smpctl & XMP_SMPCTL_LAZY) {
+			libxmp_lazy_init(m, h, path);
 		}
+		load_result = format_loader[i]->loader(m, h, 0);
+		libxmp_lazy_done(m);
 	}
 
 #ifndef LIBXMP_CORE_PLAYER
@@ -453,7 +509,19 @@ static int load_module(xmp_context opaque, HIO_HANDLE *h)
 		return ret;
 	}
 
-	libxmp_scan_sequences(ctx);
+#ifndef LIBXMP_CORE_PLAYER
+	if (libxmp_scan_cache_load(ctx) == 0) {
+		ctx->state = XMP_STATE_LOADED;
+		return 0;
+	}
+#endif
+
+	if (m->scanctl != XMP_SCAN_DEFER || libxmp_scan_defer(ctx) < 0) {
+		libxmp_scan_sequences(ctx);
+#ifndef LIBXMP_CORE_PLAYER
+		libxmp_scan_cache_save(ctx);
+#endif
+	}
 
 	ctx->state = XMP_STATE_LOADED;
 
@@ -470,7 +538,7 @@ int xmp_load_module(xmp_context opaque, char *path)
 #ifndef LIBXMP_CORE_PLAYER
 	struct module_data *m = &ctx->m;
 	long size;
-	char *temp_name;
+	void *data;
 #endif
 	HIO_HANDLE *h;
 	struct stat st;
@@ -495,7 +563,7 @@ int xmp_load_module(xmp_context opaque, char *path)
 
 #ifndef LIBXMP_CORE_PLAYER
 	D_(D_INFO "decrunch");
-	if (decrunch(&h, path, &temp_name) < 0) {
+	if (decrunch(&h, path, &data) < 0) {
 		ret = -XMP_ERROR_DEPACK;
 		goto err;
 	}
@@ -527,11 +595,15 @@ int xmp_load_module(xmp_context opaque, char *path)
 	m->size = size;
 #endif
 
-	ret = load_module(opaque, h);
+#ifndef LIBXMP_CORE_PLAYER
+	ret = load_module(opaque, h, data == NULL ? path : NULL);
+#else
+	ret = load_module(opaque, h, path);
+#endif
 	hio_close(h);
 
 #ifndef LIBXMP_CORE_PLAYER
-	unlink_temp_file(temp_name);
+	free(data);
 #endif
 
 	return ret;
@@ -539,7 +611,7 @@ int xmp_load_module(xmp_context opaque, char *path)
 #ifndef LIBXMP_CORE_PLAYER
     err:
 	hio_close(h);
-	unlink_temp_file(temp_name);
+	free(data);
 	return ret;
 #endif
 }
@@ -566,7 +638,7 @@ int xmp_load_module_from_memory(xmp_context opaque, void *mem, long size)
 	m->dirname = NULL;
 	m->size = size;
 
-	ret = load_module(opaque, h);
+	ret = load_module(opaque, h, NULL);
 
 	hio_close(h);
 
@@ -592,54 +664,40 @@ int xmp_load_module_from_file(xmp_context opaque, void *file, long size)
 	m->dirname = NULL;
 	m->size = hio_size(h);
 
-	ret = load_module(opaque, h);
+	ret = load_module(opaque, h, NULL);
 
 	hio_close(h);
 
 	return ret;
 }
 
-void xmp_release_module(xmp_context opaque)
+/* Module data referenced by many contexts, freed with the last one */
+struct shared_module {
+	struct context_data ctx;	/* owner of the module data */
+	int refcount;
+#ifdef MIXER_THREADS
+	pthread_mutex_t lock;
+#endif
+};
+
+static void release_module_data(struct context_data *ctx)
 {
-	struct context_data *ctx = (struct context_data *)opaque;
 	struct module_data *m = &ctx->m;
 	struct xmp_module *mod = &m->mod;
 	int i;
 
-	/* can't test this here, we must call release_module to clean up
-	 * load errors
-	if (ctx->state < XMP_STATE_LOADED)
-		return;
-	 */
-
-	if (ctx->state > XMP_STATE_LOADED)
-		xmp_end_player(opaque);
-
-	ctx->state = XMP_STATE_UNLOADED;
-
 	D_(D_INFO "Freeing memory");
 
 #ifndef LIBXMP_CORE_PLAYER
 	libxmp_release_module_extras(ctx);
 #endif
 
-	if (mod->xxt != NULL) {
-		for (i = 0; i < mod->trk; i++) {
-			free(mod->xxt[i]);
-		}
-		free(mod->xxt);
-	}
-
-	if (mod->xxp != NULL) {
-		for (i = 0; i < mod->pat; i++) {
-			free(mod->xxp[i]);
-		}
-		free(mod->xxp);
-	}
+	/* Tracks, patterns and subinstruments are in the module arena */
+	free(mod->xxt);
+	free(mod->xxp);
 
 	if (mod->xxi != NULL) {
 		for (i = 0; i < mod->ins; i++) {
-			free(mod->xxi[i].sub);
 			free(mod->xxi[i].extra);
 		}
 		free(mod->xxi);
@@ -666,12 +724,8 @@ void xmp_release_module(xmp_context opaque)
 	}
 #endif
 
-	if (m->scan_cnt) {
-		for (i = 0; i < mod->len; i++)
-			free(m->scan_cnt[i]);
-		free(m->scan_cnt);
-	}
-
+	libxmp_arena_free(m);
+	libxmp_lazy_release(m);
 	free(m->comment);
 
 	D_("free dirname/basename");
@@ -679,6 +733,157 @@ void xmp_release_module(xmp_context opaque)
 	free(m->basename);
 }
 
+static int shared_ref(struct shared_module *sh, int n)
+{
+	int refcount;
+
+#ifdef MIXER_THREADS
+	pthread_mutex_lock(&sh->lock);
+#endif
+	refcount = sh->refcount += n;
+#ifdef MIXER_THREADS
+	pthread_mutex_unlock(&sh->lock);
+#endif
+
+	return refcount;
+}
+
+static void shared_unref(struct shared_module *sh)
+{
+	if (shared_ref(sh, -1) > 0) {
+		return;
+	}
+
+	release_module_data(&sh->ctx);
+#ifdef MIXER_THREADS
+	pthread_mutex_destroy(&sh->lock);
+#endif
+	free(sh);
+}
+
+void xmp_release_module(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct module_data *m = &ctx->m;
+
+	/* can't test this here, we must call release_module to clean up
+	 * load errors
+	if (ctx->state < XMP_STATE_LOADED)
+		return;
+	 */
+
+	if (ctx->state > XMP_STATE_LOADED)
+		xmp_end_player(opaque);
+
+	ctx->state = XMP_STATE_UNLOADED;
+
+	libxmp_scan_cancel(ctx);
+	free(m->scan_cnt);
+	m->scan_cnt = NULL;
+
+	if (m->shared != NULL) {
+		shared_unref(m->shared);
+		m->shared = NULL;
+		return;
+	}
+
+	release_module_data(ctx);
+}
+
+int xmp_load_shared(xmp_context opaque, char *path)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct module_data *m = &ctx->m;
+	struct shared_module *sh;
+	int ret;
+
+	if ((ret = xmp_load_module(opaque, path)) < 0) {
+		return ret;
+	}
+
+	if ((sh = calloc(1, sizeof (struct shared_module))) == NULL) {
+		xmp_release_module(opaque);
+		return -XMP_ERROR_SYSTEM;
+	}
+
+#ifdef MIXER_THREADS
+	if (pthread_mutex_init(&sh->lock, NULL) != 0) {
+		free(sh);
+		xmp_release_module(opaque);
+		return -XMP_ERROR_SYSTEM;
+	}
+#endif
+
+	/* Keep a pristine copy of the module data, the scan counters and
+	 * the instrument and cache paths belong to each context.
+	 */
+	sh->ctx.m = *m;
+	sh->ctx.m.scan_cnt = NULL;
+	sh->ctx.m.scan_job = NULL;
+	sh->ctx.m.instrument_path = NULL;
+	sh->ctx.m.scan_cache = NULL;
+	sh->ctx.state = XMP_STATE_LOADED;
+	sh->refcount = 1;
+	m->shared = sh;
+
+	return 0;
+}
+
+int xmp_attach_module(xmp_context opaque, xmp_context source)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct context_data *src = (struct context_data *)source;
+	struct module_data *m = &ctx->m;
+	struct shared_module *sh;
+	char *instrument_path, *scan_cache;
+	int smpctl, defpan, scanctl;
+	int ret;
+
+	if (ctx == src) {
+		return -XMP_ERROR_INVALID;
+	}
+
+	if (src->state < XMP_STATE_LOADED || src->m.shared == NULL) {
+		return -XMP_ERROR_STATE;
+	}
+
+	sh = src->m.shared;
+	shared_ref(sh, 1);
+
+	if (ctx->state > XMP_STATE_UNLOADED) {
+		xmp_release_module(opaque);
+	}
+
+	/* Player settings of this context are kept */
+	instrument_path = m->instrument_path;
+	scan_cache = m->scan_cache;
+	smpctl = m->smpctl;
+	defpan = m->defpan;
+	scanctl = m->scanctl;
+
+	*m = sh->ctx.m;
+	m->instrument_path = instrument_path;
+	m->scan_cache = scan_cache;
+	m->smpctl = smpctl;
+	m->defpan = defpan;
+	m->scanctl = scanctl;
+	m->shared = sh;
+
+	if ((ret = libxmp_prepare_scan(ctx)) < 0) {
+		xmp_release_module(opaque);
+		return ret;
+	}
+
+	libxmp_reset_player_mode(ctx);
+	if (m->scanctl != XMP_SCAN_DEFER || libxmp_scan_defer(ctx) < 0) {
+		libxmp_scan_sequences(ctx);
+	}
+
+	ctx->state = XMP_STATE_LOADED;
+
+	return 0;
+}
+
 void xmp_scan_module(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -179,6 +179,41 @@ char *libxmp_adjust_string(char *s)
 	return s;
 }
 
+/* Sort the formats for a module header: FORMAT_MATCH if one of their
+ * signatures is in the header, FORMAT_PROBE if they may accept the module
+ * without one, or 0 if they can't accept it. The loader list and the
+ * signature table are those in format.c.
+ */
+void libxmp_match_formats(const struct format_loader *const *loader,
+			  const struct format_magic *magic,
+			  const uint8 *buf, int len, char *match)
+{
+	const struct format_magic *fm;
+	int i;
+
+	for (i = 0; loader[i] != NULL; i++) {
+		match[i] = FORMAT_PROBE;
+	}
+
+	for (fm = magic; fm->loader != NULL; fm++) {
+		for (i = 0; loader[i] != NULL; i++) {
+			if (loader[i] == fm->loader) {
+				break;
+			}
+		}
+		if (loader[i] == NULL || match[i] == FORMAT_MATCH) {
+			continue;
+		}
+
+		if (fm->offset + fm->len <= len &&
+		    memcmp(buf + fm->offset, fm->magic, fm->len) == 0) {
+			match[i] = FORMAT_MATCH;
+		} else if (fm->only) {
+			match[i] = 0;
+		}
+	}
+}
+
 static void check_envelope(struct xmp_envelope *env)
 {
 	/* Disable envelope if invalid number of points */
@@ -197,6 +232,69 @@ static void check_envelope(struct xmp_envelope *env)
 	}
 }
 
+/*
+ * Module arena
+ *
+ * Patterns, tracks and subinstruments are allocated from large zeroed
+ * chunks owned by the module, and released all at once when the module
+ * is released. Allocations larger than a chunk get a chunk of their own.
+ */
+
+#define ARENA_CHUNK_SIZE	32768
+#define ARENA_ALIGN(x)		(((x) + 15) & ~(size_t)15)
+
+struct module_arena {
+	struct module_arena *next;
+	size_t size;
+	size_t used;
+};
+
+void *libxmp_arena_alloc(struct module_data *m, size_t size)
+{
+	struct module_arena *a = m->arena;
+	size_t offset = ARENA_ALIGN(sizeof (struct module_arena));
+	void *ptr;
+
+	size = ARENA_ALIGN(size);
+
+	if (a == NULL || a->used + size > a->size) {
+		size_t chunk = size > ARENA_CHUNK_SIZE - offset ?
+					offset + size : ARENA_CHUNK_SIZE;
+
+		if ((a = calloc(1, chunk)) == NULL) {
+			return NULL;
+		}
+		a->size = chunk;
+		a->used = offset;
+
+		/* Keep filling the current chunk after a large allocation */
+		if (m->arena != NULL && chunk > ARENA_CHUNK_SIZE) {
+			a->next = m->arena->next;
+			m->arena->next = a;
+		} else {
+			a->next = m->arena;
+			m->arena = a;
+		}
+	}
+
+	ptr = (char *)a + a->used;
+	a->used += size;
+
+	return ptr;
+}
+
+void libxmp_arena_free(struct module_data *m)
+{
+	struct module_arena *a, *next;
+
+	for (a = m->arena; a != NULL; a = next) {
+		next = a->next;
+		free(a);
+	}
+
+	m->arena = NULL;
+}
+
 void libxmp_load_prologue(struct context_data *ctx)
 {
 	struct module_data *m = &ctx->m;
@@ -214,6 +312,9 @@ void libxmp_load_prologue(struct context_data *ctx)
 	m->period_type = PERIOD_AMIGA;
 	m->comment = NULL;
 	m->scan_cnt = NULL;
+	m->scan_job = NULL;
+	m->arena = NULL;
+	m->lazy = NULL;
 
 	/* Set defaults */
     	m->mod.pat = 0;
@@ -245,7 +346,6 @@ void libxmp_load_prologue(struct context_data *ctx)
 
 void libxmp_load_epilogue(struct context_data *ctx)
 {
-	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
 	struct xmp_module *mod = &m->mod;
 	int i, j;
@@ -297,6 +397,14 @@ void libxmp_load_epilogue(struct context_data *ctx)
 		check_envelope(&mod->xxi[i].pei);
 	}
 
+	libxmp_reset_player_mode(ctx);
+}
+
+/* Set the player flags and mode for a newly loaded or attached module */
+void libxmp_reset_player_mode(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+
 	p->filter = 0;
 	p->mode = XMP_MODE_AUTO;
 	p->flags = p->player_flags;
@@ -310,7 +418,8 @@ int libxmp_prepare_scan(struct context_data *ctx)
 {
 	struct module_data *m = &ctx->m;
 	struct xmp_module *mod = &m->mod;
-	int i, ord;
+	int i, ord, size;
+	char *cnt;
 
 	if (mod->xxp == NULL || mod->xxt == NULL)
 		return -XMP_ERROR_LOAD;
@@ -324,10 +433,7 @@ int libxmp_prepare_scan(struct context_data *ctx)
 		return 0;
 	}
 
-	m->scan_cnt = calloc(sizeof (char *), mod->len);
-	if (m->scan_cnt == NULL)
-		return -XMP_ERROR_SYSTEM;
-
+	size = 0;
 	for (i = 0; i < mod->len; i++) {
 		int pat_idx = mod->xxo[i];
 		struct xmp_pattern *pat;
@@ -340,9 +446,22 @@ int libxmp_prepare_scan(struct context_data *ctx)
 		}
 
 		pat = pat_idx >= mod->pat ? NULL : mod->xxp[pat_idx];
-		m->scan_cnt[i] = calloc(1, pat && pat->rows ? pat->rows : 1);
-		if (m->scan_cnt[i] == NULL)
-			return -XMP_ERROR_SYSTEM;
+		size += pat && pat->rows ? pat->rows : 1;
+	}
+
+	/* Row counters are stored after the order pointers in one block */
+	m->scan_cnt = calloc(1, sizeof (char *) * mod->len + size);
+	if (m->scan_cnt == NULL)
+		return -XMP_ERROR_SYSTEM;
+
+	cnt = (char *)(m->scan_cnt + mod->len);
+	for (i = 0; i < mod->len; i++) {
+		int pat_idx = mod->xxo[i];
+		struct xmp_pattern *pat;
+
+		pat = pat_idx >= mod->pat ? NULL : mod->xxp[pat_idx];
+		m->scan_cnt[i] = cnt;
+		cnt += pat && pat->rows ? pat->rows : 1;
 	}
  
 	return 0;
@@ -48,7 +48,7 @@ static int alm_test(HIO_HANDLE *f, char *t, const int start)
 {
     char buf[7];
 
-    if (HIO_HANDLE_TYPE(f) != HIO_HANDLE_TYPE_FILE)
+    if (HIO_HANDLE_TYPE(f) == HIO_HANDLE_TYPE_MEMORY && f->path == NULL)
 	return -1;
 
     if (hio_read(buf, 1, 7, f) < 7)
@@ -151,7 +151,6 @@ static int alm_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	if (libxmp_alloc_subinstrument(mod, i, 1) < 0)
 	    return -1;
 
-	mod->xxi[i].sub = calloc(sizeof (struct xmp_subinstrument), 1);
 	snprintf(filename, NAME_SIZE, "%s.%d", basename, i + 1);
 	s = hio_open_file(filename, "rb");
 
@@ -34,6 +34,9 @@
 #include "period.h"
 #include "loader.h"
 
+/* The module is the first member of struct module_data */
+#define MODULE_DATA(mod) ((struct module_data *)(mod))
+
 int libxmp_init_instrument(struct module_data *m)
 {
 	struct xmp_module *mod = &m->mod;
@@ -67,7 +70,8 @@ int libxmp_alloc_subinstrument(struct xmp_module *mod, int i, int num)
 	if (num == 0)
 		return 0;
 
-	mod->xxi[i].sub = calloc(sizeof (struct xmp_subinstrument), num);
+	mod->xxi[i].sub = libxmp_arena_alloc(MODULE_DATA(mod),
+				sizeof (struct xmp_subinstrument) * num);
 	if (mod->xxi[i].sub == NULL)
 		return -1;
 
@@ -93,8 +97,8 @@ int libxmp_alloc_pattern(struct xmp_module *mod, int num)
 	if (num < 0 || num >= mod->pat || mod->xxp[num] != NULL)
 		return -1;
 
-	mod->xxp[num] = calloc(1, sizeof (struct xmp_pattern) +
-        				sizeof (int) * (mod->chn - 1));
+	mod->xxp[num] = libxmp_arena_alloc(MODULE_DATA(mod),
+		sizeof (struct xmp_pattern) + sizeof (int) * (mod->chn - 1));
 	if (mod->xxp[num] == NULL)
 		return -1;
 
@@ -107,8 +111,8 @@ int libxmp_alloc_track(struct xmp_module *mod, int num, int rows)
 	if (num < 0 || num >= mod->trk || mod->xxt[num] != NULL || rows <= 0)
 		return -1;
 
-	mod->xxt[num] = calloc(sizeof (struct xmp_track) +
-			       sizeof (struct xmp_event) * (rows - 1), 1);
+	mod->xxt[num] = libxmp_arena_alloc(MODULE_DATA(mod),
+		sizeof (struct xmp_track) + sizeof (struct xmp_event) * (rows - 1));
 	if (mod->xxt[num] == NULL)
 		return -1;
 
@@ -76,7 +76,8 @@ int fcm_load(struct module_data *m, HIO_HANDLE *f)
 	B_ENDIAN16 (fh.ins[i].size);
 	B_ENDIAN16 (fh.ins[i].loop_start);
 	B_ENDIAN16 (fh.ins[i].loop_size);
-	mod->xxi[i].sub = calloc(sizeof (struct xmp_subinstrument), 1);
+	if (libxmp_alloc_subinstrument(mod, i, 1) < 0)
+	    return -1;
 	mod->xxs[i].len = 2 * fh.ins[i].size;
 	mod->xxs[i].lps = 2 * fh.ins[i].loop_start;
 	mod->xxs[i].lpe = mod->xxs[i].lps + 2 * fh.ins[i].loop_size;
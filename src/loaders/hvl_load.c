@@ -253,14 +253,15 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 	if (transposed) {
 		mod->trk += transposed;
 		mod->xxt = realloc(mod->xxt, mod->trk * sizeof (struct xmp_track *));
+		memset(mod->xxt + mod->trk - transposed, 0,
+				transposed * sizeof (struct xmp_track *));
 	}
 	
 	reportv(ctx, 0, "Stored tracks  : %d ", mod->trk);
 
 	for (i = 0; i < mod->trk; i++) {
-		mod->xxt[i] = calloc(sizeof(struct xmp_track) +
-				   sizeof(struct xmp_event) * pattlen - 1, 1);
-                mod->xxt[i]->rows = pattlen;
+		if (libxmp_alloc_track(mod, i, pattlen) < 0)
+			return -1;
 
 		if (!i && blank)
 			continue;
@@ -317,7 +318,8 @@ static int hvl_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		int vol, fspd, wavelen, flow, vibdel, hclen, hc;
 		int vibdep, vibspd, sqmin, sqmax, sqspd, fmax, plen, pspd;
 		int Alen, Avol, Dlen, Dvol, Slen, Rlen, Rvol;
-                mod->xxi[i].sub = calloc(sizeof (struct xmp_subinstrument), 1);
+		if (libxmp_alloc_subinstrument(mod, i, 1) < 0)
+			return -1;
 
 		hio_read(buf, 22, 1, f);
 
@@ -414,8 +414,9 @@ static void identify_tracker(struct module_data *m, struct it_file_header *ifh)
 #endif
 }
 
-static int load_old_it_instrument(struct xmp_instrument *xxi, HIO_HANDLE *f)
+static int load_old_it_instrument(struct xmp_module *mod, int i, HIO_HANDLE *f)
 {
+	struct xmp_instrument *xxi = &mod->xxi[i];
 	int inst_map[120], inst_rmap[XMP_MAX_KEYS];
 	struct it_instrument1_header i1h;
 	int c, k, j;
@@ -514,8 +515,7 @@ static int load_old_it_instrument(struct xmp_instrument *xxi, HIO_HANDLE *f)
 	xxi->vol = 0x40;
 
 	if (k) {
-		xxi->sub = calloc(sizeof(struct xmp_subinstrument), k);
-		if (xxi->sub == NULL) {
+		if (libxmp_alloc_subinstrument(mod, i, k) < 0) {
 			return -1;
 		}
 
@@ -544,8 +544,9 @@ static int load_old_it_instrument(struct xmp_instrument *xxi, HIO_HANDLE *f)
 	return 0;
 }
 
-static int load_new_it_instrument(struct xmp_instrument *xxi, HIO_HANDLE *f)
+static int load_new_it_instrument(struct xmp_module *mod, int i, HIO_HANDLE *f)
 {
+	struct xmp_instrument *xxi = &mod->xxi[i];
 	int inst_map[120], inst_rmap[XMP_MAX_KEYS];
 	struct it_instrument2_header i2h;
 	struct it_envelope env;
@@ -665,8 +666,7 @@ static int load_new_it_instrument(struct xmp_instrument *xxi, HIO_HANDLE *f)
 	xxi->vol = i2h.gbv >> 1;
 
 	if (k) {
-		xxi->sub = calloc(sizeof(struct xmp_subinstrument), k);
-		if (xxi->sub == NULL)
+		if (libxmp_alloc_subinstrument(mod, i, k) < 0)
 			return -1;
 
 		for (j = 0; j < k; j++) {
@@ -709,8 +709,7 @@ static int load_it_sample(struct module_data *m, int i, int start,
 	uint8 buf[80];
 
 	if (sample_mode) {
-		mod->xxi[i].sub = calloc(sizeof(struct xmp_subinstrument), 1);
-		if (mod->xxi[i].sub == NULL) {
+		if (libxmp_alloc_subinstrument(mod, i, 1) < 0) {
 			return -1;
 		}
 	}
@@ -1198,15 +1197,13 @@ static int it_load(struct module_data *m, HIO_HANDLE *f, const int start)
 		 * different loader for each of them.
 		 */
 
-		struct xmp_instrument *xxi = &mod->xxi[i];
-
 		if (!sample_mode && ifh.cmwt >= 0x200) {
 			/* New instrument format */
 			if (hio_seek(f, start + pp_ins[i], SEEK_SET) < 0) {
 				goto err4;
 			}
 
-			if (load_new_it_instrument(xxi, f) < 0) {
+			if (load_new_it_instrument(mod, i, f) < 0) {
 				goto err4;
 			}
 
@@ -1216,7 +1213,7 @@ static int it_load(struct module_data *m, HIO_HANDLE *f, const int start)
 				goto err4;
 			}
 
-			if (load_old_it_instrument(xxi, f) < 0) {
+			if (load_old_it_instrument(mod, i, f) < 0) {
 				goto err4;
 			}
 		}
@@ -519,8 +519,7 @@ static int s3m_load(struct module_data *m, HIO_HANDLE * f, const int start)
 		struct xmp_sample *xxs = &mod->xxs[i];
 		struct xmp_subinstrument *sub;
 
-		xxi->sub = calloc(sizeof(struct xmp_subinstrument), 1);
-		if (xxi->sub == NULL) {
+		if (libxmp_alloc_subinstrument(mod, i, 1) < 0) {
 			goto err3;
 		}
 
@@ -22,6 +22,14 @@
 
 #include "common.h"
 #include "loader.h"
+#include "mix_thread.h"
+
+#ifdef MIXER_THREADS
+#include <pthread.h>
+#endif
+
+static int lazy_defer(struct module_data *, HIO_HANDLE *, int,
+				struct xmp_sample *, int);
 
 #ifndef LIBXMP_CORE_PLAYER
 
@@ -268,6 +276,11 @@ int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct x
 		unroll_extralen *= 2;
 	}
 
+	/* Record samples to load on first use */
+	if (m != NULL && m->lazy != NULL && lazy_defer(m, f, flags, xxs, bytelen)) {
+		return 0;
+	}
+
 	/* add guard bytes before the buffer for higher order interpolation */
 	xxs->data = malloc(bytelen + extralen + unroll_extralen + 4);
 	if (xxs->data == NULL) {
@@ -415,3 +428,206 @@ int libxmp_load_sample(struct module_data *m, HIO_HANDLE *f, int flags, struct x
     err:
 	return -1;
 }
+
+/*
+ * Lazy sample loading
+ *
+ * With XMP_SMPCTL_LAZY, samples read from the module file as they are
+ * stored aren't loaded with the module. Their file position and load
+ * flags are recorded instead, and they are loaded from the module file
+ * when first played. Sustain loop samples are loaded with their sample.
+ */
+
+#define LAZY_SAMPLE	0
+#define LAZY_SUSTAIN	1
+
+struct lazy_sample {
+	long pos[2];		/* sample position in the module file */
+	int flags[2];		/* sample load flags */
+	int pending;		/* samples not loaded yet */
+};
+
+struct lazy_data {
+	char *path;		/* module file */
+	HIO_HANDLE *f;		/* module file being loaded or reopened */
+	int loading;
+	int num;
+	struct lazy_sample *smp;
+#ifdef MIXER_THREADS
+	pthread_mutex_t lock;
+#endif
+};
+
+int libxmp_lazy_init(struct module_data *m, HIO_HANDLE *f, const char *path)
+{
+	struct lazy_data *lz;
+
+	if ((lz = calloc(1, sizeof (struct lazy_data))) == NULL) {
+		return -1;
+	}
+
+	if ((lz->path = strdup(path)) == NULL) {
+		free(lz);
+		return -1;
+	}
+
+#ifdef MIXER_THREADS
+	if (pthread_mutex_init(&lz->lock, NULL) != 0) {
+		free(lz->path);
+		free(lz);
+		return -1;
+	}
+#endif
+
+	lz->f = f;
+	lz->loading = 1;
+	m->lazy = lz;
+
+	return 0;
+}
+
+/* Stop recording samples, the module file is about to be closed */
+void libxmp_lazy_done(struct module_data *m)
+{
+	struct lazy_data *lz = m->lazy;
+	int i;
+
+	if (lz == NULL) {
+		return;
+	}
+
+	lz->f = NULL;
+	lz->loading = 0;
+
+	for (i = 0; i < lz->num; i++) {
+		if (lz->smp[i].pending) {
+			return;
+		}
+	}
+
+	/* All samples were loaded */
+	libxmp_lazy_release(m);
+}
+
+void libxmp_lazy_release(struct module_data *m)
+{
+	struct lazy_data *lz = m->lazy;
+
+	if (lz == NULL) {
+		return;
+	}
+
+	if (lz->f != NULL && !lz->loading) {
+		hio_close(lz->f);
+	}
+#ifdef MIXER_THREADS
+	pthread_mutex_destroy(&lz->lock);
+#endif
+	free(lz->smp);
+	free(lz->path);
+	free(lz);
+	m->lazy = NULL;
+}
+
+static int lazy_defer(struct module_data *m, HIO_HANDLE *f, int flags,
+				struct xmp_sample *xxs, int bytelen)
+{
+	struct xmp_module *mod = &m->mod;
+	struct lazy_data *lz = m->lazy;
+	struct lazy_sample *ls;
+	int i, which;
+	long pos;
+
+	if (!lz->loading || f != lz->f) {
+		return 0;
+	}
+
+	if (flags & (SAMPLE_FLAG_NOLOAD | SAMPLE_FLAG_ADPCM)) {
+		return 0;
+	}
+
+	if (mod->xxs != NULL && xxs >= mod->xxs && xxs < mod->xxs + mod->smp) {
+		i = xxs - mod->xxs;
+		which = LAZY_SAMPLE;
+#ifndef LIBXMP_CORE_DISABLE_IT
+	} else if (m->xsmp != NULL && xxs >= m->xsmp &&
+					xxs < m->xsmp + mod->smp) {
+		i = xxs - m->xsmp;
+		which = LAZY_SUSTAIN;
+#endif
+	} else {
+		return 0;
+	}
+
+	if (i >= lz->num) {
+		int num = MAX(i + 1, mod->smp);
+
+		ls = realloc(lz->smp, sizeof (struct lazy_sample) * num);
+		if (ls == NULL) {
+			return 0;
+		}
+		memset(ls + lz->num, 0,
+			sizeof (struct lazy_sample) * (num - lz->num));
+		lz->smp = ls;
+		lz->num = num;
+	}
+
+	if ((pos = hio_tell(f)) < 0 || hio_seek(f, bytelen, SEEK_CUR) < 0) {
+		return 0;
+	}
+
+	ls = &lz->smp[i];
+	ls->pos[which] = pos;
+	ls->flags[which] = flags;
+	ls->pending |= 1 << which;
+
+	return 1;
+}
+
+static void lazy_load(struct module_data *m, struct lazy_sample *ls,
+				int which, struct xmp_sample *xxs)
+{
+	HIO_HANDLE *f = m->lazy->f;
+
+	if (~ls->pending & (1 << which) || xxs->data != NULL) {
+		return;
+	}
+
+	if (f != NULL && hio_seek(f, ls->pos[which], SEEK_SET) == 0) {
+		libxmp_load_sample(m, f, ls->flags[which], xxs, NULL);
+	}
+}
+
+/* Load a recorded sample before it's played */
+void libxmp_lazy_load(struct module_data *m, int smp)
+{
+	struct lazy_data *lz = m->lazy;
+	struct lazy_sample *ls;
+
+	if (lz == NULL || smp < 0 || smp >= lz->num || smp >= m->mod.smp) {
+		return;
+	}
+
+#ifdef MIXER_THREADS
+	pthread_mutex_lock(&lz->lock);
+#endif
+
+	ls = &lz->smp[smp];
+	if (ls->pending) {
+		if (lz->f == NULL) {
+			lz->f = hio_open(lz->path, "rb");
+		}
+
+		lazy_load(m, ls, LAZY_SAMPLE, &m->mod.xxs[smp]);
+#ifndef LIBXMP_CORE_DISABLE_IT
+		if (m->xsmp != NULL) {
+			lazy_load(m, ls, LAZY_SUSTAIN, &m->xsmp[smp]);
+		}
+#endif
+		ls->pending = 0;
+	}
+
+#ifdef MIXER_THREADS
+	pthread_mutex_unlock(&lz->lock);
+#endif
+}
@@ -133,7 +133,7 @@ void cubic_spline_init(void)
 #define WFIR_16BITSHIFT     (WFIR_QUANTBITS)
 
 // log2(number)-1 of precalculated taps range is [4..12]
-#define WFIR_FRACBITS       10
+#define WFIR_FRACBITS       9
 #define WFIR_LUTLEN         ((1L << (WFIR_FRACBITS + 1)) + 1)
 
 // number of samples in window
@@ -271,6 +271,18 @@ void windowed_fir_init(void)
     \
     printf("\n};\n\n");
 
+#define LOOP3(x, y, w) \
+    printf("static int16 %s[%lu] = {\n\t", #x, y * w); \
+    \
+    for (int i = 0; i < y * w; i++) { \
+        if (i && !(i % w)) { \
+            printf("\n\t"); \
+        } \
+        printf(" %d,", x[i]); \
+    } \
+    \
+    printf("\n};\n\n");
+
 #define LOOP2(x, y) \
 for(int j = 0; j < 4; j++) { \
     printf("static int16 %s%d[%lu] = {\n\t", #x, j, y); \
@@ -292,7 +304,7 @@ int main(int argc, char **argv)
     windowed_fir_init();
 
     LOOP2(cubic_spline_lut, SPLINE_LUTLEN);
-    //LOOP(windowed_fir_lut, (WFIR_LUTLEN * WFIR_WIDTH));
+    LOOP3(windowed_fir_lut, WFIR_LUTLEN, WFIR_WIDTH);
 
     return 0;
 }
@@ -242,7 +242,10 @@ void libxmp_med_play_extras(struct context_data *ctx, struct channel_data *xc, i
 		if (ce->env_wav >= 0) {
 			int sid = mod->xxi[xc->ins].sub[ce->env_wav].sid;
 			struct xmp_sample *xxs = &mod->xxs[sid];
-			if (xxs->len == 0x80) {		/* sanity check */
+
+			/* The envelope waveform may never have been played */
+			libxmp_lazy_load(m, sid);
+			if (xxs->len == 0x80 && xxs->data != NULL) {	/* sanity check */
 				ce->volume = ((int8)xxs->data[ce->env_idx] + 0x80) >> 2;
 				ce->env_idx++;
 
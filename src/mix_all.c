@@ -81,6 +81,53 @@
               cubic_spline_lut2[f] * sptr[pos + 1]) >> SPLINE_SHIFT; \
 } while (0)
 
+/* Windowed FIR (sinc) settings, see lutgen.c. Also PRECOMPUTED.
+ */
+/* number of bits used to scale the FIR coefs */
+#define SINC_QUANTBITS  15
+#define SINC_SHIFT      (SINC_QUANTBITS)
+
+/* number of taps, SINC_LEFT of them before the current sample */
+#define SINC_WIDTH      8
+#define SINC_LEFT       3
+
+/* log2(number) - 1 of precalculated tap sets */
+#define SINC_FRACBITS   9
+#define SINC_FRACSHIFT  (SMIX_SHIFT - SINC_FRACBITS - 1)
+#define SINC_FRACHALF   (1 << (SINC_FRACSHIFT - 1))
+
+/* Taps before the start of the sample read the first sample */
+#define SINC_TAPS() do { \
+    c = windowed_fir_lut + \
+        ((frac + SINC_FRACHALF) >> SINC_FRACSHIFT) * SINC_WIDTH; \
+    if (pos >= SINC_LEFT) { \
+        s = sptr + pos - SINC_LEFT; \
+    } else { \
+        int t; \
+        for (t = 0; t < SINC_WIDTH; t++) { \
+            int i = (int)pos - SINC_LEFT + t; \
+            sinc_head[t] = sptr[i < 0 ? 0 : i]; \
+        } \
+        s = sinc_head; \
+    } \
+} while (0)
+
+#define SINC_INTERP() do { \
+    SINC_TAPS(); \
+    smp_in = (c[0] * s[0] + c[1] * s[1] + c[2] * s[2] + c[3] * s[3] + \
+              c[4] * s[4] + c[5] * s[5] + c[6] * s[6] + c[7] * s[7]) \
+                                                >> (SINC_SHIFT - 8); \
+} while (0)
+
+/* Summed in two halves to stay in 32 bits */
+#define SINC_INTERP_16BIT() do { \
+    int v1, v2; \
+    SINC_TAPS(); \
+    v1 = c[0] * s[0] + c[1] * s[1] + c[2] * s[2] + c[3] * s[3]; \
+    v2 = c[4] * s[4] + c[5] * s[5] + c[6] * s[6] + c[7] * s[7]; \
+    smp_in = ((v1 >> 1) + (v2 >> 1)) >> (SINC_SHIFT - 1); \
+} while (0)
+
 #define LOOP_AC for (; count > ramp; count--)
 
 #define LOOP for (; count; count--)
@@ -149,8 +196,8 @@
 #define VAR_NORM(x) \
     register int smp_in; \
     x *sptr = vi->sptr; \
-    unsigned int pos = vi->pos; \
-    int frac = (1 << SMIX_SHIFT) * (vi->pos - (int)vi->pos)
+    unsigned int pos = VOICE_POS_INT(vi->pos); \
+    int frac = VOICE_POS_FRAC(vi->pos)
 
 #define VAR_LINEAR_MONO(x) \
     VAR_NORM(x); \
@@ -169,6 +216,16 @@
     VAR_SPLINE_MONO(x); \
     int old_vr = vi->old_vr
 
+#define VAR_SINC_MONO(x) \
+    VAR_SPLINE_MONO(x); \
+    x sinc_head[SINC_WIDTH]; \
+    const x *s; \
+    const int16 *c
+
+#define VAR_SINC_STEREO(x) \
+    VAR_SINC_MONO(x); \
+    int old_vr = vi->old_vr
+
 #ifndef LIBXMP_CORE_DISABLE_IT
 
 #define VAR_FILTER_MONO \
@@ -437,3 +494,104 @@ MIXER(stereo_16bit_spline_filter)
 }
 
 #endif
+
+
+/*
+ * Sinc mixers
+ */
+
+/* Handler for 8 bit samples, sinc interpolated mono output
+ */
+MIXER(mono_8bit_sinc)
+{
+    VAR_SINC_MONO(int8);
+
+    LOOP_AC { SINC_INTERP(); MIX_MONO_AC(); UPDATE_POS(); }
+    LOOP    { SINC_INTERP(); MIX_MONO(); UPDATE_POS(); }
+}
+
+/* Handler for 16 bit samples, sinc interpolated mono output
+ */
+MIXER(mono_16bit_sinc)
+{
+    VAR_SINC_MONO(int16);
+
+    LOOP_AC { SINC_INTERP_16BIT(); MIX_MONO_AC(); UPDATE_POS(); }
+    LOOP    { SINC_INTERP_16BIT(); MIX_MONO(); UPDATE_POS(); }
+}
+
+/* Handler for 8 bit samples, sinc interpolated stereo output
+ */
+MIXER(stereo_8bit_sinc)
+{
+    VAR_SINC_STEREO(int8);
+
+    LOOP_AC { SINC_INTERP(); MIX_STEREO_AC(); UPDATE_POS(); }
+    LOOP    { SINC_INTERP(); MIX_STEREO(); UPDATE_POS(); }
+}
+
+/* Handler for 16 bit samples, sinc interpolated stereo output
+ */
+MIXER(stereo_16bit_sinc)
+{
+    VAR_SINC_STEREO(int16);
+
+    LOOP_AC { SINC_INTERP_16BIT(); MIX_STEREO_AC(); UPDATE_POS(); }
+    LOOP    { SINC_INTERP_16BIT(); MIX_STEREO(); UPDATE_POS(); }
+}
+
+#ifndef LIBXMP_CORE_DISABLE_IT
+
+/* Handler for 8 bit samples, filtered sinc interpolated mono output
+ */
+MIXER(mono_8bit_sinc_filter)
+{
+    VAR_SINC_MONO(int8);
+    VAR_FILTER_MONO;
+
+    LOOP_AC { SINC_INTERP(); MIX_MONO_FILTER_AC(); UPDATE_POS(); }
+    LOOP    { SINC_INTERP(); MIX_MONO_FILTER(); UPDATE_POS(); }
+
+    SAVE_FILTER_MONO();
+}
+
+/* Handler for 16 bit samples, filtered sinc interpolated mono output
+ */
+MIXER(mono_16bit_sinc_filter)
+{
+    VAR_SINC_MONO(int16);
+    VAR_FILTER_MONO;
+
+    LOOP_AC { SINC_INTERP_16BIT(); MIX_MONO_FILTER_AC(); UPDATE_POS(); }
+    LOOP    { SINC_INTERP_16BIT(); MIX_MONO_FILTER(); UPDATE_POS(); }
+
+    SAVE_FILTER_MONO();
+}
+
+/* Handler for 8 bit samples, filtered sinc interpolated stereo output
+ */
+MIXER(stereo_8bit_sinc_filter)
+{
+    VAR_SINC_STEREO(int8);
+    VAR_FILTER_STEREO;
+
+    LOOP_AC { SINC_INTERP(); MIX_STEREO_FILTER_AC(); UPDATE_POS(); }
+    LOOP    { SINC_INTERP(); MIX_STEREO_FILTER(); UPDATE_POS(); }
+
+    SAVE_FILTER_STEREO();
+}
+
+/* Handler for 16 bit samples, filtered sinc interpolated stereo output
+ */
+MIXER(stereo_16bit_sinc_filter)
+{
+    VAR_SINC_STEREO(int16);
+    VAR_FILTER_STEREO;
+
+    LOOP_AC { SINC_INTERP_16BIT(); MIX_STEREO_FILTER_AC(); UPDATE_POS(); }
+    LOOP    { SINC_INTERP_16BIT(); MIX_STEREO_FILTER(); UPDATE_POS(); }
+
+    SAVE_FILTER_STEREO();
+}
+
+#endif
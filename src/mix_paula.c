@@ -15,25 +15,26 @@ void libxmp_paula_init(struct context_data *ctx, struct paula_state *paula)
 	struct mixer_data *s = &ctx->s;
 
 	paula->global_output_level = 0;
+	paula->clock = 0;
+	paula->first = 0;
 	paula->active_bleps = 0;
 	paula->fdiv = (double)PAULA_HZ / s->freq;
 	paula->remainder = paula->fdiv;
 }
 
-/* return output simulated as series of bleps */
-static int16 output_sample(struct paula_state *paula, int tabnum)
+/* drop bleps that are BLEP_SIZE clocks or older, they are always the
+ * oldest ones at the start of the ring */
+static inline void expire_bleps(struct paula_state *paula, uint32 clock)
 {
-	int i;
-	int32 output;
-
-	output = paula->global_output_level << BLEP_SCALE;
-	for (i = 0; i < paula->active_bleps; i++) {
-		int age = paula->blepstate[i].age;
-		int level = paula->blepstate[i].level;
-		output -= winsinc_integral[tabnum][age] * level;
+	while (paula->active_bleps > 0 &&
+		clock - paula->birth[paula->first] >= BLEP_SIZE) {
+		paula->first = (paula->first + 1) & (MAX_BLEPS - 1);
+		paula->active_bleps--;
 	}
-	output >>= BLEP_SCALE;
+}
 
+static inline int clamp_output(int32 output)
+{
 	if (output < -32768)
 		output = -32768;
 	else if (output > 32767)
@@ -42,42 +43,71 @@ static int16 output_sample(struct paula_state *paula, int tabnum)
 	return output;
 }
 
-static void input_sample(struct paula_state *paula, int16 sample)
+/* return output simulated as series of bleps */
+static int output_sample(struct paula_state *paula, int tabnum,
+			 int level, uint32 clock)
 {
-	if (sample != paula->global_output_level) {
-		/* Start a new blep: level is the difference, age (or phase) is 0 clocks. */
-		if (paula->active_bleps > MAX_BLEPS - 1) {
-			fprintf(stderr, "warning: active blep list truncated!\n");
-			paula->active_bleps = MAX_BLEPS - 1;
-		}
-
-		/* Make room for new blep */
-		memmove(&paula->blepstate[1], &paula->blepstate[0],
-			sizeof(struct blep_state) * paula->active_bleps);
-
-		/* Update state to account for the new blep */
-		paula->active_bleps++;
-		paula->blepstate[0].age = 0;
-		paula->blepstate[0].level = sample - paula->global_output_level;
-		paula->global_output_level = sample;
+	const int *table = winsinc_integral[tabnum];
+	const int32 *delta;
+	const uint32 *birth;
+	int32 output;
+	int i, n;
+
+	expire_bleps(paula, clock);
+
+	delta = paula->level + paula->first;
+	birth = paula->birth + paula->first;
+	n = paula->active_bleps;
+
+	output = level * (1 << BLEP_SCALE);
+	for (i = 0; i < n; i++) {
+		output -= table[clock - birth[i]] * delta[i];
 	}
+
+	return clamp_output(output >> BLEP_SCALE);
 }
 
-static void do_clock(struct paula_state *paula, int cycles)
+/* 16 bit levels overflow 32 bits when scaled by the blep table */
+static int output_sample_16bit(struct paula_state *paula, int tabnum,
+			       int level, uint32 clock)
 {
-	int i;
+	const int *table = winsinc_integral[tabnum];
+	const int32 *delta;
+	const uint32 *birth;
+	int64 output;
+	int i, n;
 
-	if (cycles <= 0) {
-		return;
+	expire_bleps(paula, clock);
+
+	delta = paula->level + paula->first;
+	birth = paula->birth + paula->first;
+	n = paula->active_bleps;
+
+	output = (int64)level * (1 << BLEP_SCALE);
+	for (i = 0; i < n; i++) {
+		output -= (int64)table[clock - birth[i]] * delta[i];
 	}
 
-	for (i = 0; i < paula->active_bleps; i++) {
-		paula->blepstate[i].age += cycles;
-		if (paula->blepstate[i].age >= BLEP_SIZE) {
-			paula->active_bleps = i;
-			break;
-		}
+	return clamp_output((int32)(output >> BLEP_SCALE));
+}
+
+/* Start a new blep: level is the difference, age (or phase) is 0 clocks */
+static void add_blep(struct paula_state *paula, int delta, uint32 clock)
+{
+	unsigned int i;
+
+	expire_bleps(paula, clock);
+
+	/* Can't happen with inputs MINIMUM_INTERVAL apart */
+	if (paula->active_bleps >= MAX_BLEPS) {
+		paula->first = (paula->first + 1) & (MAX_BLEPS - 1);
+		paula->active_bleps--;
 	}
+
+	i = (paula->first + paula->active_bleps) & (MAX_BLEPS - 1);
+	paula->level[i] = paula->level[i + MAX_BLEPS] = delta;
+	paula->birth[i] = paula->birth[i + MAX_BLEPS] = clock;
+	paula->active_bleps++;
 }
 
 #define LOOP for (; count; count--)
@@ -88,26 +118,43 @@ static void do_clock(struct paula_state *paula, int cycles)
 	frac &= SMIX_MASK; \
 } while (0)
 
-#define PAULA_SIMULATION(x) do { \
-	int num_in = vi->paula->remainder / MINIMUM_INTERVAL; \
-	int ministep = step / num_in; \
+#define INPUT_SAMPLE() do { \
+	int in = sptr[pos]; \
+	if (in != level) { \
+		add_blep(paula, in - level, clock); \
+		level = in; \
+	} \
+} while (0)
+
+/* The number of inputs per output sample only takes two values, so the
+ * input steps are computed once per call instead of dividing every time.
+ * Clock and level are kept in locals and stored back by PAULA_DONE().
+ */
+#define PAULA_SIMULATION(x, output) do { \
+	int num_in = paula->remainder / MINIMUM_INTERVAL; \
+	int ministep = num_in == min_in ? min_step : \
+			num_in == min_in + 1 ? max_step : step / num_in; \
 	int i; \
 	\
 	/* input is always sampled at a higher rate than output */ \
 	for (i = 0; i < num_in - 1; i++) { \
-		input_sample(vi->paula, sptr[pos]); \
-		do_clock(vi->paula, MINIMUM_INTERVAL); \
+		INPUT_SAMPLE(); \
+		clock += MINIMUM_INTERVAL; \
 		UPDATE_POS(ministep); \
 	} \
-	input_sample(vi->paula, sptr[pos]); \
-	vi->paula->remainder -= num_in * MINIMUM_INTERVAL; \
+	INPUT_SAMPLE(); \
+	paula->remainder -= num_in * MINIMUM_INTERVAL; \
 	\
-	do_clock(vi->paula, (int)vi->paula->remainder); \
-	smp_in = output_sample(vi->paula, (x)); \
-	do_clock(vi->paula, MINIMUM_INTERVAL - (int)vi->paula->remainder); \
+	smp_in = output(paula, (x), level, clock + (int)paula->remainder); \
+	clock += MINIMUM_INTERVAL; \
 	UPDATE_POS(step - (num_in - 1) * ministep); \
 	\
-	vi->paula->remainder += vi->paula->fdiv; \
+	paula->remainder += paula->fdiv; \
+} while (0)
+
+#define PAULA_DONE() do { \
+	paula->clock = clock; \
+	paula->global_output_level = level; \
 } while (0)
 
 #define MIX_MONO() do { \
@@ -122,41 +169,94 @@ static void do_clock(struct paula_state *paula, int cycles)
 #define VAR_NORM(x) \
     int smp_in; \
     x *sptr = vi->sptr; \
-    unsigned int pos = vi->pos; \
-    int frac = (1 << SMIX_SHIFT) * (vi->pos - (int)vi->pos)
+    unsigned int pos = VOICE_POS_INT(vi->pos); \
+    int frac = VOICE_POS_FRAC(vi->pos)
 
-#define VAR_PAULA(x) \
+#define VAR_PAULA_16BIT(x) \
     VAR_NORM(x); \
+    struct paula_state *paula = vi->paula; \
+    uint32 clock = paula->clock; \
+    int level = paula->global_output_level; \
+    int min_in = paula->fdiv / MINIMUM_INTERVAL; \
+    int min_step = step / min_in; \
+    int max_step = step / (min_in + 1)
+
+#define VAR_PAULA(x) \
+    VAR_PAULA_16BIT(x); \
     vl <<= 8; \
     vr <<= 8
 
 
-MIXER(mono_a500)
+MIXER(mono_8bit_a500)
 {
 	VAR_PAULA(int8);
 
-	LOOP { PAULA_SIMULATION(0); MIX_MONO(); }
-} 
+	LOOP { PAULA_SIMULATION(0, output_sample); MIX_MONO(); }
 
-MIXER(mono_a500_filter)
+	PAULA_DONE();
+}
+
+MIXER(mono_16bit_a500)
+{
+	VAR_PAULA_16BIT(int16);
+
+	LOOP { PAULA_SIMULATION(0, output_sample_16bit); MIX_MONO(); }
+
+	PAULA_DONE();
+}
+
+MIXER(mono_8bit_a500_filter)
 {
 	VAR_PAULA(int8);
 
-	LOOP { PAULA_SIMULATION(1); MIX_MONO(); }
-} 
+	LOOP { PAULA_SIMULATION(1, output_sample); MIX_MONO(); }
+
+	PAULA_DONE();
+}
+
+MIXER(mono_16bit_a500_filter)
+{
+	VAR_PAULA_16BIT(int16);
+
+	LOOP { PAULA_SIMULATION(1, output_sample_16bit); MIX_MONO(); }
+
+	PAULA_DONE();
+}
 
-MIXER(stereo_a500)
+MIXER(stereo_8bit_a500)
 {
 	VAR_PAULA(int8);
 
-	LOOP { PAULA_SIMULATION(0); MIX_STEREO(); }
-} 
+	LOOP { PAULA_SIMULATION(0, output_sample); MIX_STEREO(); }
 
-MIXER(stereo_a500_filter)
+	PAULA_DONE();
+}
+
+MIXER(stereo_16bit_a500)
+{
+	VAR_PAULA_16BIT(int16);
+
+	LOOP { PAULA_SIMULATION(0, output_sample_16bit); MIX_STEREO(); }
+
+	PAULA_DONE();
+}
+
+MIXER(stereo_8bit_a500_filter)
 {
 	VAR_PAULA(int8);
 
-	LOOP { PAULA_SIMULATION(1); MIX_STEREO(); }
-} 
+	LOOP { PAULA_SIMULATION(1, output_sample); MIX_STEREO(); }
+
+	PAULA_DONE();
+}
+
+MIXER(stereo_16bit_a500_filter)
+{
+	VAR_PAULA_16BIT(int16);
+
+	LOOP { PAULA_SIMULATION(1, output_sample_16bit); MIX_STEREO(); }
+
+	PAULA_DONE();
+}
 
 #endif /* LIBXMP_PAULA_SIMULATOR */
@@ -0,0 +1,329 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2018 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "common.h"
+#include "virtual.h"
+#include "mixer.h"
+#include "precomp_lut.h"
+
+/* SIMD mixers
+ *
+ * Vectorized versions of the unfiltered nearest, linear, spline and sinc mixers
+ * in mix_all.c. The kernels are built from mix_simd.h once for each
+ * instruction set supported by the compiler, and the best set available
+ * on the running CPU is selected by libxmp_mixer_simd_setup(). Define
+ * LIBXMP_NO_SIMD to build the scalar mixers only.
+ */
+
+#ifndef LIBXMP_NO_SIMD
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIX_SSE2
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+	(defined(__clang__) || (defined(__GNUC__) && \
+	(__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define MIX_AVX2
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define MIX_NEON
+#endif
+
+#endif /* LIBXMP_NO_SIMD */
+
+
+#define SIMD_KERNELS(x) \
+	mix_##x##_mono_8bit_nearest, mix_##x##_mono_16bit_nearest, \
+	mix_##x##_stereo_8bit_nearest, mix_##x##_stereo_16bit_nearest, \
+	mix_##x##_mono_8bit_linear, mix_##x##_mono_16bit_linear, \
+	mix_##x##_stereo_8bit_linear, mix_##x##_stereo_16bit_linear, \
+	mix_##x##_mono_8bit_spline, mix_##x##_mono_16bit_spline, \
+	mix_##x##_stereo_8bit_spline, mix_##x##_stereo_16bit_spline, \
+	mix_##x##_mono_8bit_sinc, mix_##x##_mono_16bit_sinc, \
+	mix_##x##_stereo_8bit_sinc, mix_##x##_stereo_16bit_sinc
+
+
+/*
+ * SSE2, 4 lanes
+ */
+
+#ifdef MIX_SSE2
+
+#include <emmintrin.h>
+
+/* SSE2 has no 32-bit low multiply, build it from two 32x32->64 multiplies */
+static inline __m128i mullo_sse2(__m128i a, __m128i b)
+{
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+				  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/* 8-tap FIR of samples scaled to 16 bits. Each half of the taps is summed
+ * separately and halved before adding, as in the scalar sinc mixers.
+ */
+static inline int32 sinc_sse2(__m128i smp, const int16 *c)
+{
+	__m128i p = _mm_madd_epi16(smp, _mm_loadu_si128((const __m128i *)c));
+
+	p = _mm_add_epi32(p, _mm_shuffle_epi32(p, _MM_SHUFFLE(2, 3, 0, 1)));
+	p = _mm_srai_epi32(p, 1);
+	p = _mm_add_epi32(p, _mm_shuffle_epi32(p, _MM_SHUFFLE(1, 0, 3, 2)));
+
+	return _mm_cvtsi128_si32(_mm_srai_epi32(p, 14));
+}
+
+#define VEC		__m128i
+#define SIMD_LANES	4
+#define V_LOAD(p)	_mm_loadu_si128((const __m128i *)(p))
+#define V_STORE(p,v)	_mm_storeu_si128((__m128i *)(p), (v))
+#define V_SET1(x)	_mm_set1_epi32(x)
+#define V_ADD(a,b)	_mm_add_epi32(a, b)
+#define V_SUB(a,b)	_mm_sub_epi32(a, b)
+#define V_MUL(a,b)	mullo_sse2(a, b)
+#define V_SRAI(a,n)	_mm_srai_epi32(a, n)
+#define V_INDEX		_mm_setr_epi32(0, 1, 2, 3)
+
+#define V_MIX_STEREO(p,r,l) do { \
+    V_STORE(p, V_ADD(V_LOAD(p), _mm_unpacklo_epi32(r, l))); \
+    V_STORE(p + 4, V_ADD(V_LOAD(p + 4), _mm_unpackhi_epi32(r, l))); \
+} while (0)
+
+#define V_SINC(p,c)	sinc_sse2(_mm_unpacklo_epi8(_mm_setzero_si128(), \
+			_mm_loadl_epi64((const __m128i *)(p))), c)
+#define V_SINC_16BIT(p,c) sinc_sse2(_mm_loadu_si128((const __m128i *)(p)), c)
+
+#define MIXER_SIMD(f) static void mix_sse2_##f(struct mixer_voice *vi, \
+	int *buffer, int count, int vl, int vr, int step, int ramp, \
+	int delta_l, int delta_r)
+
+#include "mix_simd.h"
+
+#undef VEC
+#undef SIMD_LANES
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_SUB
+#undef V_MUL
+#undef V_SRAI
+#undef V_INDEX
+#undef V_MIX_STEREO
+#undef V_SINC
+#undef V_SINC_16BIT
+#undef MIXER_SIMD
+
+static const mixer_fn sse2_mixers[] = { SIMD_KERNELS(sse2) };
+
+#endif /* MIX_SSE2 */
+
+
+/*
+ * AVX2, 8 lanes, selected at runtime
+ */
+
+#ifdef MIX_AVX2
+
+#include <immintrin.h>
+
+/* Same as sinc_sse2(), the taps fit in a 128-bit vector */
+__attribute__((target("avx2")))
+static inline int32 sinc_avx2(__m128i smp, const int16 *c)
+{
+	__m128i p = _mm_madd_epi16(smp, _mm_loadu_si128((const __m128i *)c));
+
+	p = _mm_add_epi32(p, _mm_shuffle_epi32(p, _MM_SHUFFLE(2, 3, 0, 1)));
+	p = _mm_srai_epi32(p, 1);
+	p = _mm_add_epi32(p, _mm_shuffle_epi32(p, _MM_SHUFFLE(1, 0, 3, 2)));
+
+	return _mm_cvtsi128_si32(_mm_srai_epi32(p, 14));
+}
+
+#define VEC		__m256i
+#define SIMD_LANES	8
+#define V_LOAD(p)	_mm256_loadu_si256((const __m256i *)(p))
+#define V_STORE(p,v)	_mm256_storeu_si256((__m256i *)(p), (v))
+#define V_SET1(x)	_mm256_set1_epi32(x)
+#define V_ADD(a,b)	_mm256_add_epi32(a, b)
+#define V_SUB(a,b)	_mm256_sub_epi32(a, b)
+#define V_MUL(a,b)	_mm256_mullo_epi32(a, b)
+#define V_SRAI(a,n)	_mm256_srai_epi32(a, n)
+#define V_INDEX		_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+
+#define V_MIX_STEREO(p,r,l) do { \
+    __m256i lo = _mm256_unpacklo_epi32(r, l); \
+    __m256i hi = _mm256_unpackhi_epi32(r, l); \
+    V_STORE(p, V_ADD(V_LOAD(p), _mm256_permute2x128_si256(lo, hi, 0x20))); \
+    V_STORE(p + 8, V_ADD(V_LOAD(p + 8), _mm256_permute2x128_si256(lo, hi, 0x31))); \
+} while (0)
+
+#define V_SINC(p,c)	sinc_avx2(_mm_unpacklo_epi8(_mm_setzero_si128(), \
+			_mm_loadl_epi64((const __m128i *)(p))), c)
+#define V_SINC_16BIT(p,c) sinc_avx2(_mm_loadu_si128((const __m128i *)(p)), c)
+
+#define MIXER_SIMD(f) __attribute__((target("avx2"))) \
+	static void mix_avx2_##f(struct mixer_voice *vi, \
+	int *buffer, int count, int vl, int vr, int step, int ramp, \
+	int delta_l, int delta_r)
+
+#include "mix_simd.h"
+
+#undef VEC
+#undef SIMD_LANES
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_SUB
+#undef V_MUL
+#undef V_SRAI
+#undef V_INDEX
+#undef V_MIX_STEREO
+#undef V_SINC
+#undef V_SINC_16BIT
+#undef MIXER_SIMD
+
+static const mixer_fn avx2_mixers[] = { SIMD_KERNELS(avx2) };
+
+#endif /* MIX_AVX2 */
+
+
+/*
+ * NEON, 4 lanes
+ */
+
+#ifdef MIX_NEON
+
+#include <arm_neon.h>
+
+static const int32 neon_index[4] = { 0, 1, 2, 3 };
+
+/* 8-tap FIR of samples scaled to 16 bits. Each half of the taps is summed
+ * separately and halved before adding, as in the scalar sinc mixers.
+ */
+static inline int32 sinc_neon(int16x8_t smp, const int16 *c)
+{
+	int16x8_t k = vld1q_s16((const int16_t *)c);
+	int32x4_t lo = vmull_s16(vget_low_s16(smp), vget_low_s16(k));
+	int32x4_t hi = vmull_s16(vget_high_s16(smp), vget_high_s16(k));
+	int32x2_t p = vpadd_s32(vpadd_s32(vget_low_s32(lo), vget_high_s32(lo)),
+				vpadd_s32(vget_low_s32(hi), vget_high_s32(hi)));
+
+	p = vshr_n_s32(p, 1);
+
+	return (vget_lane_s32(p, 0) + vget_lane_s32(p, 1)) >> 14;
+}
+
+#define VEC		int32x4_t
+#define SIMD_LANES	4
+#define V_LOAD(p)	vld1q_s32((const int32_t *)(p))
+#define V_STORE(p,v)	vst1q_s32((int32_t *)(p), (v))
+#define V_SET1(x)	vdupq_n_s32(x)
+#define V_ADD(a,b)	vaddq_s32(a, b)
+#define V_SUB(a,b)	vsubq_s32(a, b)
+#define V_MUL(a,b)	vmulq_s32(a, b)
+#define V_SRAI(a,n)	vshrq_n_s32(a, n)
+#define V_INDEX		V_LOAD(neon_index)
+
+#define V_MIX_STEREO(p,r,l) do { \
+    int32x4x2_t acc = vld2q_s32((const int32_t *)(p)); \
+    acc.val[0] = vaddq_s32(acc.val[0], r); \
+    acc.val[1] = vaddq_s32(acc.val[1], l); \
+    vst2q_s32((int32_t *)(p), acc); \
+} while (0)
+
+#define V_SINC(p,c)	sinc_neon(vshll_n_s8(vld1_s8((const int8_t *)(p)), 8), c)
+#define V_SINC_16BIT(p,c) sinc_neon(vld1q_s16((const int16_t *)(p)), c)
+
+#define MIXER_SIMD(f) static void mix_neon_##f(struct mixer_voice *vi, \
+	int *buffer, int count, int vl, int vr, int step, int ramp, \
+	int delta_l, int delta_r)
+
+#include "mix_simd.h"
+
+#undef VEC
+#undef SIMD_LANES
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_SUB
+#undef V_MUL
+#undef V_SRAI
+#undef V_INDEX
+#undef V_MIX_STEREO
+#undef V_SINC
+#undef V_SINC_16BIT
+#undef MIXER_SIMD
+
+static const mixer_fn neon_mixers[] = { SIMD_KERNELS(neon) };
+
+#endif /* MIX_NEON */
+
+
+static const mixer_fn *simd_select(void)
+{
+#ifdef MIX_AVX2
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return avx2_mixers;
+	}
+#endif
+#ifdef MIX_SSE2
+	return sse2_mixers;
+#elif defined(MIX_NEON)
+	return neon_mixers;
+#else
+	return NULL;
+#endif
+}
+
+/* Replace the unfiltered entries of the mixer tables with the SIMD
+ * kernels for the running CPU. The tables are indexed as in mixer.c,
+ * filtered mixers are kept as they are.
+ */
+void libxmp_mixer_simd_setup(mixer_fn *nearest, mixer_fn *linear, mixer_fn *spline, mixer_fn *sinc)
+{
+	const mixer_fn *m = simd_select();
+	int i;
+
+	if (m == NULL) {
+		return;
+	}
+
+	for (i = 0; i < 4; i++) {
+		nearest[i] = m[i];
+		linear[i] = m[4 + i];
+		spline[i] = m[8 + i];
+		sinc[i] = m[12 + i];
+#ifndef LIBXMP_CORE_DISABLE_IT
+		/* nearest neighbor mixers have no filtered version */
+		nearest[4 + i] = m[i];
+#endif
+	}
+}
@@ -0,0 +1,422 @@
+/* Vectorized mixer kernels
+ *
+ * This file has no include guard: it is included once for each instruction
+ * set by mix_simd.c, after the vector primitives below have been defined:
+ *
+ * VEC			vector of SIMD_LANES 32-bit signed integers
+ * V_LOAD(p)		load SIMD_LANES values from p (unaligned)
+ * V_STORE(p,v)		store SIMD_LANES values to p (unaligned)
+ * V_SET1(x)		broadcast x to all lanes
+ * V_ADD(a,b)		lane-wise a + b, wrapping
+ * V_SUB(a,b)		lane-wise a - b, wrapping
+ * V_MUL(a,b)		lane-wise a * b, low 32 bits
+ * V_SRAI(a,n)		lane-wise arithmetic shift right by constant n
+ * V_INDEX		vector with lane numbers 0, 1, ..., SIMD_LANES - 1
+ * V_MIX_STEREO(p,r,l)	interleave r and l and add them to p
+ * V_SINC(p,c)		8-tap FIR of the 8 bit samples at p with coefs at c
+ * V_SINC_16BIT(p,c)	8-tap FIR of the 16 bit samples at p with coefs at c
+ * MIXER_SIMD(f)	kernel function declarator
+ *
+ * Sample fetching and position updates are done exactly as in the scalar
+ * mixers, one lane at a time. Interpolation, volume scaling, ramping and
+ * accumulation are done on SIMD_LANES output samples at once. The sinc
+ * mixers instead compute the taps of each lane with a vector FIR. All
+ * integer operations have the same width and rounding as in mix_all.c, so
+ * the output is bit-identical to the scalar mixers.
+ */
+
+#define SPLINE_SHIFT	14
+
+#define SINC_WIDTH	8
+#define SINC_LEFT	3
+#define SINC_FRACSHIFT	6
+#define SINC_FRACHALF	(1 << (SINC_FRACSHIFT - 1))
+
+#define UPDATE_POS() do { \
+    frac += step; \
+    pos += frac >> SMIX_SHIFT; \
+    frac &= SMIX_MASK; \
+} while (0)
+
+#define VAR_SIMD(x) \
+    x *sptr = vi->sptr; \
+    unsigned int pos = VOICE_POS_INT(vi->pos); \
+    int frac = VOICE_POS_FRAC(vi->pos); \
+    int32 lane_a[SIMD_LANES], lane_l[SIMD_LANES]; \
+    VEC smp_in; \
+    int n, k
+
+#define VAR_SIMD_MONO(x) \
+    VAR_SIMD(x); \
+    VEC vec_vl = V_SET1(vl)
+
+#define VAR_SIMD_STEREO(x) \
+    VAR_SIMD_MONO(x); \
+    int32 lane_r[SIMD_LANES]; \
+    VEC vec_vr = V_SET1(vr)
+
+#define VAR_SIMD_LINEAR \
+    int32 lane_b[SIMD_LANES], lane_f[SIMD_LANES]
+
+#define VAR_SIMD_SPLINE \
+    int32 lane_b[SIMD_LANES], lane_c[SIMD_LANES], lane_d[SIMD_LANES]; \
+    int32 lane_f[SIMD_LANES], lane_g[SIMD_LANES]; \
+    int32 lane_h[SIMD_LANES], lane_i[SIMD_LANES]
+
+#define VAR_SIMD_SINC(x) \
+    x sinc_head[SINC_WIDTH]; \
+    const int16 *c; \
+    int t
+
+#define VAR_SIMD_MONO_AC \
+    int old_vl = vi->old_vl; \
+    VEC lane_idx = V_INDEX
+
+#define VAR_SIMD_STEREO_AC \
+    VAR_SIMD_MONO_AC; \
+    int old_vr = vi->old_vr
+
+/* Lane fetchers: read the input samples needed for output lane k */
+
+#define FETCH_NEAREST() do { \
+    lane_a[k] = (int16)sptr[pos] << 8; \
+} while (0)
+
+#define FETCH_NEAREST_16BIT() do { \
+    lane_a[k] = sptr[pos]; \
+} while (0)
+
+#define FETCH_LINEAR() do { \
+    lane_a[k] = (int16)sptr[pos] << 8; \
+    lane_b[k] = (int16)sptr[pos + 1] << 8; \
+    lane_f[k] = frac >> 1; \
+} while (0)
+
+#define FETCH_LINEAR_16BIT() do { \
+    lane_a[k] = sptr[pos]; \
+    lane_b[k] = sptr[pos + 1]; \
+    lane_f[k] = frac >> 1; \
+} while (0)
+
+#define FETCH_SPLINE() do { \
+    int f = frac >> 6; \
+    lane_a[k] = sptr[(int)pos - 1]; \
+    lane_b[k] = sptr[pos]; \
+    lane_c[k] = sptr[pos + 1]; \
+    lane_d[k] = sptr[pos + 2]; \
+    lane_f[k] = cubic_spline_lut0[f]; \
+    lane_g[k] = cubic_spline_lut1[f]; \
+    lane_h[k] = cubic_spline_lut2[f]; \
+    lane_i[k] = cubic_spline_lut3[f]; \
+} while (0)
+
+#define FETCH_SPLINE_16BIT FETCH_SPLINE
+
+/* Taps before the start of the sample read the first sample */
+#define SINC_HEAD() do { \
+    for (t = 0; t < SINC_WIDTH; t++) { \
+	int i = (int)pos - SINC_LEFT + t; \
+	sinc_head[t] = sptr[i < 0 ? 0 : i]; \
+    } \
+} while (0)
+
+#define FETCH_SINC_WITH(fir) do { \
+    c = windowed_fir_lut + \
+	((frac + SINC_FRACHALF) >> SINC_FRACSHIFT) * SINC_WIDTH; \
+    if (pos >= SINC_LEFT) { \
+	lane_a[k] = fir(sptr + pos - SINC_LEFT, c); \
+    } else { \
+	SINC_HEAD(); \
+	lane_a[k] = fir(sinc_head, c); \
+    } \
+} while (0)
+
+#define FETCH_SINC()		FETCH_SINC_WITH(V_SINC)
+#define FETCH_SINC_16BIT()	FETCH_SINC_WITH(V_SINC_16BIT)
+
+/* Unused lanes in the last block of a run are set to silence */
+
+#define CLEAR_NEAREST() do { \
+    lane_a[k] = 0; \
+} while (0)
+
+#define CLEAR_LINEAR() do { \
+    lane_a[k] = lane_b[k] = lane_f[k] = 0; \
+} while (0)
+
+#define CLEAR_SPLINE() do { \
+    lane_a[k] = lane_b[k] = lane_c[k] = lane_d[k] = 0; \
+    lane_f[k] = lane_g[k] = lane_h[k] = lane_i[k] = 0; \
+} while (0)
+
+/* Interpolators: compute smp_in for all lanes */
+
+#define INTERP_NEAREST() do { \
+    smp_in = V_LOAD(lane_a); \
+} while (0)
+
+#define INTERP_NEAREST_16BIT INTERP_NEAREST
+
+#define INTERP_SINC INTERP_NEAREST
+
+#define INTERP_LINEAR() do { \
+    VEC a = V_LOAD(lane_a); \
+    VEC dt = V_SUB(V_LOAD(lane_b), a); \
+    smp_in = V_ADD(a, V_SRAI(V_MUL(V_LOAD(lane_f), dt), SMIX_SHIFT - 1)); \
+} while (0)
+
+#define INTERP_LINEAR_16BIT INTERP_LINEAR
+
+#define INTERP_SPLINE_SUM() \
+    V_ADD(V_ADD(V_MUL(V_LOAD(lane_f), V_LOAD(lane_a)), \
+                V_MUL(V_LOAD(lane_g), V_LOAD(lane_b))), \
+          V_ADD(V_MUL(V_LOAD(lane_i), V_LOAD(lane_d)), \
+                V_MUL(V_LOAD(lane_h), V_LOAD(lane_c))))
+
+#define INTERP_SPLINE() do { \
+    smp_in = V_SRAI(INTERP_SPLINE_SUM(), SPLINE_SHIFT - 8); \
+} while (0)
+
+#define INTERP_SPLINE_16BIT() do { \
+    smp_in = V_SRAI(INTERP_SPLINE_SUM(), SPLINE_SHIFT); \
+} while (0)
+
+/* Volume ramps: per-lane volume for the anticlick section */
+
+#define RAMP(x, d) V_SRAI(V_ADD(V_SET1(x), V_MUL(V_SET1(d), lane_idx)), 8)
+
+#define RAMP_ADVANCE(v, d) do { \
+    v = (int)((uint32)v + (uint32)n * (uint32)d); \
+} while (0)
+
+/* Accumulators: add n lanes of smp_in * volume to the output buffer */
+
+#define ACCUM_MONO(v) do { \
+    VEC out = V_MUL(smp_in, (v)); \
+    if (n == SIMD_LANES) { \
+	V_STORE(buffer, V_ADD(V_LOAD(buffer), out)); \
+    } else { \
+	V_STORE(lane_l, out); \
+	for (k = 0; k < n; k++) { \
+	    buffer[k] += lane_l[k]; \
+	} \
+    } \
+    buffer += n; \
+} while (0)
+
+#define ACCUM_STEREO(r, l) do { \
+    VEC out_r = V_MUL(smp_in, (r)); \
+    VEC out_l = V_MUL(smp_in, (l)); \
+    if (n == SIMD_LANES) { \
+	V_MIX_STEREO(buffer, out_r, out_l); \
+    } else { \
+	V_STORE(lane_r, out_r); \
+	V_STORE(lane_l, out_l); \
+	for (k = 0; k < n; k++) { \
+	    buffer[2 * k] += lane_r[k]; \
+	    buffer[2 * k + 1] += lane_l[k]; \
+	} \
+    } \
+    buffer += 2 * n; \
+} while (0)
+
+#define MIX_MONO()		ACCUM_MONO(vec_vl)
+#define MIX_STEREO()		ACCUM_STEREO(vec_vr, vec_vl)
+#define MIX_MONO_AC() do { \
+    ACCUM_MONO(RAMP(old_vl, delta_l)); \
+    RAMP_ADVANCE(old_vl, delta_l); \
+} while (0)
+
+#define MIX_STEREO_AC() do { \
+    ACCUM_STEREO(RAMP(old_vr, delta_r), RAMP(old_vl, delta_l)); \
+    RAMP_ADVANCE(old_vr, delta_r); \
+    RAMP_ADVANCE(old_vl, delta_l); \
+} while (0)
+
+/* Process up to SIMD_LANES output samples */
+#define BLOCK(fetch, clear, interp, mix) do { \
+    for (k = 0; k < n; k++) { fetch(); UPDATE_POS(); } \
+    for (; k < SIMD_LANES; k++) { clear(); } \
+    interp(); \
+    mix(); \
+} while (0)
+
+#define LOOP_AC(fetch, clear, interp, mix) \
+    for (; count > ramp; count -= n) { \
+	n = count - ramp > SIMD_LANES ? SIMD_LANES : count - ramp; \
+	BLOCK(fetch, clear, interp, mix); \
+    }
+
+#define LOOP(fetch, clear, interp, mix) \
+    for (; count > 0; count -= n) { \
+	n = count > SIMD_LANES ? SIMD_LANES : count; \
+	BLOCK(fetch, clear, interp, mix); \
+    }
+
+
+/*
+ * Nearest neighbor mixers
+ */
+
+MIXER_SIMD(mono_8bit_nearest)
+{
+    VAR_SIMD_MONO(int8);
+
+    LOOP(FETCH_NEAREST, CLEAR_NEAREST, INTERP_NEAREST, MIX_MONO);
+}
+
+MIXER_SIMD(mono_16bit_nearest)
+{
+    VAR_SIMD_MONO(int16);
+
+    LOOP(FETCH_NEAREST_16BIT, CLEAR_NEAREST, INTERP_NEAREST_16BIT, MIX_MONO);
+}
+
+MIXER_SIMD(stereo_8bit_nearest)
+{
+    VAR_SIMD_STEREO(int8);
+
+    LOOP(FETCH_NEAREST, CLEAR_NEAREST, INTERP_NEAREST, MIX_STEREO);
+}
+
+MIXER_SIMD(stereo_16bit_nearest)
+{
+    VAR_SIMD_STEREO(int16);
+
+    LOOP(FETCH_NEAREST_16BIT, CLEAR_NEAREST, INTERP_NEAREST_16BIT, MIX_STEREO);
+}
+
+
+/*
+ * Linear mixers
+ */
+
+MIXER_SIMD(mono_8bit_linear)
+{
+    VAR_SIMD_MONO(int8);
+    VAR_SIMD_LINEAR;
+    VAR_SIMD_MONO_AC;
+
+    LOOP_AC(FETCH_LINEAR, CLEAR_LINEAR, INTERP_LINEAR, MIX_MONO_AC);
+    LOOP(FETCH_LINEAR, CLEAR_LINEAR, INTERP_LINEAR, MIX_MONO);
+}
+
+MIXER_SIMD(mono_16bit_linear)
+{
+    VAR_SIMD_MONO(int16);
+    VAR_SIMD_LINEAR;
+    VAR_SIMD_MONO_AC;
+
+    LOOP_AC(FETCH_LINEAR_16BIT, CLEAR_LINEAR, INTERP_LINEAR_16BIT, MIX_MONO_AC);
+    LOOP(FETCH_LINEAR_16BIT, CLEAR_LINEAR, INTERP_LINEAR_16BIT, MIX_MONO);
+}
+
+MIXER_SIMD(stereo_8bit_linear)
+{
+    VAR_SIMD_STEREO(int8);
+    VAR_SIMD_LINEAR;
+    VAR_SIMD_STEREO_AC;
+
+    LOOP_AC(FETCH_LINEAR, CLEAR_LINEAR, INTERP_LINEAR, MIX_STEREO_AC);
+    LOOP(FETCH_LINEAR, CLEAR_LINEAR, INTERP_LINEAR, MIX_STEREO);
+}
+
+MIXER_SIMD(stereo_16bit_linear)
+{
+    VAR_SIMD_STEREO(int16);
+    VAR_SIMD_LINEAR;
+    VAR_SIMD_STEREO_AC;
+
+    LOOP_AC(FETCH_LINEAR_16BIT, CLEAR_LINEAR, INTERP_LINEAR_16BIT, MIX_STEREO_AC);
+    LOOP(FETCH_LINEAR_16BIT, CLEAR_LINEAR, INTERP_LINEAR_16BIT, MIX_STEREO);
+}
+
+
+/*
+ * Spline mixers
+ */
+
+MIXER_SIMD(mono_8bit_spline)
+{
+    VAR_SIMD_MONO(int8);
+    VAR_SIMD_SPLINE;
+    VAR_SIMD_MONO_AC;
+
+    LOOP_AC(FETCH_SPLINE, CLEAR_SPLINE, INTERP_SPLINE, MIX_MONO_AC);
+    LOOP(FETCH_SPLINE, CLEAR_SPLINE, INTERP_SPLINE, MIX_MONO);
+}
+
+MIXER_SIMD(mono_16bit_spline)
+{
+    VAR_SIMD_MONO(int16);
+    VAR_SIMD_SPLINE;
+    VAR_SIMD_MONO_AC;
+
+    LOOP_AC(FETCH_SPLINE_16BIT, CLEAR_SPLINE, INTERP_SPLINE_16BIT, MIX_MONO_AC);
+    LOOP(FETCH_SPLINE_16BIT, CLEAR_SPLINE, INTERP_SPLINE_16BIT, MIX_MONO);
+}
+
+MIXER_SIMD(stereo_8bit_spline)
+{
+    VAR_SIMD_STEREO(int8);
+    VAR_SIMD_SPLINE;
+    VAR_SIMD_STEREO_AC;
+
+    LOOP_AC(FETCH_SPLINE, CLEAR_SPLINE, INTERP_SPLINE, MIX_STEREO_AC);
+    LOOP(FETCH_SPLINE, CLEAR_SPLINE, INTERP_SPLINE, MIX_STEREO);
+}
+
+MIXER_SIMD(stereo_16bit_spline)
+{
+    VAR_SIMD_STEREO(int16);
+    VAR_SIMD_SPLINE;
+    VAR_SIMD_STEREO_AC;
+
+    LOOP_AC(FETCH_SPLINE_16BIT, CLEAR_SPLINE, INTERP_SPLINE_16BIT, MIX_STEREO_AC);
+    LOOP(FETCH_SPLINE_16BIT, CLEAR_SPLINE, INTERP_SPLINE_16BIT, MIX_STEREO);
+}
+
+
+/*
+ * Sinc mixers
+ */
+
+MIXER_SIMD(mono_8bit_sinc)
+{
+    VAR_SIMD_MONO(int8);
+    VAR_SIMD_SINC(int8);
+    VAR_SIMD_MONO_AC;
+
+    LOOP_AC(FETCH_SINC, CLEAR_NEAREST, INTERP_SINC, MIX_MONO_AC);
+    LOOP(FETCH_SINC, CLEAR_NEAREST, INTERP_SINC, MIX_MONO);
+}
+
+MIXER_SIMD(mono_16bit_sinc)
+{
+    VAR_SIMD_MONO(int16);
+    VAR_SIMD_SINC(int16);
+    VAR_SIMD_MONO_AC;
+
+    LOOP_AC(FETCH_SINC_16BIT, CLEAR_NEAREST, INTERP_SINC, MIX_MONO_AC);
+    LOOP(FETCH_SINC_16BIT, CLEAR_NEAREST, INTERP_SINC, MIX_MONO);
+}
+
+MIXER_SIMD(stereo_8bit_sinc)
+{
+    VAR_SIMD_STEREO(int8);
+    VAR_SIMD_SINC(int8);
+    VAR_SIMD_STEREO_AC;
+
+    LOOP_AC(FETCH_SINC, CLEAR_NEAREST, INTERP_SINC, MIX_STEREO_AC);
+    LOOP(FETCH_SINC, CLEAR_NEAREST, INTERP_SINC, MIX_STEREO);
+}
+
+MIXER_SIMD(stereo_16bit_sinc)
+{
+    VAR_SIMD_STEREO(int16);
+    VAR_SIMD_SINC(int16);
+    VAR_SIMD_STEREO_AC;
+
+    LOOP_AC(FETCH_SINC_16BIT, CLEAR_NEAREST, INTERP_SINC, MIX_STEREO_AC);
+    LOOP(FETCH_SINC_16BIT, CLEAR_NEAREST, INTERP_SINC, MIX_STEREO);
+}
@@ -0,0 +1,244 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2018 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "mix_thread.h"
+
+/* Mixer thread pool
+ *
+ * The calling thread is worker 0 and mixes into the context buffer, the
+ * other workers mix into their own buffers. When all workers are done
+ * the buffers are added to the context buffer. Sums are done in integer
+ * arithmetic, so the result doesn't depend on how voices are split.
+ */
+
+#ifdef MIXER_THREADS
+
+#include <pthread.h>
+
+struct mixer_worker {
+	struct mixer_pool *pool;
+	pthread_t thread;
+	int index;
+	int32 *buf32;
+};
+
+struct mixer_pool {
+	struct context_data *ctx;
+	int num;			/* number of workers */
+	struct mixer_worker *worker;
+	pthread_mutex_t lock;
+	pthread_cond_t start;		/* new job available */
+	pthread_cond_t done;		/* all workers finished */
+	unsigned int job_id;		/* incremented for each job */
+	int busy;			/* workers still running the job */
+	int quit;
+	mixer_job job;
+	void *arg;
+	int size;			/* buffer samples used by the job */
+};
+
+static void *worker_main(void *data)
+{
+	struct mixer_worker *w = (struct mixer_worker *)data;
+	struct mixer_pool *pool = w->pool;
+	unsigned int job_id = 0;
+
+	for (;;) {
+		pthread_mutex_lock(&pool->lock);
+		while (pool->job_id == job_id && !pool->quit) {
+			pthread_cond_wait(&pool->start, &pool->lock);
+		}
+		if (pool->quit) {
+			pthread_mutex_unlock(&pool->lock);
+			break;
+		}
+		job_id = pool->job_id;
+		pthread_mutex_unlock(&pool->lock);
+
+		memset(w->buf32, 0, pool->size * sizeof(int32));
+		pool->job(pool->ctx, pool->arg, w->index, pool->num, w->buf32);
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->busy == 0) {
+			pthread_cond_signal(&pool->done);
+		}
+		pthread_mutex_unlock(&pool->lock);
+	}
+
+	return NULL;
+}
+
+struct mixer_pool *libxmp_mixer_pool_create(struct context_data *ctx, int num)
+{
+	struct mixer_pool *pool;
+	int i;
+
+	if (num < 2 || num > MIXER_MAX_THREADS) {
+		return NULL;
+	}
+
+	pool = calloc(1, sizeof(struct mixer_pool));
+	if (pool == NULL) {
+		goto err;
+	}
+
+	pool->worker = calloc(num, sizeof(struct mixer_worker));
+	if (pool->worker == NULL) {
+		goto err1;
+	}
+
+	for (i = 1; i < num; i++) {
+		pool->worker[i].buf32 = malloc(XMP_MAX_FRAMESIZE * sizeof(int32));
+		if (pool->worker[i].buf32 == NULL) {
+			goto err2;
+		}
+	}
+
+	if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+		goto err2;
+	}
+	if (pthread_cond_init(&pool->start, NULL) != 0) {
+		goto err3;
+	}
+	if (pthread_cond_init(&pool->done, NULL) != 0) {
+		goto err4;
+	}
+
+	pool->ctx = ctx;
+
+	/* Worker 0 is the calling thread */
+	for (pool->num = 1; pool->num < num; pool->num++) {
+		struct mixer_worker *w = &pool->worker[pool->num];
+
+		w->pool = pool;
+		w->index = pool->num;
+		if (pthread_create(&w->thread, NULL, worker_main, w) != 0) {
+			break;
+		}
+	}
+
+	if (pool->num < num) {
+		for (i = pool->num; i < num; i++) {
+			free(pool->worker[i].buf32);
+		}
+		libxmp_mixer_pool_destroy(pool);
+		return NULL;
+	}
+
+	return pool;
+
+    err4:
+	pthread_cond_destroy(&pool->start);
+    err3:
+	pthread_mutex_destroy(&pool->lock);
+    err2:
+	for (i = 1; i < num; i++) {
+		free(pool->worker[i].buf32);
+	}
+	free(pool->worker);
+    err1:
+	free(pool);
+    err:
+	return NULL;
+}
+
+void libxmp_mixer_pool_destroy(struct mixer_pool *pool)
+{
+	int i;
+
+	if (pool == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	pool->quit = 1;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (i = 1; i < pool->num; i++) {
+		pthread_join(pool->worker[i].thread, NULL);
+	}
+
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->start);
+	pthread_mutex_destroy(&pool->lock);
+
+	for (i = 1; i < pool->num; i++) {
+		free(pool->worker[i].buf32);
+	}
+	free(pool->worker);
+	free(pool);
+}
+
+/* Run job in all workers and add their output to buf32, which must hold
+ * size samples already cleared by the caller.
+ */
+void libxmp_mixer_pool_run(struct mixer_pool *pool, mixer_job job, void *arg,
+						int32 *buf32, int size)
+{
+	int i, j;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->job = job;
+	pool->arg = arg;
+	pool->size = size;
+	pool->busy = pool->num - 1;
+	pool->job_id++;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+
+	job(pool->ctx, arg, 0, pool->num, buf32);
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->busy > 0) {
+		pthread_cond_wait(&pool->done, &pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	for (i = 1; i < pool->num; i++) {
+		int32 *b = pool->worker[i].buf32;
+		for (j = 0; j < size; j++) {
+			buf32[j] += b[j];
+		}
+	}
+}
+
+#else
+
+struct mixer_pool *libxmp_mixer_pool_create(struct context_data *ctx, int num)
+{
+	return NULL;
+}
+
+void libxmp_mixer_pool_destroy(struct mixer_pool *pool)
+{
+}
+
+void libxmp_mixer_pool_run(struct mixer_pool *pool, mixer_job job, void *arg,
+						int32 *buf32, int size)
+{
+}
+
+#endif /* MIXER_THREADS */
@@ -0,0 +1,22 @@
+#ifndef LIBXMP_MIX_THREAD_H
+#define LIBXMP_MIX_THREAD_H
+
+#include "common.h"
+
+#if defined(HAVE_PTHREAD) && !defined(LIBXMP_NO_THREADS)
+#define MIXER_THREADS
+#endif
+
+#define MIXER_MAX_THREADS 16	/* maximum number of mixer threads */
+
+struct mixer_pool;
+
+/* Mix the share of worker index (of num workers) into buffer */
+typedef void (*mixer_job)(struct context_data *, void *, int, int, int32 *);
+
+struct mixer_pool *libxmp_mixer_pool_create	(struct context_data *, int);
+void	libxmp_mixer_pool_destroy	(struct mixer_pool *);
+void	libxmp_mixer_pool_run		(struct mixer_pool *, mixer_job, void *,
+					 int32 *, int);
+
+#endif
@@ -28,6 +28,10 @@
 #include "mixer.h"
 #include "period.h"
 #include "player.h"	/* for set_sample_end() */
+#include "mix_thread.h"
+#ifdef MIXER_THREADS
+#include <pthread.h>
+#endif
 
 #ifdef LIBXMP_PAULA_SIMULATOR
 #include "paula.h"
@@ -61,6 +65,10 @@ MIX_FN(mono_8bit_spline);
 MIX_FN(mono_16bit_spline);
 MIX_FN(stereo_8bit_spline);
 MIX_FN(stereo_16bit_spline);
+MIX_FN(mono_8bit_sinc);
+MIX_FN(mono_16bit_sinc);
+MIX_FN(stereo_8bit_sinc);
+MIX_FN(stereo_16bit_sinc);
 
 #ifndef LIBXMP_CORE_DISABLE_IT
 MIX_FN(mono_8bit_linear_filter);
@@ -71,13 +79,21 @@ MIX_FN(mono_8bit_spline_filter);
 MIX_FN(mono_16bit_spline_filter);
 MIX_FN(stereo_8bit_spline_filter);
 MIX_FN(stereo_16bit_spline_filter);
+MIX_FN(mono_8bit_sinc_filter);
+MIX_FN(mono_16bit_sinc_filter);
+MIX_FN(stereo_8bit_sinc_filter);
+MIX_FN(stereo_16bit_sinc_filter);
 #endif
 
 #ifdef LIBXMP_PAULA_SIMULATOR
-MIX_FN(mono_a500);
-MIX_FN(mono_a500_filter);
-MIX_FN(stereo_a500);
-MIX_FN(stereo_a500_filter);
+MIX_FN(mono_8bit_a500);
+MIX_FN(mono_16bit_a500);
+MIX_FN(stereo_8bit_a500);
+MIX_FN(stereo_16bit_a500);
+MIX_FN(mono_8bit_a500_filter);
+MIX_FN(mono_16bit_a500_filter);
+MIX_FN(stereo_8bit_a500_filter);
+MIX_FN(stereo_16bit_a500_filter);
 #endif
 
 /* Mixers array index:
@@ -87,7 +103,7 @@ MIX_FN(stereo_a500_filter);
  * bit 2: 0=unfiltered, 1=filtered
  */
 
-typedef void (*mixer_set[])(struct mixer_voice *, int32 *, int, int, int, int, int, int, int);
+typedef mixer_fn mixer_set[];
 
 static mixer_set nearest_mixers = {
 	libxmp_mix_mono_8bit_nearest,
@@ -131,28 +147,47 @@ static mixer_set spline_mixers = {
 #endif
 };
 
+static mixer_set sinc_mixers = {
+	libxmp_mix_mono_8bit_sinc,
+	libxmp_mix_mono_16bit_sinc,
+	libxmp_mix_stereo_8bit_sinc,
+	libxmp_mix_stereo_16bit_sinc,
+
+#ifndef LIBXMP_CORE_DISABLE_IT
+	libxmp_mix_mono_8bit_sinc_filter,
+	libxmp_mix_mono_16bit_sinc_filter,
+	libxmp_mix_stereo_8bit_sinc_filter,
+	libxmp_mix_stereo_16bit_sinc_filter
+#endif
+};
+
 #ifdef LIBXMP_PAULA_SIMULATOR
 static mixer_set a500_mixers = {
-	libxmp_mix_mono_a500,
-	NULL,
-	libxmp_mix_stereo_a500,
-	NULL,
-	NULL,
-	NULL,
-	NULL,
-	NULL
-};
+	libxmp_mix_mono_8bit_a500,
+	libxmp_mix_mono_16bit_a500,
+	libxmp_mix_stereo_8bit_a500,
+	libxmp_mix_stereo_16bit_a500,
 
+#ifndef LIBXMP_CORE_DISABLE_IT
+	libxmp_mix_mono_8bit_a500,
+	libxmp_mix_mono_16bit_a500,
+	libxmp_mix_stereo_8bit_a500,
+	libxmp_mix_stereo_16bit_a500
+#endif
+};
 
 static mixer_set a500led_mixers = {
-	libxmp_mix_mono_a500_filter,
-	NULL,
-	libxmp_mix_stereo_a500_filter,
-	NULL,
-	NULL,
-	NULL,
-	NULL,
-	NULL
+	libxmp_mix_mono_8bit_a500_filter,
+	libxmp_mix_mono_16bit_a500_filter,
+	libxmp_mix_stereo_8bit_a500_filter,
+	libxmp_mix_stereo_16bit_a500_filter,
+
+#ifndef LIBXMP_CORE_DISABLE_IT
+	libxmp_mix_mono_8bit_a500_filter,
+	libxmp_mix_mono_16bit_a500_filter,
+	libxmp_mix_stereo_8bit_a500_filter,
+	libxmp_mix_stereo_16bit_a500_filter
+#endif
 };
 #endif
 
@@ -198,6 +233,18 @@ static void downmix_int_16bit(int16 *dest, int32 *src, int num, int amp, int off
 	}
 }
 
+/* Downmix 32bit samples to float, mono or stereo output. Samples are not
+ * clipped, full scale 16-bit output maps to [-1.0, 1.0).
+ */
+static void downmix_float(float *dest, int32 *src, int num, int amp)
+{
+	float scale = 1.0f / (1L << (DOWNMIX_SHIFT - amp + 15));
+
+	for (; num--; src++, dest++) {
+		*dest = *src * scale;
+	}
+}
+
 static void anticlick(struct mixer_voice *vi)
 {
 	vi->flags |= ANTICLICK;
@@ -244,7 +291,52 @@ static void do_anticlick(struct context_data *ctx, int voc, int32 *buf, int coun
 	}
 }
 
-static void set_sample_end(struct context_data *ctx, int voc, int end)
+/* The channel map is shared by all voices, so voices mixed in several
+ * threads are only marked in reset and freed by apply_resets() when all
+ * threads are done.
+ */
+#define RESET_MUTE	1
+#define RESET_END	2
+
+static void reset_voice(struct context_data *ctx, int voc, int mute, char *reset)
+{
+	if (reset != NULL) {
+		reset[voc] = mute ? RESET_MUTE : RESET_END;
+	} else {
+		libxmp_virt_resetvoice(ctx, voc, mute);
+	}
+}
+
+static void apply_resets(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	int voc;
+
+	for (voc = 0; voc < p->virt.maxvoc; voc++) {
+		struct mixer_voice *vi = &p->virt.voice_array[voc];
+		int old_vl, old_vr;
+
+		switch (s->voice_reset[voc]) {
+		case RESET_MUTE:
+			libxmp_virt_resetvoice(ctx, voc, 1);
+			break;
+		case RESET_END:
+			/* the mixer sets the ramp volumes after the reset */
+			old_vl = vi->old_vl;
+			old_vr = vi->old_vr;
+			libxmp_virt_resetvoice(ctx, voc, 0);
+			vi->old_vl = old_vl;
+			vi->old_vr = old_vr;
+			break;
+		default:
+			continue;
+		}
+		s->voice_reset[voc] = 0;
+	}
+}
+
+static void set_sample_end(struct context_data *ctx, int voc, int end, char *reset)
 {
 	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
@@ -259,7 +351,7 @@ static void set_sample_end(struct context_data *ctx, int voc, int end)
 	if (end) {
 		SET_NOTE(NOTE_SAMPLE_END);
 		if (HAS_QUIRK(QUIRK_RSTCHN)) {
-			libxmp_virt_resetvoice(ctx, voc, 0);
+			reset_voice(ctx, voc, 0, reset);
 		}
 	} else {
 		RESET_NOTE(NOTE_SAMPLE_END);
@@ -279,6 +371,41 @@ static void adjust_voice_end(struct mixer_voice *vi, struct xmp_sample *xxs)
 	}
 }
 
+/* Voices carry 32 more fraction bits of the step and the position in
+ * step_lo and pos_lo, so that positions don't drift from the exact
+ * ones over long notes. The mixers only take the sample index and the
+ * 16-bit fraction from pos, and start from it in each span.
+ */
+
+/* Whole position after n steps, without the extra fraction bits */
+static int64 pos_after(struct mixer_voice *vi, int n, uint32 *lo)
+{
+	uint64 l = (uint64)vi->pos_lo + (uint64)vi->step_lo * n;
+
+	if (lo != NULL) {
+		*lo = (uint32)l;
+	}
+
+	return vi->pos + vi->step * n + (int64)(l >> 32);
+}
+
+static void advance_pos(struct mixer_voice *vi, int n)
+{
+	vi->pos = pos_after(vi, n, &vi->pos_lo);
+}
+
+/* At the end of a tick the next sample is skipped if it's past the loop
+ * end
+ */
+static int loop_end_skip(struct mixer_voice *vi)
+{
+	uint32 lo;
+	int64 next = pos_after(vi, 1, &lo);
+
+	return next > VOICE_POS(vi->end) ||
+		(next == VOICE_POS(vi->end) && lo != 0);
+}
+
 static void loop_reposition(struct context_data *ctx, struct mixer_voice *vi, struct xmp_sample *xxs)
 {
 #ifndef LIBXMP_CORE_DISABLE_IT
@@ -287,13 +414,13 @@ static void loop_reposition(struct context_data *ctx, struct mixer_voice *vi, st
 	int loop_size = xxs->lpe - xxs->lps;
 
 	/* Reposition for next loop */
-	vi->pos -= loop_size;		/* forward loop */
+	vi->pos -= VOICE_POS(loop_size);	/* forward loop */
 	vi->end = xxs->lpe;
 	vi->flags |= SAMPLE_LOOP;
 
 	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
 		vi->end += loop_size;	/* unrolled loop */
-		vi->pos -= loop_size;	/* forward loop */
+		vi->pos -= VOICE_POS(loop_size);	/* forward loop */
 
 #ifndef LIBXMP_CORE_DISABLE_IT
 		/* OpenMPT Bidi-Loops.it: "In Impulse Tracker’s software mixer,
@@ -301,7 +428,7 @@ static void loop_reposition(struct context_data *ctx, struct mixer_voice *vi, st
 		 */
 		if (IS_PLAYER_MODE_IT()) {
 			vi->end--;
-			vi->pos++;
+			vi->pos += VOICE_POS(1);
 		}
 #endif
 	}
@@ -324,273 +451,419 @@ void libxmp_mixer_prepare(struct context_data *ctx)
 	}
 	memset(s->buf32, 0, bytelen);
 }
-/* Fill the output buffer calling one of the handlers. The buffer contains
- * sound for one tick (a PAL frame or 1/50s for standard vblank-timed mods)
+
+/* Mix only the last of count samples into buf, where the mixer would put
+ * it. That's all the anticlick needs from a voice when the mixer is
+ * bypassed.
  */
-void libxmp_mixer_softmixer(struct context_data *ctx)
+static void mix_last_sample(struct mixer_voice *vi, mixer_fn mix_fn, int32 *buf, int count, int vl, int vr, int step, int ramp, int delta_l, int delta_r)
+{
+	struct mixer_voice v;
+	int n = count - 1;
+
+	memcpy(&v, vi, sizeof(struct mixer_voice));
+
+	/* The mixers step in 16.16 fixed point */
+	v.pos = ((vi->pos >> (VOICE_POS_SHIFT - SMIX_SHIFT)) + (int64)n * step)
+					<< (VOICE_POS_SHIFT - SMIX_SHIFT);
+
+	/* Samples before ramp in the run are volume ramped */
+	if (n < count - ramp) {
+		v.old_vl += n * delta_l;
+		v.old_vr += n * delta_r;
+		ramp = 0;
+	} else {
+		ramp = 1;
+	}
+
+	mix_fn(&v, buf, 1, vl, vr, step, ramp, delta_l, delta_r);
+}
+
+/* Mix one voice for the current tick into buf32. Voice resets are stored
+ * in reset instead of done here if it's not NULL, see reset_voice(). If
+ * bypass is set the voice is only advanced, see libxmp_mixer_softmixer().
+ */
+static void mix_voice(struct context_data *ctx, int voc, int32 *buf32, mixer_set *mixers, char *reset, int bypass)
 {
 	struct player_data *p = &ctx->p;
 	struct mixer_data *s = &ctx->s;
 	struct module_data *m = &ctx->m;
 	struct xmp_module *mod = &m->mod;
+	struct mixer_voice *vi = &p->virt.voice_array[voc];
 	struct xmp_sample *xxs;
-	struct mixer_voice *vi;
-	double step;
+	double fstep;
+	int64 step;
 	int samples, size;
-	int vol_l, vol_r, voc, usmp;
+	int vol_l, vol_r, usmp;
 	int prev_l, prev_r = 0;
 	int lps, lpe;
+	int c5spd, rampsize, delta_l, delta_r;
 	int32 *buf_pos;
 	void (*mix_fn)(struct mixer_voice *, int32 *, int, int, int, int, int, int, int);
-	mixer_set *mixers;
-
-	switch (s->interp) {
-	case XMP_INTERP_NEAREST:
-		mixers = &nearest_mixers;
-		break;
-	case XMP_INTERP_LINEAR:
-		mixers = &linear_mixers;
-		break;
-	case XMP_INTERP_SPLINE:
-		mixers = &spline_mixers;
-		break;
-	default:
-		mixers = &linear_mixers;
-	}
 
-#ifdef LIBXMP_PAULA_SIMULATOR
-	if (p->flags & XMP_FLAGS_A500) {
-		if (IS_AMIGA_MOD()) {
-			if (p->filter) {
-				mixers = &a500led_mixers;
-			} else {
-				mixers = &a500_mixers;
-			}
+	if (vi->flags & ANTICLICK) {
+		if (s->interp > XMP_INTERP_NEAREST) {
+			do_anticlick(ctx, voc, buf32, s->ticksize);
 		}
+		vi->flags &= ~ANTICLICK;
 	}
-#endif
-
-	libxmp_mixer_prepare(ctx);
-
-	for (voc = 0; voc < p->virt.maxvoc; voc++) {
-		int c5spd, rampsize, delta_l, delta_r;
-
-		vi = &p->virt.voice_array[voc];
 
-		if (vi->flags & ANTICLICK) {
-			if (s->interp > XMP_INTERP_NEAREST) {
-				do_anticlick(ctx, voc, NULL, 0);
-			}
-			vi->flags &= ~ANTICLICK;
-		}
+	if (vi->chn < 0) {
+		return;
+	}
 
-		if (vi->chn < 0) {
-			continue;
-		}
+	if (vi->period < 1) {
+		reset_voice(ctx, voc, 1, reset);
+		return;
+	}
 
-		if (vi->period < 1) {
-			libxmp_virt_resetvoice(ctx, voc, 1);
-			continue;
-		}
+	buf_pos = buf32;
+	if (vi->pan == PAN_SURROUND) {
+		vol_r = vi->vol * 0x80;
+		vol_l = -vi->vol * 0x80;
+	} else {
+		vol_r = vi->vol * (0x80 - vi->pan);
+		vol_l = vi->vol * (0x80 + vi->pan);
+	}
 
-		vi->pos0 = vi->pos;
+	if (vi->smp < mod->smp) {
+		xxs = &mod->xxs[vi->smp];
+		c5spd = m->xtra[vi->smp].c5spd;
+	} else {
+		xxs = &ctx->smix.xxs[vi->smp - mod->smp];
+		c5spd = m->c4rate;
+	}
 
-		buf_pos = s->buf32;
-		if (vi->pan == PAN_SURROUND) {
-			vol_r = vi->vol * 0x80;
-			vol_l = -vi->vol * 0x80;
-		} else {
-			vol_r = vi->vol * (0x80 - vi->pan);
-			vol_l = vi->vol * (0x80 + vi->pan);
-		}
+	vi->pos0 = VOICE_POS_INT(vi->pos);
 
-		if (vi->smp < mod->smp) {
-			xxs = &mod->xxs[vi->smp];
-			c5spd = m->xtra[vi->smp].c5spd;
+	/* The step is kept until the period, the sample rate or the output
+	 * rate changes.
+	 */
+	if (vi->period != vi->step_period || c5spd != vi->step_rate ||
+	    s->freq != vi->step_freq) {
+		fstep = C4_PERIOD * c5spd / s->freq / vi->period;
+		if (fstep < 0.001) {
+			vi->step = 0;
+			vi->step_lo = 0;
 		} else {
-			xxs = &ctx->smix.xxs[vi->smp - mod->smp];
-			c5spd = m->c4rate;
+			/* exact, the step has less than 64 fraction bits */
+			fstep *= VOICE_POS(1);
+			vi->step = (int64)fstep;
+			vi->step_lo = (uint32)((fstep - vi->step) * 4294967296.0);
 		}
+		vi->step_period = vi->period;
+		vi->step_rate = c5spd;
+		vi->step_freq = s->freq;
+	}
 
-		step = C4_PERIOD * c5spd / s->freq / vi->period;
-
-		if (step < 0.001) {	/* otherwise m5v-nwlf.it crashes */
-			continue;
-		}
+	step = vi->step;
+	if (step == 0) {	/* otherwise m5v-nwlf.it crashes */
+		return;
+	}
 
 #ifndef LIBXMP_CORE_DISABLE_IT
-		if (xxs->flg & XMP_SAMPLE_SLOOP && vi->smp < mod->smp) {
-			if (~vi->flags & VOICE_RELEASE) {
-				if (vi->pos < m->xsmp[vi->smp].lpe) {
-					xxs = &m->xsmp[vi->smp];
-				}
+	if (xxs->flg & XMP_SAMPLE_SLOOP && vi->smp < mod->smp) {
+		if (~vi->flags & VOICE_RELEASE) {
+			if (vi->pos < VOICE_POS(m->xsmp[vi->smp].lpe)) {
+				xxs = &m->xsmp[vi->smp];
 			}
 		}
+	}
 
-		adjust_voice_end(vi, xxs);
+	adjust_voice_end(vi, xxs);
 #endif
 
-		lps = xxs->lps;
-		lpe = xxs->lpe;
+	lps = xxs->lps;
+	lpe = xxs->lpe;
 
-		if (p->flags & XMP_FLAGS_FIXLOOP) {
-			lps >>= 1;
-		}
+	if (p->flags & XMP_FLAGS_FIXLOOP) {
+		lps >>= 1;
+	}
 
-		if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-			vi->end += lpe - lps;
+	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
+		vi->end += lpe - lps;
 
 #ifndef LIBXMP_CORE_DISABLE_IT
-			if (IS_PLAYER_MODE_IT()) {
-				vi->end--;
-			}
-#endif
+		if (IS_PLAYER_MODE_IT()) {
+			vi->end--;
 		}
+#endif
+	}
 
-		rampsize = s->ticksize >> ANTICLICK_SHIFT;
-		delta_l = (vol_l - vi->old_vl) / rampsize;
-		delta_r = (vol_r - vi->old_vr) / rampsize;
+	rampsize = s->ticksize >> ANTICLICK_SHIFT;
+	delta_l = (vol_l - vi->old_vl) / rampsize;
+	delta_r = (vol_r - vi->old_vr) / rampsize;
 
-		usmp = 0;
-		for (size = s->ticksize; size > 0; ) {
-			int split_noloop = 0;
+	usmp = 0;
+	for (size = s->ticksize; size > 0; ) {
+		int split_noloop = 0;
 
-			if (p->xc_data[vi->chn].split) {
-				split_noloop = 1;
-			}
+		if (p->xc_data[vi->chn].split) {
+			split_noloop = 1;
+		}
+
+		/* How many samples we can write before the loop break
+		 * or sample end... */
+		if (vi->pos >= VOICE_POS(vi->end)) {
+			samples = 0;
+			usmp = 1;
+		} else {
+			int64 end = VOICE_POS(vi->end);
 
-			/* How many samples we can write before the loop break
-			 * or sample end... */
-			if (vi->pos >= vi->end) {
-				samples = 0;
-				usmp = 1;
+			/* ...inside the tick boundaries */
+			if (pos_after(vi, size, NULL) < end) {
+				samples = size;
 			} else {
-				int s = ceil(((double)vi->end - vi->pos) / step);
-				/* ...inside the tick boundaries */
-				if (s > size) {
-					s = size;
+				/* at most a few steps past the exact count */
+				samples = (int)((end - vi->pos + step - 1) / step);
+				while (samples > 0 &&
+				       pos_after(vi, samples - 1, NULL) >= end) {
+					samples--;
 				}
+			}
 
-				samples = s;
-				if (samples > 0) {
-					usmp = 0;
-				}
+			if (samples > 0) {
+				usmp = 0;
 			}
+		}
 
-			if (vi->vol) {
-				int mix_size = samples;
-				int mixer = vi->fidx & FIDX_FLAGMASK;
+		if (vi->vol) {
+			int mix_size = samples;
+			int mixer = vi->fidx & FIDX_FLAGMASK;
 
-				if (~s->format & XMP_FORMAT_MONO) {
-					mix_size *= 2;
-				}
+			if (~s->format & XMP_FORMAT_MONO) {
+				mix_size *= 2;
+			}
 
-				/* For Hipolito's anticlick routine */
-				if (samples > 0) {
-					if (~s->format & XMP_FORMAT_MONO) {
-						prev_r = buf_pos[mix_size - 2];
-					}
-					prev_l = buf_pos[mix_size - 1];
-				} else {
-					prev_r = prev_l = 0;
+			/* For Hipolito's anticlick routine */
+			if (samples > 0) {
+				if (~s->format & XMP_FORMAT_MONO) {
+					prev_r = buf_pos[mix_size - 2];
 				}
+				prev_l = buf_pos[mix_size - 1];
+			} else {
+				prev_r = prev_l = 0;
+			}
 
 #ifndef LIBXMP_CORE_DISABLE_IT
-				/* See OpenMPT env-flt-max.it */
-				if (vi->filter.cutoff >= 0xfe &&
+			/* See OpenMPT env-flt-max.it */
+			if (vi->filter.cutoff >= 0xfe &&
                                     vi->filter.resonance == 0) {
-					mixer &= ~FLAG_FILTER;
-				}
+				mixer &= ~FLAG_FILTER;
+			}
 #endif
 
-				mix_fn = (*mixers)[mixer];
+			mix_fn = (*mixers)[mixer];
 
-				/* Call the output handler */
-				if (samples > 0 && vi->sptr != NULL) {
-					int rsize = 0;
+			/* Call the output handler */
+			if (samples > 0 && vi->sptr != NULL) {
+				int rsize = 0;
 
-					if (rampsize > samples) {
-						rampsize -= samples;
-					} else {
-						rsize = samples - rampsize;
-						rampsize = 0;
-					}
+				if (rampsize > samples) {
+					rampsize -= samples;
+				} else {
+					rsize = samples - rampsize;
+					rampsize = 0;
+				}
 
-					if (delta_l == 0 && delta_r == 0) {
-						/* no need to ramp */
-						rsize = samples;
-					}
+				if (delta_l == 0 && delta_r == 0) {
+					/* no need to ramp */
+					rsize = samples;
+				}
 
-					if (mix_fn != NULL) {
-						mix_fn(vi, buf_pos, samples,
-							vol_l >> 8, vol_r >> 8, step * (1 << SMIX_SHIFT), rsize, delta_l, delta_r);
-					}
+				if (mix_fn == NULL) {
+					/* nothing to mix */
+				} else if (bypass && (~mixer & FLAG_FILTER)) {
+					int32 *last = buf_pos + mix_size;
+					last -= s->format & XMP_FORMAT_MONO ? 1 : 2;
+					mix_last_sample(vi, mix_fn, last, samples,
+						vol_l >> 8, vol_r >> 8,
+						(int)(step >> (VOICE_POS_SHIFT - SMIX_SHIFT)),
+						rsize, delta_l, delta_r);
+				} else {
+					mix_fn(vi, buf_pos, samples,
+						vol_l >> 8, vol_r >> 8,
+						(int)(step >> (VOICE_POS_SHIFT - SMIX_SHIFT)),
+						rsize, delta_l, delta_r);
+				}
 
-					buf_pos += mix_size;
-					vi->old_vl += samples * delta_l;
-					vi->old_vr += samples * delta_r;
+				buf_pos += mix_size;
+				vi->old_vl += samples * delta_l;
+				vi->old_vr += samples * delta_r;
 
 
-					/* For Hipolito's anticlick routine */
-					if (~s->format & XMP_FORMAT_MONO) {
-						vi->sright = buf_pos[-2] - prev_r;
-					}
-					vi->sleft = buf_pos[-1] - prev_l;
+				/* For Hipolito's anticlick routine */
+				if (~s->format & XMP_FORMAT_MONO) {
+					vi->sright = buf_pos[-2] - prev_r;
 				}
+				vi->sleft = buf_pos[-1] - prev_l;
 			}
+		}
 
-			vi->pos += step * samples;
+		advance_pos(vi, samples);
 
-			/* No more samples in this tick */
-			size -= samples + usmp;
-			if (size <= 0) {
-				if (xxs->flg & XMP_SAMPLE_LOOP) {
-					if (vi->pos + step > vi->end) {
-						vi->pos += step;
+		/* No more samples in this tick */
+		size -= samples + usmp;
+		if (size <= 0) {
+			if (xxs->flg & XMP_SAMPLE_LOOP) {
+				if (loop_end_skip(vi)) {
+					advance_pos(vi, 1);
+					if (vi->pos >= VOICE_POS(vi->end)) {
 						loop_reposition(ctx, vi, xxs);
 					}
 				}
-				continue;
 			}
+			continue;
+		}
+
+		/* First sample loop run */
+		if ((~xxs->flg & XMP_SAMPLE_LOOP) || split_noloop) {
+			do_anticlick(ctx, voc, buf_pos, size);
+			set_sample_end(ctx, voc, 1, reset);
+			size = 0;
+			continue;
+		}
+
+		loop_reposition(ctx, vi, xxs);
+	}
+
+	vi->old_vl = vol_l;
+	vi->old_vr = vol_r;
+}
+
+struct mix_job {
+	mixer_set *mixers;
+	char *reset;
+};
+
+/* Mix every num-th voice starting at index, run by the mixer threads */
+static void mix_voices(struct context_data *ctx, void *arg, int index, int num, int32 *buf32)
+{
+	struct player_data *p = &ctx->p;
+	struct mix_job *job = (struct mix_job *)arg;
+	int voc;
+
+	for (voc = index; voc < p->virt.maxvoc; voc += num) {
+		mix_voice(ctx, voc, buf32, job->mixers, job->reset, 0);
+	}
+}
 
-			/* First sample loop run */
-			if ((~xxs->flg & XMP_SAMPLE_LOOP) || split_noloop) {
-				do_anticlick(ctx, voc, buf_pos, size);
-				set_sample_end(ctx, voc, 1);
-				size = 0;
-				continue;
+/* Fill the output buffer calling one of the handlers. The buffer contains
+ * sound for one tick (a PAL frame or 1/50s for standard vblank-timed mods)
+ *
+ * In bypass mode voices are advanced by whole runs of samples without
+ * mixing, so sample ends and loops happen exactly as when mixing. Only
+ * the last sample of each run is mixed, for the anticlick. Filtered voices
+ * and the Paula mixers keep state from every sample and are still mixed.
+ * The buffer is left silent.
+ */
+void libxmp_mixer_softmixer(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+#ifdef LIBXMP_PAULA_SIMULATOR
+	struct module_data *m = &ctx->m;
+#endif
+	int voc;
+	mixer_set *mixers;
+
+	switch (s->interp) {
+	case XMP_INTERP_NEAREST:
+		mixers = &nearest_mixers;
+		break;
+	case XMP_INTERP_LINEAR:
+		mixers = &linear_mixers;
+		break;
+	case XMP_INTERP_SPLINE:
+		mixers = &spline_mixers;
+		break;
+	case XMP_INTERP_SINC:
+		mixers = &sinc_mixers;
+		break;
+	default:
+		mixers = &linear_mixers;
+	}
+
+#ifdef LIBXMP_PAULA_SIMULATOR
+	if (p->flags & XMP_FLAGS_A500) {
+		if (IS_AMIGA_MOD()) {
+			if (p->filter) {
+				mixers = &a500led_mixers;
+			} else {
+				mixers = &a500_mixers;
 			}
+		}
+	}
+#endif
+
+	libxmp_mixer_prepare(ctx);
+
+	if (s->bypass) {
+		int bypass = 1;
+#ifdef LIBXMP_PAULA_SIMULATOR
+		bypass = mixers != &a500_mixers && mixers != &a500led_mixers;
+#endif
+		for (voc = 0; voc < p->virt.maxvoc; voc++) {
+			mix_voice(ctx, voc, s->buf32, mixers, NULL, bypass);
+		}
+		libxmp_mixer_prepare(ctx);
+	} else if (s->pool != NULL) {
+		struct mix_job job;
+		int size = s->ticksize;
 
-			loop_reposition(ctx, vi, xxs);
+		if (~s->format & XMP_FORMAT_MONO) {
+			size *= 2;
 		}
 
-		vi->old_vl = vol_l;
-		vi->old_vr = vol_r;
+		job.mixers = mixers;
+		job.reset = s->voice_reset;
+		libxmp_mixer_pool_run(s->pool, mix_voices, &job, s->buf32, size);
+		apply_resets(ctx);
+	} else {
+		for (voc = 0; voc < p->virt.maxvoc; voc++) {
+			mix_voice(ctx, voc, s->buf32, mixers, NULL, 0);
+		}
 	}
 
-	/* Render final frame */
+	s->dtright = s->dtleft = 0;
+}
+
+/* Render num frames of the current tick, starting at frame start, to the
+ * output format. dest doesn't need to be the context output buffer, this
+ * lets xmp_render() write straight to the user buffer.
+ */
+void libxmp_mixer_downmix(struct context_data *ctx, void *dest, int start, int num)
+{
+	struct mixer_data *s = &ctx->s;
+	int32 *src;
 
-	size = s->ticksize;
 	if (~s->format & XMP_FORMAT_MONO) {
-		size *= 2;
+		start *= 2;
+		num *= 2;
+	}
+
+	if (start + num > XMP_MAX_FRAMESIZE) {
+		num = XMP_MAX_FRAMESIZE - start;
 	}
 
-	if (size > XMP_MAX_FRAMESIZE) {
-		size = XMP_MAX_FRAMESIZE;
+	if (num <= 0) {
+		return;
 	}
 
-	if (s->format & XMP_FORMAT_8BIT) {
-		downmix_int_8bit(s->buffer, s->buf32, size, s->amplify,
+	src = s->buf32 + start;
+
+	if (s->format & XMP_FORMAT_FLOAT) {
+		downmix_float(dest, src, num, s->amplify);
+	} else if (s->format & XMP_FORMAT_8BIT) {
+		downmix_int_8bit(dest, src, num, s->amplify,
 				s->format & XMP_FORMAT_UNSIGNED ? 0x80 : 0);
 	} else {
-		downmix_int_16bit((int16 *)s->buffer, s->buf32, size,s->amplify,
+		downmix_int_16bit(dest, src, num, s->amplify,
 				s->format & XMP_FORMAT_UNSIGNED ? 0x8000 : 0);
 	}
-
-	s->dtright = s->dtleft = 0;
 }
 
-void libxmp_mixer_voicepos(struct context_data *ctx, int voc, double pos, int ac)
+void libxmp_mixer_voicepos(struct context_data *ctx, int voc, int64 pos, int ac)
 {
 	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
@@ -609,14 +882,15 @@ void libxmp_mixer_voicepos(struct context_data *ctx, int voc, double pos, int ac
 	}
 
 	vi->pos = pos;
+	vi->pos_lo = 0;
 
 	adjust_voice_end(vi, xxs);
 
-	if (vi->pos >= vi->end) {
+	if (vi->pos >= VOICE_POS(vi->end)) {
 		if (xxs->flg & XMP_SAMPLE_LOOP) {
-			vi->pos = xxs->lps;
+			vi->pos = VOICE_POS(xxs->lps);
 		} else {
-			vi->pos = xxs->len;
+			vi->pos = VOICE_POS(xxs->len);
 		}
 	}
 
@@ -640,7 +914,7 @@ void libxmp_mixer_voicepos(struct context_data *ctx, int voc, double pos, int ac
 	}
 }
 
-double libxmp_mixer_getvoicepos(struct context_data *ctx, int voc)
+int64 libxmp_mixer_getvoicepos(struct context_data *ctx, int voc)
 {
 	struct player_data *p = &ctx->p;
 	struct mixer_voice *vi = &p->virt.voice_array[voc];
@@ -653,24 +927,38 @@ double libxmp_mixer_getvoicepos(struct context_data *ctx, int voc)
 	}
 
 	if (xxs->flg & XMP_SAMPLE_LOOP_BIDIR) {
-		if (vi->pos >= xxs->lpe) {
-			return xxs->lpe - (vi->pos - xxs->lpe) - 1;
+		if (vi->pos >= VOICE_POS(xxs->lpe)) {
+			return VOICE_POS(2 * xxs->lpe - 1) - vi->pos;
 		}
 	}
 
 	return vi->pos;
 }
 
+/* Sample data played by this player, which may have a private copy */
+static void *sample_data(struct context_data *ctx, int smp, struct xmp_sample *xxs)
+{
+#ifndef LIBXMP_CORE_PLAYER
+	struct player_data *p = &ctx->p;
+
+	if (p->invloop_data != NULL && smp < ctx->m.mod.smp &&
+	    p->invloop_data[smp] != NULL) {
+		return p->invloop_data[smp];
+	}
+#endif
+
+	return xxs->data;
+}
+
 void libxmp_mixer_setpatch(struct context_data *ctx, int voc, int smp, int ac)
 {
 	struct player_data *p = &ctx->p;
-#ifndef LIBXMP_CORE_DISABLE_IT
 	struct module_data *m = &ctx->m;
-#endif
 	struct mixer_data *s = &ctx->s;
 	struct mixer_voice *vi = &p->virt.voice_array[voc];
 	struct xmp_sample *xxs;
 
+	libxmp_lazy_load(m, smp);
 	xxs = libxmp_get_sample(ctx, smp);
 
 	vi->smp = smp;
@@ -684,11 +972,11 @@ void libxmp_mixer_setpatch(struct context_data *ctx, int voc, int smp, int ac)
 		vi->fidx |= FLAG_STEREO;
 	}
 
-	set_sample_end(ctx, voc, 0);
+	set_sample_end(ctx, voc, 0, NULL);
 
 	/*mixer_setvol(ctx, voc, 0);*/
 
-	vi->sptr = xxs->data;
+	vi->sptr = sample_data(ctx, smp, xxs);
 	vi->fidx |= FLAG_ACTIVE;
 
 #ifndef LIBXMP_CORE_DISABLE_IT
@@ -704,6 +992,46 @@ void libxmp_mixer_setpatch(struct context_data *ctx, int voc, int smp, int ac)
 	libxmp_mixer_voicepos(ctx, voc, 0, ac);
 }
 
+/* Copy a voice for a saved player state. The sample pointer belongs to
+ * this player and is not saved.
+ */
+void libxmp_mixer_savevoice(struct context_data *ctx, int voc, struct mixer_voice *dest)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_voice *vi = &p->virt.voice_array[voc];
+
+	memcpy(dest, vi, sizeof(struct mixer_voice));
+	dest->sptr = NULL;
+}
+
+/* Point a voice restored from a saved state to the sample data of this
+ * player, loading the sample first as in libxmp_mixer_setpatch().
+ */
+void libxmp_mixer_restorevoice(struct context_data *ctx, int voc)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct mixer_voice *vi = &p->virt.voice_array[voc];
+	struct xmp_sample *xxs;
+
+	vi->sptr = NULL;
+
+	if (vi->chn < 0) {
+		return;
+	}
+
+	libxmp_lazy_load(m, vi->smp);
+	xxs = libxmp_get_sample(ctx, vi->smp);
+
+	/* Sound effect samples differ from the saved player */
+	if (xxs == NULL) {
+		libxmp_virt_resetvoice(ctx, voc, 1);
+		return;
+	}
+
+	vi->sptr = sample_data(ctx, vi->smp, xxs);
+}
+
 void libxmp_mixer_setnote(struct context_data *ctx, int voc, int note)
 {
 	struct player_data *p = &ctx->p;
@@ -799,11 +1127,42 @@ int libxmp_mixer_numvoices(struct context_data *ctx, int num)
 	}
 }
 
+/* Select the fastest mixers available on this CPU. The mixer tables are
+ * shared by all contexts, so they're set up only once, even if players
+ * are started in several threads at the same time.
+ */
+static void select_mixers(void)
+{
+	libxmp_mixer_simd_setup(nearest_mixers, linear_mixers,
+				spline_mixers, sinc_mixers);
+}
+
+#ifdef MIXER_THREADS
+static pthread_once_t mixers_once = PTHREAD_ONCE_INIT;
+#endif
+
+static void setup_mixers(void)
+{
+#ifdef MIXER_THREADS
+	pthread_once(&mixers_once, select_mixers);
+#else
+	static int done = 0;
+
+	if (!done) {
+		select_mixers();
+		done = 1;
+	}
+#endif
+}
+
 int libxmp_mixer_on(struct context_data *ctx, int rate, int format, int c4rate)
 {
 	struct mixer_data *s = &ctx->s;
 
-	s->buffer = calloc(2, XMP_MAX_FRAMESIZE);
+	setup_mixers();
+
+	s->buffer = calloc(format & XMP_FORMAT_FLOAT ? sizeof(float) : 2,
+						XMP_MAX_FRAMESIZE);
 	if (s->buffer == NULL)
 		goto err;
 
@@ -811,6 +1170,21 @@ int libxmp_mixer_on(struct context_data *ctx, int rate, int format, int c4rate)
 	if (s->buf32 == NULL)
 		goto err1;
 
+	/* Mix in a single thread if threads can't be started */
+	s->pool = NULL;
+	s->voice_reset = NULL;
+	if (s->numthreads > 1) {
+		s->voice_reset = calloc(1, s->numvoc);
+		if (s->voice_reset != NULL) {
+			s->pool = libxmp_mixer_pool_create(ctx, s->numthreads);
+		}
+		if (s->pool == NULL) {
+			free(s->voice_reset);
+			s->voice_reset = NULL;
+		}
+	}
+
+	s->filter = NULL;
 	s->freq = rate;
 	s->format = format;
 	s->amplify = DEFAULT_AMPLIFY;
@@ -833,8 +1207,15 @@ void libxmp_mixer_off(struct context_data *ctx)
 {
 	struct mixer_data *s = &ctx->s;
 
+	libxmp_mixer_pool_destroy(s->pool);
+#ifndef LIBXMP_CORE_DISABLE_IT
+	libxmp_filter_free(s);
+#endif
+	free(s->voice_reset);
 	free(s->buffer);
 	free(s->buf32);
+	s->pool = NULL;
+	s->voice_reset = NULL;
 	s->buf32 = NULL;
 	s->buffer = NULL;
 }
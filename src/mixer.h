@@ -8,6 +8,12 @@
 #define SMIX_MASK	0xffff
 
 #define FILTER_SHIFT	16
+
+/* Voice positions and steps are 32.32 fixed point */
+#define VOICE_POS_SHIFT	32
+#define VOICE_POS(x)	((int64)(x) << VOICE_POS_SHIFT)
+#define VOICE_POS_INT(x) ((int)((x) >> VOICE_POS_SHIFT))
+#define VOICE_POS_FRAC(x) ((int)((x) >> (VOICE_POS_SHIFT - SMIX_SHIFT)) & SMIX_MASK)
 #define ANTICLICK_SHIFT	3
 
 #ifdef LIBXMP_PAULA_SIMULATOR
@@ -17,6 +23,10 @@
 #define MIXER(f) void libxmp_mix_##f(struct mixer_voice *vi, int *buffer, \
 	int count, int vl, int vr, int step, int ramp, int delta_l, int delta_r)
 
+struct mixer_voice;
+
+typedef void (*mixer_fn)(struct mixer_voice *, int32 *, int, int, int, int, int, int, int);
+
 struct mixer_voice {
 	int chn;		/* channel number */
 	int root;		/* */
@@ -25,7 +35,13 @@ struct mixer_voice {
 	int pan;		/* */
 	int vol;		/* */
 	double period;		/* current period */
-	double pos;		/* position in sample */
+	double step_period;	/* period of the cached step */
+	int step_rate;		/* sample rate of the cached step */
+	int step_freq;		/* output rate of the cached step */
+	int64 step;		/* cached step, 32.32 fixed point */
+	uint32 step_lo;		/* 32 more fraction bits of the step */
+	int64 pos;		/* position in sample, 32.32 fixed point */
+	uint32 pos_lo;		/* 32 more fraction bits of the position */
 	int pos0;		/* position in sample before mixing */
 	int fidx;		/* mixer function index */
 	int ins;		/* instrument number */
@@ -67,12 +83,20 @@ void    libxmp_mixer_seteffect	(struct context_data *, int, int, int);
 void    libxmp_mixer_setpan	(struct context_data *, int, int);
 int	libxmp_mixer_numvoices	(struct context_data *, int);
 void	libxmp_mixer_softmixer	(struct context_data *);
+void	libxmp_mixer_downmix	(struct context_data *, void *, int, int);
 void	libxmp_mixer_reset	(struct context_data *);
 void	libxmp_mixer_setpatch	(struct context_data *, int, int, int);
-void	libxmp_mixer_voicepos	(struct context_data *, int, double, int);
-double	libxmp_mixer_getvoicepos(struct context_data *, int);
+void	libxmp_mixer_savevoice	(struct context_data *, int, struct mixer_voice *);
+void	libxmp_mixer_restorevoice(struct context_data *, int);
+void	libxmp_mixer_voicepos	(struct context_data *, int, int64, int);
+int64	libxmp_mixer_getvoicepos(struct context_data *, int);
 void	libxmp_mixer_setnote	(struct context_data *, int, int);
 void	libxmp_mixer_setperiod	(struct context_data *, int, double);
 void	libxmp_mixer_release	(struct context_data *, int, int);
+void	libxmp_mixer_simd_setup	(mixer_fn *, mixer_fn *, mixer_fn *, mixer_fn *);
+
+#ifndef LIBXMP_CORE_DISABLE_IT
+void	libxmp_filter_free	(struct mixer_data *);
+#endif
 
 #endif /* LIBXMP_MIXER_H */
@@ -8,24 +8,22 @@
 #define BLEP_SIZE 2048
 #define MAX_BLEPS (BLEP_SIZE / MINIMUM_INTERVAL)
 
-/* the structure that holds data of bleps */
-struct blep_state {
-	int16 level;
-	int16 age;
-};
-
 struct paula_state {
 	/* the instantenous value of Paula output */
 	int16 global_output_level;
 
-	/* count of simultaneous bleps to keep track of */
-	unsigned int active_bleps;
+	/* Paula clock, wraps around; blep ages are differences of clocks */
+	uint32 clock;
 
-	/* place to keep our bleps in. MAX_BLEPS should be
-	 * defined as a BLEP_SIZE / MINIMUM_EVENT_INTERVAL.
-	 * For Paula, minimum event interval could be even 1, but it makes
-	 * sense to limit it to some higher value such as 16. */
-	struct blep_state blepstate[MAX_BLEPS];
+	/* Active bleps are kept in a ring, oldest first, from first to
+	 * first + active_bleps. Each entry is also stored MAX_BLEPS entries
+	 * later, so the active bleps can always be read as one contiguous
+	 * run. Inputs are at least MINIMUM_INTERVAL clocks apart, so
+	 * MAX_BLEPS is enough to hold every blep younger than BLEP_SIZE. */
+	unsigned int first;
+	unsigned int active_bleps;
+	int32 level[MAX_BLEPS * 2];	/* level difference of each blep */
+	uint32 birth[MAX_BLEPS * 2];	/* clock when each blep started */
 
 	double remainder;
 	double fdiv;
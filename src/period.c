@@ -27,6 +27,7 @@
 #include <string.h>
 #include "common.h"
 #include "period.h"
+#include "precomp_period.h"
 
 #include <math.h>
 
@@ -146,6 +147,23 @@ static inline double libxmp_round(double val)
 #define libxmp_round round
 #endif
 
+/* Amiga period for a note offset in 1/12800 semitones, that is
+ * PERIOD_BASE / pow(2, x / 153600) using the precomputed tables.
+ */
+static double amiga_period(int x)
+{
+	int oct = x / 153600;
+	int r = x % 153600;
+
+	if (r < 0) {
+		r += 153600;
+		oct--;
+	}
+
+	return ldexp(PERIOD_BASE * pow2_coarse[r / 100] * pow2_fine[r % 100],
+									-oct);
+}
+
 #ifdef LIBXMP_PAULA_SIMULATOR
 /* Get period from note using Protracker tuning */
 static inline int libxmp_note_to_period_pt(int n, int f)
@@ -171,7 +189,7 @@ static inline int libxmp_note_to_period_pt(int n, int f)
 /* Get period from note */
 double libxmp_note_to_period(struct context_data *ctx, int n, int f, double adj)
 {
-	double d, per;
+	double per;
 	struct module_data *m = &ctx->m;
 #ifdef LIBXMP_PAULA_SIMULATOR
 	struct player_data *p = &ctx->p;
@@ -184,17 +202,15 @@ double libxmp_note_to_period(struct context_data *ctx, int n, int f, double adj)
 	}
 #endif
 
-	d = (double)n + (double)f / 128;
-
 	switch (m->period_type) {
 	case PERIOD_LINEAR:
-		per = (240.0 - d) * 16;			/* Linear */
+		per = (240.0 - ((double)n + (double)f / 128)) * 16;	/* Linear */
 		break;
 	case PERIOD_CSPD:
-		per = 8363.0 * pow(2, n / 12) / 32 + f;	/* Hz */
+		per = ldexp(8363.0, n / 12) / 32 + f;	/* Hz */
 		break;
 	default:
-		per = PERIOD_BASE / pow(2, d / 12);	/* Amiga */
+		per = amiga_period((n * 128 + f) * 100);	/* Amiga */
 	}
 
 #ifndef LIBXMP_CORE_PLAYER
@@ -209,8 +225,7 @@ double libxmp_note_to_period(struct context_data *ctx, int n, int f, double adj)
 /* For the software mixer */
 double libxmp_note_to_period_mix(int n, int b)
 {
-	double d = (double)n + (double)b / 12800;
-	return PERIOD_BASE / pow(2, d / 12);
+	return amiga_period(n * 12800 + b);
 }
 
 /* Get note from period */
@@ -44,6 +44,7 @@
 #include "effects.h"
 #include "player.h"
 #include "mixer.h"
+#include "state.h"
 #ifndef LIBXMP_CORE_PLAYER
 #include "extras.h"
 #endif
@@ -270,8 +271,98 @@ static const int invloop_table[] = {
 	0, 5, 6, 7, 8, 10, 11, 13, 16, 19, 22, 26, 32, 43, 64, 128
 };
 
-static void update_invloop(struct module_data *m, struct channel_data *xc)
+static int has_invloop(struct module_data *m)
 {
+	struct xmp_module *mod = &m->mod;
+	struct xmp_event *e;
+	int i, j;
+
+	for (i = 0; i < mod->trk; i++) {
+		if (mod->xxt[i] == NULL) {
+			continue;
+		}
+		for (j = 0; j < mod->xxt[i]->rows; j++) {
+			e = &mod->xxt[i]->event[j];
+			if ((e->fxt == FX_EXTENDED && MSN(e->fxp) == EX_INVLOOP) ||
+			    (e->f2t == FX_EXTENDED && MSN(e->f2p) == EX_INVLOOP)) {
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* The module data may be shared with other players, so each player
+ * changes a private copy of the looped 8-bit samples. The copies are
+ * made when the player starts if the module uses the effect, and are
+ * part of the player state.
+ */
+static int init_invloop(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	struct xmp_sample *xxs;
+	unsigned char *data;
+	int i;
+
+	p->invloop_data = NULL;
+
+	if (!HAS_QUIRK(QUIRK_PROTRACK) || mod->smp <= 0 || !has_invloop(m)) {
+		return 0;
+	}
+
+	p->invloop_data = calloc(mod->smp, sizeof(unsigned char *));
+	if (p->invloop_data == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < mod->smp; i++) {
+		xxs = &mod->xxs[i];
+		if (~xxs->flg & XMP_SAMPLE_LOOP || xxs->flg & XMP_SAMPLE_16BIT) {
+			continue;
+		}
+
+		libxmp_lazy_load(m, i);
+		if (xxs->data == NULL) {
+			continue;
+		}
+
+		/* with the guard bytes around the sample */
+		data = malloc(xxs->len + 8);
+		if (data == NULL) {
+			return -1;
+		}
+		memcpy(data, xxs->data - 4, xxs->len + 8);
+		p->invloop_data[i] = data + 4;
+	}
+
+	return 0;
+}
+
+static void free_invloop(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	int i;
+
+	if (p->invloop_data == NULL) {
+		return;
+	}
+
+	for (i = 0; i < ctx->m.mod.smp; i++) {
+		if (p->invloop_data[i] != NULL) {
+			free(p->invloop_data[i] - 4);
+		}
+	}
+	free(p->invloop_data);
+	p->invloop_data = NULL;
+}
+
+static void update_invloop(struct context_data *ctx, struct channel_data *xc)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
 	struct xmp_sample *xxs = &m->mod.xxs[xc->smp];
 	int len;
 
@@ -285,8 +376,9 @@ static void update_invloop(struct module_data *m, struct channel_data *xc)
 			xc->invloop.pos = 0;
 		}
 
-		if (~xxs->flg & XMP_SAMPLE_16BIT) {
-			xxs->data[xxs->lps + xc->invloop.pos] ^= 0xff;
+		if (p->invloop_data != NULL &&
+		    p->invloop_data[xc->smp] != NULL) {
+			p->invloop_data[xc->smp][xxs->lps + xc->invloop.pos] ^= 0xff;
 		}
 	}
 }
@@ -958,7 +1050,7 @@ static void process_frequency(struct context_data *ctx, int chn, int act)
 		cutoff = 0xff;
 	} else if (cutoff < 0xff) {
 		int a0, b0, b1;
-		libxmp_filter_setup(s->freq, cutoff, resonance, &a0, &b0, &b1);
+		libxmp_filter_setup(s, cutoff, resonance, &a0, &b0, &b1);
 		libxmp_virt_seteffect(ctx, chn, DSP_EFFECT_FILTER_A0, a0);
 		libxmp_virt_seteffect(ctx, chn, DSP_EFFECT_FILTER_B0, b0);
 		libxmp_virt_seteffect(ctx, chn, DSP_EFFECT_FILTER_B1, b1);
@@ -1303,7 +1395,7 @@ static void play_channel(struct context_data *ctx, int chn)
 
 #ifndef LIBXMP_CORE_PLAYER
 	if (HAS_QUIRK(QUIRK_PROTRACK) && xc->ins < mod->ins) {
-		update_invloop(m, xc);
+		update_invloop(ctx, xc);
 	}
 #endif
 
@@ -1347,6 +1439,8 @@ static void next_order(struct context_data *ctx)
 	struct xmp_module *mod = &m->mod;
 	int mark;
 
+	libxmp_scan_wait(ctx);
+
 	do {
     		p->ord++;
 
@@ -1499,6 +1593,7 @@ int xmp_start_player(xmp_context opaque, int rate, int format)
 	p->frame = -1;
 	p->row = 0;
 	p->current_time = 0;
+	p->play_time = 0;
 	p->loop_count = 0;
 	p->sequence = 0;
 
@@ -1560,6 +1655,7 @@ int xmp_start_player(xmp_context opaque, int rate, int format)
 
 	/* Reset our buffer pointers */
 	xmp_play_buffer(opaque, NULL, 0, 0);
+	xmp_render(opaque, NULL, 0, 0);
 
 #ifndef LIBXMP_CORE_PLAYER
 	for (i = 0; i < p->virt.virt_channels; i++) {
@@ -1567,9 +1663,17 @@ int xmp_start_player(xmp_context opaque, int rate, int format)
 		if (libxmp_new_channel_extras(ctx, xc) < 0)
 			goto err2;
 	}
+
+	if (init_invloop(ctx) < 0) {
+		free_invloop(ctx);
+		ret = -XMP_ERROR_SYSTEM;
+		goto err2;
+	}
 #endif
 	reset_channels(ctx);
 
+	libxmp_snapshot_init(ctx);
+
 	ctx->state = XMP_STATE_PLAYING;
 
 	return 0;
@@ -1589,11 +1693,17 @@ static void check_end_of_module(struct context_data *ctx)
 	struct player_data *p = &ctx->p;
 	struct flow_control *f = &p->flow;
 
+	/* The end point is known when the deferred scan is done */
+	if (ctx->m.scan_job != NULL && libxmp_scan_visit(ctx) == 0) {
+		return;
+	}
+
 	/* check end of module */
 	if (p->ord == p->scan[p->sequence].ord &&
 			p->row == p->scan[p->sequence].row) {
 		if (f->end_point == 0) {
 			p->loop_count++;
+			p->snapshot.record = 0;
 			f->end_point = p->scan[p->sequence].num;
 			/* return -1; */
 		}
@@ -1601,9 +1711,9 @@ static void check_end_of_module(struct context_data *ctx)
 	}
 }
 
-int xmp_play_frame(xmp_context opaque)
+/* Play one tick, leaving the mixed samples in the 32-bit mixer buffer */
+int libxmp_play_frame(struct context_data *ctx)
 {
-	struct context_data *ctx = (struct context_data *)opaque;
 	struct player_data *p = &ctx->p;
 	struct module_data *m = &ctx->m;
 	struct xmp_module *mod = &m->mod;
@@ -1621,9 +1731,15 @@ int xmp_play_frame(xmp_context opaque)
 		return -XMP_END;
 	}
 
+	libxmp_scan_poll(ctx);
+	libxmp_snapshot_save(ctx);
+
 	/* check reposition */
 	if (p->ord != p->pos) {
-		int start = m->seq_data[p->sequence].entry_point;
+		int start;
+
+		libxmp_scan_wait(ctx);
+		start = m->seq_data[p->sequence].entry_point;
 
 		if (p->pos == -2) {		/* set by xmp_module_stop */
 			return -XMP_END;	/* that's all folks */
@@ -1708,12 +1824,27 @@ int xmp_play_frame(xmp_context opaque)
 
 	p->frame_time = m->time_factor * m->rrate / p->bpm;
 	p->current_time += p->frame_time;
+	p->play_time += p->frame_time;
 
 	libxmp_mixer_softmixer(ctx);
 
 	return 0;
 }
 
+int xmp_play_frame(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct mixer_data *s = &ctx->s;
+	int ret;
+
+	ret = libxmp_play_frame(ctx);
+	if (ret == 0 && !s->bypass) {
+		libxmp_mixer_downmix(ctx, s->buffer, 0, s->ticksize);
+	}
+
+	return ret;
+}
+
 int xmp_play_buffer(xmp_context opaque, void *out_buffer, int size, int loop)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -1770,7 +1901,67 @@ int xmp_play_buffer(xmp_context opaque, void *out_buffer, int size, int loop)
 
 	return ret;
 }
-    
+
+int xmp_render(xmp_context opaque, void *out_buffer, int frames, int loop)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	int framesize, filled = 0, num;
+
+	/* Reset internal state
+	 * Syncs buffer start with frame start */
+	if (out_buffer == NULL) {
+		p->loop_count = 0;
+		p->render_data.consumed = 0;
+		p->render_data.in_size = 0;
+		return 0;
+	}
+
+	if (ctx->state < XMP_STATE_PLAYING)
+		return -XMP_ERROR_STATE;
+
+	framesize = s->format & XMP_FORMAT_MONO ? 1 : 2;
+	if (s->format & XMP_FORMAT_FLOAT) {
+		framesize *= sizeof(float);
+	} else if (~s->format & XMP_FORMAT_8BIT) {
+		framesize *= 2;
+	}
+
+	while (filled < frames) {
+		/* Mix the next tick if the current one was used up */
+		if (p->render_data.consumed == p->render_data.in_size) {
+			p->render_data.consumed = 0;
+			p->render_data.in_size = 0;
+
+			if (libxmp_play_frame(ctx) < 0) {
+				break;
+			}
+
+			/* Check end of module */
+			if (loop > 0 && p->loop_count >= loop) {
+				break;
+			}
+
+			num = XMP_MAX_FRAMESIZE;
+			if (~s->format & XMP_FORMAT_MONO) {
+				num /= 2;
+			}
+			p->render_data.in_size = MIN(s->ticksize, num);
+		}
+
+		/* Downmix straight to the user buffer */
+		num = MIN(frames - filled, p->render_data.in_size -
+					p->render_data.consumed);
+		libxmp_mixer_downmix(ctx, (char *)out_buffer + filled * framesize,
+					p->render_data.consumed, num);
+		p->render_data.consumed += num;
+		filled += num;
+	}
+
+	return filled;
+}
+
 void xmp_end_player(xmp_context opaque)
 {
 	struct context_data *ctx = (struct context_data *)opaque;
@@ -1786,12 +1977,16 @@ void xmp_end_player(xmp_context opaque)
 
 	ctx->state = XMP_STATE_LOADED;
 
+	libxmp_snapshot_free(ctx);
+
 #ifndef LIBXMP_CORE_PLAYER
 	/* Free channel extras */
 	for (i = 0; i < p->virt.virt_channels; i++) {
 		xc = &p->xc_data[i];
 		libxmp_release_channel_extras(ctx, xc);
 	}
+
+	free_invloop(ctx);
 #endif
 
 	libxmp_virt_off(ctx);
@@ -1814,6 +2009,8 @@ void xmp_get_module_info(xmp_context opaque, struct xmp_module_info *info)
 	if (ctx->state < XMP_STATE_LOADED)
 		return;
 
+	libxmp_scan_wait(ctx);
+
 	memcpy(info->md5, m->md5, 16);
 	info->mod = mod;
 	info->comment = m->comment;
@@ -1864,7 +2061,9 @@ void xmp_get_frame_info(xmp_context opaque, struct xmp_frame_info *info)
 	if (~s->format & XMP_FORMAT_MONO) {
 		info->buffer_size *= 2;
 	}
-	if (~s->format & XMP_FORMAT_8BIT) {
+	if (s->format & XMP_FORMAT_FLOAT) {
+		info->buffer_size *= sizeof(float);
+	} else if (~s->format & XMP_FORMAT_8BIT) {
 		info->buffer_size *= 2;
 	}
 
@@ -252,7 +252,8 @@ struct channel_data {
 
 void	libxmp_process_fx	(struct context_data *, struct channel_data *,
 				 int, struct xmp_event *, int);
-void	libxmp_filter_setup	(int, int, int, int*, int*, int *);
+void	libxmp_filter_setup	(struct mixer_data *, int, int, int *, int *, int *);
 int	libxmp_read_event	(struct context_data *, struct xmp_event *, int);
+int	libxmp_play_frame	(struct context_data *);
 
 #endif /* LIBXMP_PLAYER_H */
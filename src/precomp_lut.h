@@ -522,3 +522,1031 @@ static int16 cubic_spline_lut3[1024] = {
 	 -63, -55, -47, -40, -32, -24, -16, -8,
 };
 
+static int16 windowed_fir_lut[8200] = {
+	 55, -727, 2306, 29549, 2306, -727, 55, -48,
+	 54, -723, 2282, 29549, 2329, -731, 55, -48,
+	 54, -718, 2259, 29549, 2353, -735, 55, -48,
+	 54, -714, 2236, 29548, 2376, -740, 56, -48,
+	 53, -710, 2213, 29548, 2400, -744, 56, -48,
+	 53, -706, 2189, 29547, 2423, -748, 56, -47,
+	 53, -702, 2166, 29547, 2447, -752, 57, -47,
+	 52, -697, 2143, 29546, 2471, -757, 57, -47,
+	 52, -693, 2120, 29545, 2494, -761, 58, -47,
+	 52, -689, 2097, 29544, 2518, -765, 58, -47,
+	 51, -685, 2074, 29543, 2542, -770, 58, -47,
+	 51, -681, 2052, 29542, 2566, -774, 59, -47,
+	 50, -677, 2029, 29541, 2590, -778, 59, -46,
+	 50, -672, 2006, 29540, 2614, -783, 59, -46,
+	 50, -668, 1983, 29538, 2638, -787, 60, -46,
+	 49, -664, 1961, 29537, 2662, -791, 60, -46,
+	 49, -660, 1938, 29535, 2687, -796, 60, -46,
+	 49, -656, 1916, 29533, 2711, -800, 61, -46,
+	 48, -652, 1893, 29532, 2735, -804, 61, -46,
+	 48, -648, 1871, 29530, 2760, -809, 62, -45,
+	 48, -644, 1848, 29528, 2784, -813, 62, -45,
+	 47, -640, 1826, 29526, 2808, -818, 62, -45,
+	 47, -635, 1804, 29524, 2833, -822, 63, -45,
+	 47, -631, 1782, 29521, 2858, -826, 63, -45,
+	 47, -627, 1760, 29519, 2882, -831, 64, -45,
+	 46, -623, 1738, 29517, 2907, -835, 64, -44,
+	 46, -619, 1716, 29514, 2932, -840, 64, -44,
+	 46, -615, 1694, 29511, 2956, -844, 65, -44,
+	 45, -611, 1672, 29509, 2981, -849, 65, -44,
+	 45, -607, 1650, 29506, 3006, -853, 65, -44,
+	 45, -603, 1628, 29503, 3031, -858, 66, -44,
+	 44, -599, 1606, 29500, 3056, -862, 66, -44,
+	 44, -595, 1585, 29497, 3081, -867, 67, -43,
+	 44, -591, 1563, 29494, 3106, -871, 67, -43,
+	 43, -587, 1541, 29490, 3131, -876, 67, -43,
+	 43, -583, 1520, 29487, 3157, -880, 68, -43,
+	 43, -579, 1498, 29484, 3182, -885, 68, -43,
+	 42, -576, 1477, 29480, 3207, -889, 69, -43,
+	 42, -572, 1456, 29476, 3232, -894, 69, -42,
+	 42, -568, 1434, 29473, 3258, -898, 69, -42,
+	 42, -564, 1413, 29469, 3283, -903, 70, -42,
+	 41, -560, 1392, 29465, 3309, -907, 70, -42,
+	 41, -556, 1371, 29461, 3334, -912, 71, -42,
+	 41, -552, 1350, 29457, 3360, -916, 71, -42,
+	 40, -548, 1329, 29452, 3386, -921, 71, -42,
+	 40, -544, 1308, 29448, 3411, -925, 72, -41,
+	 40, -541, 1287, 29444, 3437, -930, 72, -41,
+	 39, -537, 1266, 29439, 3463, -935, 73, -41,
+	 39, -533, 1245, 29435, 3489, -939, 73, -41,
+	 39, -529, 1224, 29430, 3515, -944, 74, -41,
+	 39, -525, 1204, 29425, 3541, -948, 74, -41,
+	 38, -521, 1183, 29420, 3567, -953, 74, -40,
+	 38, -518, 1163, 29415, 3593, -958, 75, -40,
+	 38, -514, 1142, 29410, 3619, -962, 75, -40,
+	 37, -510, 1122, 29405, 3645, -967, 76, -40,
+	 37, -506, 1101, 29400, 3671, -971, 76, -40,
+	 37, -502, 1081, 29395, 3698, -976, 76, -40,
+	 37, -499, 1061, 29389, 3724, -981, 77, -40,
+	 36, -495, 1040, 29384, 3750, -985, 77, -39,
+	 36, -491, 1020, 29378, 3777, -990, 78, -39,
+	 36, -488, 1000, 29372, 3803, -995, 78, -39,
+	 35, -484, 980, 29367, 3830, -999, 79, -39,
+	 35, -480, 960, 29361, 3856, -1004, 79, -39,
+	 35, -476, 940, 29355, 3883, -1009, 79, -39,
+	 35, -473, 920, 29349, 3910, -1014, 80, -38,
+	 34, -469, 900, 29342, 3936, -1018, 80, -38,
+	 34, -465, 880, 29336, 3963, -1023, 81, -38,
+	 34, -462, 861, 29330, 3990, -1028, 81, -38,
+	 34, -458, 841, 29323, 4017, -1032, 82, -38,
+	 33, -454, 821, 29317, 4044, -1037, 82, -38,
+	 33, -451, 802, 29310, 4071, -1042, 82, -38,
+	 33, -447, 782, 29303, 4098, -1047, 83, -37,
+	 32, -444, 763, 29297, 4125, -1051, 83, -37,
+	 32, -440, 743, 29290, 4152, -1056, 84, -37,
+	 32, -436, 724, 29283, 4179, -1061, 84, -37,
+	 32, -433, 705, 29276, 4206, -1066, 85, -37,
+	 31, -429, 686, 29268, 4234, -1070, 85, -37,
+	 31, -426, 666, 29261, 4261, -1075, 86, -36,
+	 31, -422, 647, 29254, 4288, -1080, 86, -36,
+	 31, -419, 628, 29246, 4316, -1085, 86, -36,
+	 30, -415, 609, 29239, 4343, -1089, 87, -36,
+	 30, -411, 590, 29231, 4371, -1094, 87, -36,
+	 30, -408, 571, 29223, 4398, -1099, 88, -36,
+	 30, -404, 552, 29216, 4426, -1104, 88, -35,
+	 29, -401, 534, 29208, 4453, -1109, 89, -35,
+	 29, -397, 515, 29200, 4481, -1113, 89, -35,
+	 29, -394, 496, 29192, 4509, -1118, 90, -35,
+	 29, -391, 478, 29183, 4537, -1123, 90, -35,
+	 28, -387, 459, 29175, 4564, -1128, 91, -35,
+	 28, -384, 441, 29167, 4592, -1133, 91, -35,
+	 28, -380, 422, 29158, 4620, -1138, 91, -34,
+	 28, -377, 404, 29150, 4648, -1142, 92, -34,
+	 27, -373, 385, 29141, 4676, -1147, 92, -34,
+	 27, -370, 367, 29132, 4704, -1152, 93, -34,
+	 27, -366, 349, 29124, 4732, -1157, 93, -34,
+	 27, -363, 331, 29115, 4761, -1162, 94, -34,
+	 27, -360, 313, 29106, 4789, -1167, 94, -33,
+	 26, -356, 295, 29096, 4817, -1172, 95, -33,
+	 26, -353, 277, 29087, 4845, -1176, 95, -33,
+	 26, -350, 259, 29078, 4874, -1181, 96, -33,
+	 26, -346, 241, 29069, 4902, -1186, 96, -33,
+	 25, -343, 223, 29059, 4931, -1191, 97, -33,
+	 25, -340, 205, 29050, 4959, -1196, 97, -33,
+	 25, -336, 187, 29040, 4988, -1201, 97, -32,
+	 25, -333, 170, 29030, 5016, -1206, 98, -32,
+	 24, -330, 152, 29020, 5045, -1211, 98, -32,
+	 24, -326, 135, 29010, 5074, -1216, 99, -32,
+	 24, -323, 117, 29000, 5102, -1221, 99, -32,
+	 24, -320, 100, 28990, 5131, -1225, 100, -32,
+	 24, -317, 82, 28980, 5160, -1230, 100, -31,
+	 23, -313, 65, 28970, 5189, -1235, 101, -31,
+	 23, -310, 48, 28960, 5218, -1240, 101, -31,
+	 23, -307, 30, 28949, 5247, -1245, 102, -31,
+	 23, -304, 13, 28939, 5276, -1250, 102, -31,
+	 23, -300, -4, 28928, 5305, -1255, 103, -31,
+	 22, -297, -21, 28917, 5334, -1260, 103, -31,
+	 22, -294, -38, 28906, 5363, -1265, 104, -30,
+	 22, -291, -55, 28896, 5392, -1270, 104, -30,
+	 22, -288, -72, 28885, 5421, -1275, 105, -30,
+	 21, -285, -88, 28873, 5451, -1280, 105, -30,
+	 21, -281, -105, 28862, 5480, -1285, 106, -30,
+	 21, -278, -122, 28851, 5509, -1290, 106, -30,
+	 21, -275, -139, 28840, 5539, -1295, 107, -29,
+	 21, -272, -155, 28828, 5568, -1300, 107, -29,
+	 20, -269, -172, 28817, 5598, -1305, 108, -29,
+	 20, -266, -188, 28805, 5627, -1310, 108, -29,
+	 20, -263, -205, 28793, 5657, -1315, 109, -29,
+	 20, -260, -221, 28782, 5686, -1320, 109, -29,
+	 20, -257, -237, 28770, 5716, -1325, 110, -29,
+	 19, -254, -254, 28758, 5746, -1330, 110, -28,
+	 19, -250, -270, 28746, 5776, -1335, 111, -28,
+	 19, -247, -286, 28734, 5805, -1340, 111, -28,
+	 19, -244, -302, 28721, 5835, -1345, 112, -28,
+	 19, -241, -318, 28709, 5865, -1350, 112, -28,
+	 19, -238, -334, 28697, 5895, -1355, 113, -28,
+	 18, -235, -350, 28684, 5925, -1360, 113, -28,
+	 18, -232, -366, 28672, 5955, -1365, 114, -27,
+	 18, -229, -382, 28659, 5985, -1370, 114, -27,
+	 18, -226, -398, 28646, 6015, -1375, 115, -27,
+	 18, -223, -413, 28633, 6045, -1380, 115, -27,
+	 17, -220, -429, 28620, 6076, -1385, 116, -27,
+	 17, -218, -444, 28607, 6106, -1390, 116, -27,
+	 17, -215, -460, 28594, 6136, -1395, 117, -26,
+	 17, -212, -476, 28581, 6166, -1400, 117, -26,
+	 17, -209, -491, 28568, 6197, -1405, 118, -26,
+	 17, -206, -506, 28554, 6227, -1410, 118, -26,
+	 16, -203, -522, 28541, 6258, -1415, 119, -26,
+	 16, -200, -537, 28527, 6288, -1420, 119, -26,
+	 16, -197, -552, 28514, 6319, -1425, 120, -26,
+	 16, -194, -567, 28500, 6349, -1430, 120, -25,
+	 16, -191, -582, 28486, 6380, -1435, 121, -25,
+	 16, -189, -597, 28472, 6410, -1440, 121, -25,
+	 15, -186, -612, 28458, 6441, -1445, 122, -25,
+	 15, -183, -627, 28444, 6472, -1451, 122, -25,
+	 15, -180, -642, 28430, 6503, -1456, 123, -25,
+	 15, -177, -657, 28416, 6533, -1461, 123, -25,
+	 15, -175, -672, 28402, 6564, -1466, 124, -24,
+	 15, -172, -687, 28387, 6595, -1471, 124, -24,
+	 14, -169, -701, 28373, 6626, -1476, 125, -24,
+	 14, -166, -716, 28358, 6657, -1481, 125, -24,
+	 14, -163, -730, 28344, 6688, -1486, 126, -24,
+	 14, -161, -745, 28329, 6719, -1491, 126, -24,
+	 14, -158, -759, 28314, 6750, -1496, 127, -24,
+	 14, -155, -774, 28299, 6781, -1501, 127, -23,
+	 13, -153, -788, 28284, 6813, -1506, 128, -23,
+	 13, -150, -802, 28269, 6844, -1511, 128, -23,
+	 13, -147, -816, 28254, 6875, -1517, 129, -23,
+	 13, -144, -831, 28239, 6906, -1522, 130, -23,
+	 13, -142, -845, 28223, 6938, -1527, 130, -23,
+	 13, -139, -859, 28208, 6969, -1532, 131, -23,
+	 13, -136, -873, 28192, 7001, -1537, 131, -22,
+	 12, -134, -887, 28177, 7032, -1542, 132, -22,
+	 12, -131, -901, 28161, 7063, -1547, 132, -22,
+	 12, -129, -914, 28145, 7095, -1552, 133, -22,
+	 12, -126, -928, 28130, 7127, -1557, 133, -22,
+	 12, -123, -942, 28114, 7158, -1562, 134, -22,
+	 12, -121, -956, 28098, 7190, -1567, 134, -22,
+	 12, -118, -969, 28082, 7221, -1573, 135, -21,
+	 11, -116, -983, 28065, 7253, -1578, 135, -21,
+	 11, -113, -996, 28049, 7285, -1583, 136, -21,
+	 11, -110, -1010, 28033, 7317, -1588, 136, -21,
+	 11, -108, -1023, 28016, 7349, -1593, 137, -21,
+	 11, -105, -1036, 28000, 7380, -1598, 137, -21,
+	 11, -103, -1050, 27983, 7412, -1603, 138, -21,
+	 11, -100, -1063, 27967, 7444, -1608, 138, -21,
+	 10, -98, -1076, 27950, 7476, -1613, 139, -20,
+	 10, -95, -1089, 27933, 7508, -1618, 140, -20,
+	 10, -93, -1102, 27916, 7540, -1624, 140, -20,
+	 10, -90, -1115, 27899, 7572, -1629, 141, -20,
+	 10, -88, -1128, 27882, 7605, -1634, 141, -20,
+	 10, -85, -1141, 27865, 7637, -1639, 142, -20,
+	 10, -83, -1154, 27848, 7669, -1644, 142, -20,
+	 10, -81, -1167, 27830, 7701, -1649, 143, -19,
+	 9, -78, -1180, 27813, 7733, -1654, 143, -19,
+	 9, -76, -1192, 27795, 7766, -1659, 144, -19,
+	 9, -73, -1205, 27778, 7798, -1664, 144, -19,
+	 9, -71, -1218, 27760, 7830, -1669, 145, -19,
+	 9, -68, -1230, 27743, 7863, -1674, 145, -19,
+	 9, -66, -1243, 27725, 7895, -1680, 146, -19,
+	 9, -64, -1255, 27707, 7928, -1685, 147, -19,
+	 9, -61, -1267, 27689, 7960, -1690, 147, -18,
+	 8, -59, -1280, 27671, 7993, -1695, 148, -18,
+	 8, -57, -1292, 27653, 8025, -1700, 148, -18,
+	 8, -54, -1304, 27634, 8058, -1705, 149, -18,
+	 8, -52, -1316, 27616, 8091, -1710, 149, -18,
+	 8, -50, -1328, 27598, 8123, -1715, 150, -18,
+	 8, -47, -1340, 27579, 8156, -1720, 150, -18,
+	 8, -45, -1352, 27561, 8189, -1725, 151, -18,
+	 8, -43, -1364, 27542, 8222, -1730, 151, -17,
+	 8, -40, -1376, 27523, 8255, -1736, 152, -17,
+	 7, -38, -1388, 27505, 8287, -1741, 152, -17,
+	 7, -36, -1400, 27486, 8320, -1746, 153, -17,
+	 7, -34, -1412, 27467, 8353, -1751, 154, -17,
+	 7, -31, -1423, 27448, 8386, -1756, 154, -17,
+	 7, -29, -1435, 27429, 8419, -1761, 155, -17,
+	 7, -27, -1446, 27410, 8452, -1766, 155, -17,
+	 7, -25, -1458, 27390, 8485, -1771, 156, -16,
+	 7, -23, -1469, 27371, 8518, -1776, 156, -16,
+	 7, -20, -1481, 27352, 8552, -1781, 157, -16,
+	 7, -18, -1492, 27332, 8585, -1786, 157, -16,
+	 6, -16, -1503, 27313, 8618, -1791, 158, -16,
+	 6, -14, -1515, 27293, 8651, -1796, 158, -16,
+	 6, -12, -1526, 27273, 8684, -1801, 159, -16,
+	 6, -10, -1537, 27254, 8718, -1807, 159, -16,
+	 6, -8, -1548, 27234, 8751, -1812, 160, -15,
+	 6, -5, -1559, 27214, 8784, -1817, 161, -15,
+	 6, -3, -1570, 27194, 8818, -1822, 161, -15,
+	 6, -1, -1581, 27174, 8851, -1827, 162, -15,
+	 6, 1, -1592, 27153, 8885, -1832, 162, -15,
+	 6, 3, -1603, 27133, 8918, -1837, 163, -15,
+	 6, 5, -1614, 27113, 8952, -1842, 163, -15,
+	 5, 7, -1624, 27092, 8985, -1847, 164, -15,
+	 5, 9, -1635, 27072, 9019, -1852, 164, -15,
+	 5, 11, -1646, 27051, 9052, -1857, 165, -14,
+	 5, 13, -1656, 27031, 9086, -1862, 165, -14,
+	 5, 15, -1667, 27010, 9119, -1867, 166, -14,
+	 5, 17, -1677, 26989, 9153, -1872, 167, -14,
+	 5, 19, -1688, 26968, 9187, -1877, 167, -14,
+	 5, 21, -1698, 26948, 9221, -1882, 168, -14,
+	 5, 23, -1708, 26926, 9254, -1887, 168, -14,
+	 5, 25, -1719, 26905, 9288, -1892, 169, -14,
+	 5, 27, -1729, 26884, 9322, -1897, 169, -13,
+	 4, 29, -1739, 26863, 9356, -1902, 170, -13,
+	 4, 31, -1749, 26842, 9390, -1907, 170, -13,
+	 4, 33, -1759, 26820, 9424, -1912, 171, -13,
+	 4, 35, -1769, 26799, 9458, -1917, 171, -13,
+	 4, 37, -1779, 26777, 9492, -1922, 172, -13,
+	 4, 39, -1789, 26756, 9526, -1927, 173, -13,
+	 4, 41, -1799, 26734, 9560, -1932, 173, -13,
+	 4, 43, -1809, 26712, 9594, -1937, 174, -13,
+	 4, 45, -1818, 26690, 9628, -1942, 174, -13,
+	 4, 46, -1828, 26669, 9662, -1947, 175, -12,
+	 4, 48, -1838, 26647, 9696, -1952, 175, -12,
+	 4, 50, -1847, 26625, 9730, -1957, 176, -12,
+	 4, 52, -1857, 26602, 9764, -1962, 176, -12,
+	 4, 54, -1866, 26580, 9799, -1967, 177, -12,
+	 3, 56, -1876, 26558, 9833, -1972, 177, -12,
+	 3, 58, -1885, 26536, 9867, -1977, 178, -12,
+	 3, 59, -1895, 26513, 9901, -1982, 178, -12,
+	 3, 61, -1904, 26491, 9936, -1986, 179, -12,
+	 3, 63, -1913, 26468, 9970, -1991, 180, -11,
+	 3, 65, -1922, 26445, 10004, -1996, 180, -11,
+	 3, 67, -1931, 26423, 10039, -2001, 181, -11,
+	 3, 68, -1940, 26400, 10073, -2006, 181, -11,
+	 3, 70, -1949, 26377, 10108, -2011, 182, -11,
+	 3, 72, -1958, 26354, 10142, -2016, 182, -11,
+	 3, 74, -1967, 26331, 10177, -2021, 183, -11,
+	 3, 75, -1976, 26308, 10211, -2026, 183, -11,
+	 3, 77, -1985, 26285, 10246, -2031, 184, -11,
+	 3, 79, -1994, 26262, 10280, -2035, 184, -11,
+	 3, 80, -2003, 26239, 10315, -2040, 185, -10,
+	 3, 82, -2011, 26215, 10350, -2045, 185, -10,
+	 2, 84, -2020, 26192, 10384, -2050, 186, -10,
+	 2, 85, -2029, 26168, 10419, -2055, 187, -10,
+	 2, 87, -2037, 26145, 10454, -2060, 187, -10,
+	 2, 89, -2046, 26121, 10488, -2065, 188, -10,
+	 2, 90, -2054, 26097, 10523, -2069, 188, -10,
+	 2, 92, -2062, 26074, 10558, -2074, 189, -10,
+	 2, 94, -2071, 26050, 10593, -2079, 189, -10,
+	 2, 95, -2079, 26026, 10627, -2084, 190, -10,
+	 2, 97, -2087, 26002, 10662, -2089, 190, -9,
+	 2, 99, -2096, 25978, 10697, -2093, 191, -9,
+	 2, 100, -2104, 25954, 10732, -2098, 191, -9,
+	 2, 102, -2112, 25930, 10767, -2103, 192, -9,
+	 2, 103, -2120, 25905, 10802, -2108, 192, -9,
+	 2, 105, -2128, 25881, 10837, -2113, 193, -9,
+	 2, 106, -2136, 25857, 10872, -2117, 193, -9,
+	 2, 108, -2144, 25832, 10907, -2122, 194, -9,
+	 2, 110, -2152, 25808, 10942, -2127, 194, -9,
+	 2, 111, -2159, 25783, 10977, -2132, 195, -9,
+	 2, 113, -2167, 25759, 11012, -2136, 196, -9,
+	 2, 114, -2175, 25734, 11047, -2141, 196, -8,
+	 1, 116, -2182, 25709, 11082, -2146, 197, -8,
+	 1, 117, -2190, 25684, 11117, -2151, 197, -8,
+	 1, 119, -2198, 25659, 11152, -2155, 198, -8,
+	 1, 120, -2205, 25634, 11187, -2160, 198, -8,
+	 1, 122, -2213, 25609, 11222, -2165, 199, -8,
+	 1, 123, -2220, 25584, 11258, -2169, 199, -8,
+	 1, 125, -2227, 25559, 11293, -2174, 200, -8,
+	 1, 126, -2235, 25534, 11328, -2179, 200, -8,
+	 1, 127, -2242, 25508, 11363, -2183, 201, -8,
+	 1, 129, -2249, 25483, 11399, -2188, 201, -8,
+	 1, 130, -2256, 25458, 11434, -2193, 202, -8,
+	 1, 132, -2264, 25432, 11469, -2197, 202, -7,
+	 1, 133, -2271, 25407, 11505, -2202, 203, -7,
+	 1, 135, -2278, 25381, 11540, -2207, 203, -7,
+	 1, 136, -2285, 25355, 11575, -2211, 204, -7,
+	 1, 137, -2292, 25329, 11611, -2216, 204, -7,
+	 1, 139, -2299, 25304, 11646, -2220, 205, -7,
+	 1, 140, -2305, 25278, 11681, -2225, 205, -7,
+	 1, 141, -2312, 25252, 11717, -2229, 206, -7,
+	 1, 143, -2319, 25226, 11752, -2234, 206, -7,
+	 1, 144, -2326, 25200, 11788, -2239, 207, -7,
+	 1, 145, -2332, 25173, 11823, -2243, 207, -7,
+	 1, 147, -2339, 25147, 11859, -2248, 208, -7,
+	 1, 148, -2346, 25121, 11894, -2252, 208, -7,
+	 1, 149, -2352, 25095, 11930, -2257, 209, -6,
+	 1, 151, -2359, 25068, 11965, -2261, 209, -6,
+	 1, 152, -2365, 25042, 12001, -2266, 210, -6,
+	 1, 153, -2371, 25015, 12036, -2270, 210, -6,
+	 0, 154, -2378, 24989, 12072, -2275, 211, -6,
+	 0, 156, -2384, 24962, 12108, -2279, 211, -6,
+	 0, 157, -2390, 24935, 12143, -2284, 212, -6,
+	 0, 158, -2396, 24909, 12179, -2288, 212, -6,
+	 0, 159, -2403, 24882, 12215, -2293, 213, -6,
+	 0, 161, -2409, 24855, 12250, -2297, 213, -6,
+	 0, 162, -2415, 24828, 12286, -2301, 214, -6,
+	 0, 163, -2421, 24801, 12322, -2306, 214, -6,
+	 0, 164, -2427, 24774, 12357, -2310, 215, -6,
+	 0, 166, -2433, 24747, 12393, -2315, 215, -5,
+	 0, 167, -2439, 24719, 12429, -2319, 216, -5,
+	 0, 168, -2444, 24692, 12465, -2323, 216, -5,
+	 0, 169, -2450, 24665, 12500, -2328, 217, -5,
+	 0, 170, -2456, 24637, 12536, -2332, 217, -5,
+	 0, 171, -2462, 24610, 12572, -2336, 218, -5,
+	 0, 173, -2467, 24583, 12608, -2341, 218, -5,
+	 0, 174, -2473, 24555, 12644, -2345, 219, -5,
+	 0, 175, -2479, 24527, 12679, -2349, 219, -5,
+	 0, 176, -2484, 24500, 12715, -2354, 220, -5,
+	 0, 177, -2490, 24472, 12751, -2358, 220, -5,
+	 0, 178, -2495, 24444, 12787, -2362, 221, -5,
+	 0, 179, -2500, 24416, 12823, -2366, 221, -5,
+	 0, 180, -2506, 24388, 12859, -2371, 222, -5,
+	 0, 181, -2511, 24360, 12895, -2375, 222, -5,
+	 0, 183, -2516, 24332, 12931, -2379, 222, -5,
+	 0, 184, -2521, 24304, 12966, -2383, 223, -4,
+	 0, 185, -2527, 24276, 13002, -2388, 223, -4,
+	 0, 186, -2532, 24248, 13038, -2392, 224, -4,
+	 0, 187, -2537, 24220, 13074, -2396, 224, -4,
+	 0, 188, -2542, 24191, 13110, -2400, 225, -4,
+	 0, 189, -2547, 24163, 13146, -2404, 225, -4,
+	 0, 190, -2552, 24135, 13182, -2408, 226, -4,
+	 0, 191, -2557, 24106, 13218, -2412, 226, -4,
+	 0, 192, -2562, 24078, 13254, -2417, 227, -4,
+	 0, 193, -2566, 24049, 13290, -2421, 227, -4,
+	 0, 194, -2571, 24020, 13326, -2425, 228, -4,
+	 0, 195, -2576, 23992, 13362, -2429, 228, -4,
+	 0, 196, -2581, 23963, 13398, -2433, 228, -4,
+	 0, 197, -2585, 23934, 13434, -2437, 229, -4,
+	 0, 198, -2590, 23905, 13470, -2441, 229, -4,
+	 0, 199, -2594, 23876, 13506, -2445, 230, -4,
+	 0, 200, -2599, 23847, 13543, -2449, 230, -4,
+	 0, 201, -2603, 23818, 13579, -2453, 231, -3,
+	 0, 201, -2608, 23789, 13615, -2457, 231, -3,
+	 0, 202, -2612, 23760, 13651, -2461, 231, -3,
+	 0, 203, -2617, 23731, 13687, -2465, 232, -3,
+	 0, 204, -2621, 23702, 13723, -2469, 232, -3,
+	 0, 205, -2625, 23672, 13759, -2473, 233, -3,
+	 0, 206, -2629, 23643, 13795, -2477, 233, -3,
+	 0, 207, -2634, 23614, 13831, -2480, 234, -3,
+	 0, 208, -2638, 23584, 13868, -2484, 234, -3,
+	 0, 209, -2642, 23555, 13904, -2488, 234, -3,
+	 0, 210, -2646, 23525, 13940, -2492, 235, -3,
+	 0, 210, -2650, 23495, 13976, -2496, 235, -3,
+	 0, 211, -2654, 23466, 14012, -2500, 236, -3,
+	 0, 212, -2658, 23436, 14048, -2504, 236, -3,
+	 0, 213, -2662, 23406, 14084, -2507, 237, -3,
+	 0, 214, -2665, 23376, 14121, -2511, 237, -3,
+	 0, 215, -2669, 23346, 14157, -2515, 237, -3,
+	 0, 215, -2673, 23317, 14193, -2519, 238, -3,
+	 0, 216, -2677, 23287, 14229, -2522, 238, -3,
+	 0, 217, -2680, 23257, 14265, -2526, 239, -3,
+	 0, 218, -2684, 23226, 14302, -2530, 239, -2,
+	 0, 219, -2688, 23196, 14338, -2533, 239, -2,
+	 0, 219, -2691, 23166, 14374, -2537, 240, -2,
+	 0, 220, -2695, 23136, 14410, -2541, 240, -2,
+	 0, 221, -2698, 23106, 14446, -2544, 241, -2,
+	 0, 222, -2702, 23075, 14483, -2548, 241, -2,
+	 0, 222, -2705, 23045, 14519, -2552, 241, -2,
+	 0, 223, -2708, 23015, 14555, -2555, 242, -2,
+	 0, 224, -2712, 22984, 14591, -2559, 242, -2,
+	 0, 225, -2715, 22954, 14627, -2562, 243, -2,
+	 0, 225, -2718, 22923, 14664, -2566, 243, -2,
+	 0, 226, -2721, 22892, 14700, -2569, 243, -2,
+	 0, 227, -2725, 22862, 14736, -2573, 244, -2,
+	 0, 227, -2728, 22831, 14772, -2576, 244, -2,
+	 0, 228, -2731, 22800, 14809, -2580, 244, -2,
+	 0, 229, -2734, 22769, 14845, -2583, 245, -2,
+	 0, 229, -2737, 22738, 14881, -2587, 245, -2,
+	 0, 230, -2740, 22708, 14917, -2590, 245, -2,
+	 0, 231, -2743, 22677, 14953, -2594, 246, -2,
+	 0, 231, -2746, 22646, 14990, -2597, 246, -2,
+	 0, 232, -2748, 22615, 15026, -2600, 247, -2,
+	 0, 233, -2751, 22583, 15062, -2604, 247, -2,
+	 0, 233, -2754, 22552, 15098, -2607, 247, -2,
+	 0, 234, -2757, 22521, 15135, -2611, 248, -2,
+	 0, 235, -2759, 22490, 15171, -2614, 248, -2,
+	 0, 235, -2762, 22459, 15207, -2617, 248, -2,
+	 0, 236, -2765, 22427, 15243, -2620, 249, -1,
+	 0, 236, -2767, 22396, 15279, -2624, 249, -1,
+	 0, 237, -2770, 22365, 15316, -2627, 249, -1,
+	 0, 238, -2772, 22333, 15352, -2630, 250, -1,
+	 0, 238, -2775, 22302, 15388, -2633, 250, -1,
+	 0, 239, -2777, 22270, 15424, -2636, 250, -1,
+	 0, 239, -2780, 22238, 15460, -2640, 251, -1,
+	 0, 240, -2782, 22207, 15497, -2643, 251, -1,
+	 0, 241, -2784, 22175, 15533, -2646, 251, -1,
+	 0, 241, -2786, 22143, 15569, -2649, 252, -1,
+	 0, 242, -2789, 22112, 15605, -2652, 252, -1,
+	 0, 242, -2791, 22080, 15641, -2655, 252, -1,
+	 0, 243, -2793, 22048, 15678, -2658, 253, -1,
+	 0, 243, -2795, 22016, 15714, -2661, 253, -1,
+	 0, 244, -2797, 21984, 15750, -2664, 253, -1,
+	 0, 244, -2799, 21952, 15786, -2667, 253, -1,
+	 0, 245, -2801, 21920, 15822, -2670, 254, -1,
+	 0, 245, -2803, 21888, 15858, -2673, 254, -1,
+	 0, 246, -2805, 21856, 15895, -2676, 254, -1,
+	 0, 246, -2807, 21824, 15931, -2679, 255, -1,
+	 0, 247, -2809, 21792, 15967, -2682, 255, -1,
+	 0, 247, -2811, 21759, 16003, -2685, 255, -1,
+	 0, 248, -2813, 21727, 16039, -2688, 255, -1,
+	 0, 248, -2814, 21695, 16075, -2691, 256, -1,
+	 0, 249, -2816, 21662, 16111, -2693, 256, -1,
+	 0, 249, -2818, 21630, 16148, -2696, 256, -1,
+	 0, 249, -2819, 21598, 16184, -2699, 257, -1,
+	 0, 250, -2821, 21565, 16220, -2702, 257, -1,
+	 0, 250, -2823, 21533, 16256, -2704, 257, -1,
+	 0, 251, -2824, 21500, 16292, -2707, 257, -1,
+	 0, 251, -2826, 21468, 16328, -2710, 258, -1,
+	 0, 252, -2827, 21435, 16364, -2712, 258, -1,
+	 0, 252, -2829, 21402, 16400, -2715, 258, -1,
+	 0, 252, -2830, 21370, 16436, -2718, 258, -1,
+	 0, 253, -2831, 21337, 16472, -2720, 259, -1,
+	 0, 253, -2833, 21304, 16508, -2723, 259, -1,
+	 0, 254, -2834, 21271, 16544, -2726, 259, -1,
+	 0, 254, -2835, 21238, 16580, -2728, 259, -1,
+	 0, 254, -2836, 21205, 16616, -2731, 260, -1,
+	 0, 255, -2838, 21173, 16652, -2733, 260, -1,
+	 0, 255, -2839, 21140, 16688, -2736, 260, -1,
+	 0, 255, -2840, 21107, 16724, -2738, 260, 0,
+	 0, 256, -2841, 21074, 16760, -2740, 260, 0,
+	 0, 256, -2842, 21040, 16796, -2743, 261, 0,
+	 0, 256, -2843, 21007, 16832, -2745, 261, 0,
+	 0, 257, -2844, 20974, 16868, -2748, 261, 0,
+	 0, 257, -2845, 20941, 16904, -2750, 261, 0,
+	 0, 257, -2846, 20908, 16940, -2752, 262, 0,
+	 0, 258, -2847, 20875, 16976, -2755, 262, 0,
+	 0, 258, -2847, 20841, 17012, -2757, 262, 0,
+	 0, 258, -2848, 20808, 17048, -2759, 262, 0,
+	 0, 259, -2849, 20775, 17084, -2761, 262, 0,
+	 0, 259, -2850, 20741, 17119, -2764, 262, 0,
+	 0, 259, -2851, 20708, 17155, -2766, 263, 0,
+	 0, 259, -2851, 20674, 17191, -2768, 263, 0,
+	 0, 260, -2852, 20641, 17227, -2770, 263, 0,
+	 0, 260, -2852, 20607, 17263, -2772, 263, 0,
+	 0, 260, -2853, 20574, 17299, -2774, 263, 0,
+	 0, 261, -2854, 20540, 17334, -2776, 264, 0,
+	 0, 261, -2854, 20506, 17370, -2778, 264, 0,
+	 0, 261, -2855, 20473, 17406, -2780, 264, 0,
+	 0, 261, -2855, 20439, 17442, -2783, 264, 0,
+	 0, 262, -2855, 20405, 17477, -2784, 264, 0,
+	 0, 262, -2856, 20372, 17513, -2786, 264, 0,
+	 0, 262, -2856, 20338, 17549, -2788, 264, 0,
+	 0, 262, -2856, 20304, 17584, -2790, 265, 0,
+	 0, 262, -2857, 20270, 17620, -2792, 265, 0,
+	 0, 263, -2857, 20236, 17656, -2794, 265, 0,
+	 0, 263, -2857, 20202, 17691, -2796, 265, 0,
+	 0, 263, -2857, 20168, 17727, -2798, 265, 0,
+	 0, 263, -2858, 20134, 17763, -2799, 265, 0,
+	 0, 263, -2858, 20100, 17798, -2801, 265, 0,
+	 0, 264, -2858, 20066, 17834, -2803, 265, 0,
+	 0, 264, -2858, 20032, 17869, -2805, 266, 0,
+	 0, 264, -2858, 19998, 17905, -2806, 266, 0,
+	 0, 264, -2858, 19964, 17940, -2808, 266, 0,
+	 0, 264, -2858, 19930, 17976, -2810, 266, 0,
+	 0, 264, -2858, 19896, 18011, -2811, 266, 0,
+	 0, 265, -2858, 19861, 18047, -2813, 266, 0,
+	 0, 265, -2858, 19827, 18082, -2814, 266, 0,
+	 0, 265, -2857, 19793, 18118, -2816, 266, 0,
+	 0, 265, -2857, 19758, 18153, -2817, 266, 0,
+	 0, 265, -2857, 19724, 18188, -2819, 266, 0,
+	 0, 265, -2857, 19690, 18224, -2820, 266, 0,
+	 0, 265, -2856, 19655, 18259, -2822, 266, 0,
+	 0, 266, -2856, 19621, 18294, -2823, 267, 0,
+	 0, 266, -2856, 19586, 18330, -2825, 267, 0,
+	 0, 266, -2855, 19552, 18365, -2826, 267, 0,
+	 0, 266, -2855, 19518, 18400, -2827, 267, 0,
+	 0, 266, -2855, 19483, 18436, -2829, 267, 0,
+	 0, 266, -2854, 19448, 18471, -2830, 267, 0,
+	 0, 266, -2854, 19414, 18506, -2831, 267, 0,
+	 0, 266, -2853, 19379, 18541, -2832, 267, 0,
+	 0, 266, -2853, 19345, 18576, -2833, 267, 0,
+	 0, 266, -2852, 19310, 18612, -2835, 267, 0,
+	 0, 266, -2851, 19275, 18647, -2836, 267, 0,
+	 0, 266, -2851, 19241, 18682, -2837, 267, 0,
+	 0, 267, -2850, 19206, 18717, -2838, 267, 0,
+	 0, 267, -2850, 19171, 18752, -2839, 267, 0,
+	 0, 267, -2849, 19136, 18787, -2840, 267, 0,
+	 0, 267, -2848, 19101, 18822, -2841, 267, 0,
+	 0, 267, -2847, 19067, 18857, -2842, 267, 0,
+	 0, 267, -2846, 19032, 18892, -2843, 267, 0,
+	 0, 267, -2846, 18997, 18927, -2844, 267, 0,
+	 0, 267, -2845, 18962, 18962, -2845, 267, 0,
+	 0, 267, -2844, 18927, 18997, -2846, 267, 0,
+	 0, 267, -2843, 18892, 19032, -2846, 267, 0,
+	 0, 267, -2842, 18857, 19067, -2847, 267, 0,
+	 0, 267, -2841, 18822, 19101, -2848, 267, 0,
+	 0, 267, -2840, 18787, 19136, -2849, 267, 0,
+	 0, 267, -2839, 18752, 19171, -2850, 267, 0,
+	 0, 267, -2838, 18717, 19206, -2850, 267, 0,
+	 0, 267, -2837, 18682, 19241, -2851, 266, 0,
+	 0, 267, -2836, 18647, 19275, -2851, 266, 0,
+	 0, 267, -2835, 18612, 19310, -2852, 266, 0,
+	 0, 267, -2833, 18576, 19345, -2853, 266, 0,
+	 0, 267, -2832, 18541, 19379, -2853, 266, 0,
+	 0, 267, -2831, 18506, 19414, -2854, 266, 0,
+	 0, 267, -2830, 18471, 19448, -2854, 266, 0,
+	 0, 267, -2829, 18436, 19483, -2855, 266, 0,
+	 0, 267, -2827, 18400, 19518, -2855, 266, 0,
+	 0, 267, -2826, 18365, 19552, -2855, 266, 0,
+	 0, 267, -2825, 18330, 19586, -2856, 266, 0,
+	 0, 267, -2823, 18294, 19621, -2856, 266, 0,
+	 0, 266, -2822, 18259, 19655, -2856, 265, 0,
+	 0, 266, -2820, 18224, 19690, -2857, 265, 0,
+	 0, 266, -2819, 18188, 19724, -2857, 265, 0,
+	 0, 266, -2817, 18153, 19758, -2857, 265, 0,
+	 0, 266, -2816, 18118, 19793, -2857, 265, 0,
+	 0, 266, -2814, 18082, 19827, -2858, 265, 0,
+	 0, 266, -2813, 18047, 19861, -2858, 265, 0,
+	 0, 266, -2811, 18011, 19896, -2858, 264, 0,
+	 0, 266, -2810, 17976, 19930, -2858, 264, 0,
+	 0, 266, -2808, 17940, 19964, -2858, 264, 0,
+	 0, 266, -2806, 17905, 19998, -2858, 264, 0,
+	 0, 266, -2805, 17869, 20032, -2858, 264, 0,
+	 0, 265, -2803, 17834, 20066, -2858, 264, 0,
+	 0, 265, -2801, 17798, 20100, -2858, 263, 0,
+	 0, 265, -2799, 17763, 20134, -2858, 263, 0,
+	 0, 265, -2798, 17727, 20168, -2857, 263, 0,
+	 0, 265, -2796, 17691, 20202, -2857, 263, 0,
+	 0, 265, -2794, 17656, 20236, -2857, 263, 0,
+	 0, 265, -2792, 17620, 20270, -2857, 262, 0,
+	 0, 265, -2790, 17584, 20304, -2856, 262, 0,
+	 0, 264, -2788, 17549, 20338, -2856, 262, 0,
+	 0, 264, -2786, 17513, 20372, -2856, 262, 0,
+	 0, 264, -2784, 17477, 20405, -2855, 262, 0,
+	 0, 264, -2783, 17442, 20439, -2855, 261, 0,
+	 0, 264, -2780, 17406, 20473, -2855, 261, 0,
+	 0, 264, -2778, 17370, 20506, -2854, 261, 0,
+	 0, 264, -2776, 17334, 20540, -2854, 261, 0,
+	 0, 263, -2774, 17299, 20574, -2853, 260, 0,
+	 0, 263, -2772, 17263, 20607, -2852, 260, 0,
+	 0, 263, -2770, 17227, 20641, -2852, 260, 0,
+	 0, 263, -2768, 17191, 20674, -2851, 259, 0,
+	 0, 263, -2766, 17155, 20708, -2851, 259, 0,
+	 0, 262, -2764, 17119, 20741, -2850, 259, 0,
+	 0, 262, -2761, 17084, 20775, -2849, 259, 0,
+	 0, 262, -2759, 17048, 20808, -2848, 258, 0,
+	 0, 262, -2757, 17012, 20841, -2847, 258, 0,
+	 0, 262, -2755, 16976, 20875, -2847, 258, 0,
+	 0, 262, -2752, 16940, 20908, -2846, 257, 0,
+	 0, 261, -2750, 16904, 20941, -2845, 257, 0,
+	 0, 261, -2748, 16868, 20974, -2844, 257, 0,
+	 0, 261, -2745, 16832, 21007, -2843, 256, 0,
+	 0, 261, -2743, 16796, 21040, -2842, 256, 0,
+	 0, 260, -2740, 16760, 21074, -2841, 256, 0,
+	 0, 260, -2738, 16724, 21107, -2840, 255, 0,
+	 -1, 260, -2736, 16688, 21140, -2839, 255, 0,
+	 -1, 260, -2733, 16652, 21173, -2838, 255, 0,
+	 -1, 260, -2731, 16616, 21205, -2836, 254, 0,
+	 -1, 259, -2728, 16580, 21238, -2835, 254, 0,
+	 -1, 259, -2726, 16544, 21271, -2834, 254, 0,
+	 -1, 259, -2723, 16508, 21304, -2833, 253, 0,
+	 -1, 259, -2720, 16472, 21337, -2831, 253, 0,
+	 -1, 258, -2718, 16436, 21370, -2830, 252, 0,
+	 -1, 258, -2715, 16400, 21402, -2829, 252, 0,
+	 -1, 258, -2712, 16364, 21435, -2827, 252, 0,
+	 -1, 258, -2710, 16328, 21468, -2826, 251, 0,
+	 -1, 257, -2707, 16292, 21500, -2824, 251, 0,
+	 -1, 257, -2704, 16256, 21533, -2823, 250, 0,
+	 -1, 257, -2702, 16220, 21565, -2821, 250, 0,
+	 -1, 257, -2699, 16184, 21598, -2819, 249, 0,
+	 -1, 256, -2696, 16148, 21630, -2818, 249, 0,
+	 -1, 256, -2693, 16111, 21662, -2816, 249, 0,
+	 -1, 256, -2691, 16075, 21695, -2814, 248, 0,
+	 -1, 255, -2688, 16039, 21727, -2813, 248, 0,
+	 -1, 255, -2685, 16003, 21759, -2811, 247, 0,
+	 -1, 255, -2682, 15967, 21792, -2809, 247, 0,
+	 -1, 255, -2679, 15931, 21824, -2807, 246, 0,
+	 -1, 254, -2676, 15895, 21856, -2805, 246, 0,
+	 -1, 254, -2673, 15858, 21888, -2803, 245, 0,
+	 -1, 254, -2670, 15822, 21920, -2801, 245, 0,
+	 -1, 253, -2667, 15786, 21952, -2799, 244, 0,
+	 -1, 253, -2664, 15750, 21984, -2797, 244, 0,
+	 -1, 253, -2661, 15714, 22016, -2795, 243, 0,
+	 -1, 253, -2658, 15678, 22048, -2793, 243, 0,
+	 -1, 252, -2655, 15641, 22080, -2791, 242, 0,
+	 -1, 252, -2652, 15605, 22112, -2789, 242, 0,
+	 -1, 252, -2649, 15569, 22143, -2786, 241, 0,
+	 -1, 251, -2646, 15533, 22175, -2784, 241, 0,
+	 -1, 251, -2643, 15497, 22207, -2782, 240, 0,
+	 -1, 251, -2640, 15460, 22238, -2780, 239, 0,
+	 -1, 250, -2636, 15424, 22270, -2777, 239, 0,
+	 -1, 250, -2633, 15388, 22302, -2775, 238, 0,
+	 -1, 250, -2630, 15352, 22333, -2772, 238, 0,
+	 -1, 249, -2627, 15316, 22365, -2770, 237, 0,
+	 -1, 249, -2624, 15279, 22396, -2767, 236, 0,
+	 -1, 249, -2620, 15243, 22427, -2765, 236, 0,
+	 -2, 248, -2617, 15207, 22459, -2762, 235, 0,
+	 -2, 248, -2614, 15171, 22490, -2759, 235, 0,
+	 -2, 248, -2611, 15135, 22521, -2757, 234, 0,
+	 -2, 247, -2607, 15098, 22552, -2754, 233, 0,
+	 -2, 247, -2604, 15062, 22583, -2751, 233, 0,
+	 -2, 247, -2600, 15026, 22615, -2748, 232, 0,
+	 -2, 246, -2597, 14990, 22646, -2746, 231, 0,
+	 -2, 246, -2594, 14953, 22677, -2743, 231, 0,
+	 -2, 245, -2590, 14917, 22708, -2740, 230, 0,
+	 -2, 245, -2587, 14881, 22738, -2737, 229, 0,
+	 -2, 245, -2583, 14845, 22769, -2734, 229, 0,
+	 -2, 244, -2580, 14809, 22800, -2731, 228, 0,
+	 -2, 244, -2576, 14772, 22831, -2728, 227, 0,
+	 -2, 244, -2573, 14736, 22862, -2725, 227, 0,
+	 -2, 243, -2569, 14700, 22892, -2721, 226, 0,
+	 -2, 243, -2566, 14664, 22923, -2718, 225, 0,
+	 -2, 243, -2562, 14627, 22954, -2715, 225, 0,
+	 -2, 242, -2559, 14591, 22984, -2712, 224, 0,
+	 -2, 242, -2555, 14555, 23015, -2708, 223, 0,
+	 -2, 241, -2552, 14519, 23045, -2705, 222, 0,
+	 -2, 241, -2548, 14483, 23075, -2702, 222, 0,
+	 -2, 241, -2544, 14446, 23106, -2698, 221, 0,
+	 -2, 240, -2541, 14410, 23136, -2695, 220, 0,
+	 -2, 240, -2537, 14374, 23166, -2691, 219, 0,
+	 -2, 239, -2533, 14338, 23196, -2688, 219, 0,
+	 -2, 239, -2530, 14302, 23226, -2684, 218, 0,
+	 -3, 239, -2526, 14265, 23257, -2680, 217, 0,
+	 -3, 238, -2522, 14229, 23287, -2677, 216, 0,
+	 -3, 238, -2519, 14193, 23317, -2673, 215, 0,
+	 -3, 237, -2515, 14157, 23346, -2669, 215, 0,
+	 -3, 237, -2511, 14121, 23376, -2665, 214, 0,
+	 -3, 237, -2507, 14084, 23406, -2662, 213, 0,
+	 -3, 236, -2504, 14048, 23436, -2658, 212, 0,
+	 -3, 236, -2500, 14012, 23466, -2654, 211, 0,
+	 -3, 235, -2496, 13976, 23495, -2650, 210, 0,
+	 -3, 235, -2492, 13940, 23525, -2646, 210, 0,
+	 -3, 234, -2488, 13904, 23555, -2642, 209, 0,
+	 -3, 234, -2484, 13868, 23584, -2638, 208, 0,
+	 -3, 234, -2480, 13831, 23614, -2634, 207, 0,
+	 -3, 233, -2477, 13795, 23643, -2629, 206, 0,
+	 -3, 233, -2473, 13759, 23672, -2625, 205, 0,
+	 -3, 232, -2469, 13723, 23702, -2621, 204, 0,
+	 -3, 232, -2465, 13687, 23731, -2617, 203, 0,
+	 -3, 231, -2461, 13651, 23760, -2612, 202, 0,
+	 -3, 231, -2457, 13615, 23789, -2608, 201, 0,
+	 -3, 231, -2453, 13579, 23818, -2603, 201, 0,
+	 -4, 230, -2449, 13543, 23847, -2599, 200, 0,
+	 -4, 230, -2445, 13506, 23876, -2594, 199, 0,
+	 -4, 229, -2441, 13470, 23905, -2590, 198, 0,
+	 -4, 229, -2437, 13434, 23934, -2585, 197, 0,
+	 -4, 228, -2433, 13398, 23963, -2581, 196, 0,
+	 -4, 228, -2429, 13362, 23992, -2576, 195, 0,
+	 -4, 228, -2425, 13326, 24020, -2571, 194, 0,
+	 -4, 227, -2421, 13290, 24049, -2566, 193, 0,
+	 -4, 227, -2417, 13254, 24078, -2562, 192, 0,
+	 -4, 226, -2412, 13218, 24106, -2557, 191, 0,
+	 -4, 226, -2408, 13182, 24135, -2552, 190, 0,
+	 -4, 225, -2404, 13146, 24163, -2547, 189, 0,
+	 -4, 225, -2400, 13110, 24191, -2542, 188, 0,
+	 -4, 224, -2396, 13074, 24220, -2537, 187, 0,
+	 -4, 224, -2392, 13038, 24248, -2532, 186, 0,
+	 -4, 223, -2388, 13002, 24276, -2527, 185, 0,
+	 -4, 223, -2383, 12966, 24304, -2521, 184, 0,
+	 -5, 222, -2379, 12931, 24332, -2516, 183, 0,
+	 -5, 222, -2375, 12895, 24360, -2511, 181, 0,
+	 -5, 222, -2371, 12859, 24388, -2506, 180, 0,
+	 -5, 221, -2366, 12823, 24416, -2500, 179, 0,
+	 -5, 221, -2362, 12787, 24444, -2495, 178, 0,
+	 -5, 220, -2358, 12751, 24472, -2490, 177, 0,
+	 -5, 220, -2354, 12715, 24500, -2484, 176, 0,
+	 -5, 219, -2349, 12679, 24527, -2479, 175, 0,
+	 -5, 219, -2345, 12644, 24555, -2473, 174, 0,
+	 -5, 218, -2341, 12608, 24583, -2467, 173, 0,
+	 -5, 218, -2336, 12572, 24610, -2462, 171, 0,
+	 -5, 217, -2332, 12536, 24637, -2456, 170, 0,
+	 -5, 217, -2328, 12500, 24665, -2450, 169, 0,
+	 -5, 216, -2323, 12465, 24692, -2444, 168, 0,
+	 -5, 216, -2319, 12429, 24719, -2439, 167, 0,
+	 -5, 215, -2315, 12393, 24747, -2433, 166, 0,
+	 -6, 215, -2310, 12357, 24774, -2427, 164, 0,
+	 -6, 214, -2306, 12322, 24801, -2421, 163, 0,
+	 -6, 214, -2301, 12286, 24828, -2415, 162, 0,
+	 -6, 213, -2297, 12250, 24855, -2409, 161, 0,
+	 -6, 213, -2293, 12215, 24882, -2403, 159, 0,
+	 -6, 212, -2288, 12179, 24909, -2396, 158, 0,
+	 -6, 212, -2284, 12143, 24935, -2390, 157, 0,
+	 -6, 211, -2279, 12108, 24962, -2384, 156, 0,
+	 -6, 211, -2275, 12072, 24989, -2378, 154, 0,
+	 -6, 210, -2270, 12036, 25015, -2371, 153, 1,
+	 -6, 210, -2266, 12001, 25042, -2365, 152, 1,
+	 -6, 209, -2261, 11965, 25068, -2359, 151, 1,
+	 -6, 209, -2257, 11930, 25095, -2352, 149, 1,
+	 -7, 208, -2252, 11894, 25121, -2346, 148, 1,
+	 -7, 208, -2248, 11859, 25147, -2339, 147, 1,
+	 -7, 207, -2243, 11823, 25173, -2332, 145, 1,
+	 -7, 207, -2239, 11788, 25200, -2326, 144, 1,
+	 -7, 206, -2234, 11752, 25226, -2319, 143, 1,
+	 -7, 206, -2229, 11717, 25252, -2312, 141, 1,
+	 -7, 205, -2225, 11681, 25278, -2305, 140, 1,
+	 -7, 205, -2220, 11646, 25304, -2299, 139, 1,
+	 -7, 204, -2216, 11611, 25329, -2292, 137, 1,
+	 -7, 204, -2211, 11575, 25355, -2285, 136, 1,
+	 -7, 203, -2207, 11540, 25381, -2278, 135, 1,
+	 -7, 203, -2202, 11505, 25407, -2271, 133, 1,
+	 -7, 202, -2197, 11469, 25432, -2264, 132, 1,
+	 -8, 202, -2193, 11434, 25458, -2256, 130, 1,
+	 -8, 201, -2188, 11399, 25483, -2249, 129, 1,
+	 -8, 201, -2183, 11363, 25508, -2242, 127, 1,
+	 -8, 200, -2179, 11328, 25534, -2235, 126, 1,
+	 -8, 200, -2174, 11293, 25559, -2227, 125, 1,
+	 -8, 199, -2169, 11258, 25584, -2220, 123, 1,
+	 -8, 199, -2165, 11222, 25609, -2213, 122, 1,
+	 -8, 198, -2160, 11187, 25634, -2205, 120, 1,
+	 -8, 198, -2155, 11152, 25659, -2198, 119, 1,
+	 -8, 197, -2151, 11117, 25684, -2190, 117, 1,
+	 -8, 197, -2146, 11082, 25709, -2182, 116, 1,
+	 -8, 196, -2141, 11047, 25734, -2175, 114, 2,
+	 -9, 196, -2136, 11012, 25759, -2167, 113, 2,
+	 -9, 195, -2132, 10977, 25783, -2159, 111, 2,
+	 -9, 194, -2127, 10942, 25808, -2152, 110, 2,
+	 -9, 194, -2122, 10907, 25832, -2144, 108, 2,
+	 -9, 193, -2117, 10872, 25857, -2136, 106, 2,
+	 -9, 193, -2113, 10837, 25881, -2128, 105, 2,
+	 -9, 192, -2108, 10802, 25905, -2120, 103, 2,
+	 -9, 192, -2103, 10767, 25930, -2112, 102, 2,
+	 -9, 191, -2098, 10732, 25954, -2104, 100, 2,
+	 -9, 191, -2093, 10697, 25978, -2096, 99, 2,
+	 -9, 190, -2089, 10662, 26002, -2087, 97, 2,
+	 -10, 190, -2084, 10627, 26026, -2079, 95, 2,
+	 -10, 189, -2079, 10593, 26050, -2071, 94, 2,
+	 -10, 189, -2074, 10558, 26074, -2062, 92, 2,
+	 -10, 188, -2069, 10523, 26097, -2054, 90, 2,
+	 -10, 188, -2065, 10488, 26121, -2046, 89, 2,
+	 -10, 187, -2060, 10454, 26145, -2037, 87, 2,
+	 -10, 187, -2055, 10419, 26168, -2029, 85, 2,
+	 -10, 186, -2050, 10384, 26192, -2020, 84, 2,
+	 -10, 185, -2045, 10350, 26215, -2011, 82, 3,
+	 -10, 185, -2040, 10315, 26239, -2003, 80, 3,
+	 -11, 184, -2035, 10280, 26262, -1994, 79, 3,
+	 -11, 184, -2031, 10246, 26285, -1985, 77, 3,
+	 -11, 183, -2026, 10211, 26308, -1976, 75, 3,
+	 -11, 183, -2021, 10177, 26331, -1967, 74, 3,
+	 -11, 182, -2016, 10142, 26354, -1958, 72, 3,
+	 -11, 182, -2011, 10108, 26377, -1949, 70, 3,
+	 -11, 181, -2006, 10073, 26400, -1940, 68, 3,
+	 -11, 181, -2001, 10039, 26423, -1931, 67, 3,
+	 -11, 180, -1996, 10004, 26445, -1922, 65, 3,
+	 -11, 180, -1991, 9970, 26468, -1913, 63, 3,
+	 -12, 179, -1986, 9936, 26491, -1904, 61, 3,
+	 -12, 178, -1982, 9901, 26513, -1895, 59, 3,
+	 -12, 178, -1977, 9867, 26536, -1885, 58, 3,
+	 -12, 177, -1972, 9833, 26558, -1876, 56, 3,
+	 -12, 177, -1967, 9799, 26580, -1866, 54, 4,
+	 -12, 176, -1962, 9764, 26602, -1857, 52, 4,
+	 -12, 176, -1957, 9730, 26625, -1847, 50, 4,
+	 -12, 175, -1952, 9696, 26647, -1838, 48, 4,
+	 -12, 175, -1947, 9662, 26669, -1828, 46, 4,
+	 -13, 174, -1942, 9628, 26690, -1818, 45, 4,
+	 -13, 174, -1937, 9594, 26712, -1809, 43, 4,
+	 -13, 173, -1932, 9560, 26734, -1799, 41, 4,
+	 -13, 173, -1927, 9526, 26756, -1789, 39, 4,
+	 -13, 172, -1922, 9492, 26777, -1779, 37, 4,
+	 -13, 171, -1917, 9458, 26799, -1769, 35, 4,
+	 -13, 171, -1912, 9424, 26820, -1759, 33, 4,
+	 -13, 170, -1907, 9390, 26842, -1749, 31, 4,
+	 -13, 170, -1902, 9356, 26863, -1739, 29, 4,
+	 -13, 169, -1897, 9322, 26884, -1729, 27, 5,
+	 -14, 169, -1892, 9288, 26905, -1719, 25, 5,
+	 -14, 168, -1887, 9254, 26926, -1708, 23, 5,
+	 -14, 168, -1882, 9221, 26948, -1698, 21, 5,
+	 -14, 167, -1877, 9187, 26968, -1688, 19, 5,
+	 -14, 167, -1872, 9153, 26989, -1677, 17, 5,
+	 -14, 166, -1867, 9119, 27010, -1667, 15, 5,
+	 -14, 165, -1862, 9086, 27031, -1656, 13, 5,
+	 -14, 165, -1857, 9052, 27051, -1646, 11, 5,
+	 -15, 164, -1852, 9019, 27072, -1635, 9, 5,
+	 -15, 164, -1847, 8985, 27092, -1624, 7, 5,
+	 -15, 163, -1842, 8952, 27113, -1614, 5, 6,
+	 -15, 163, -1837, 8918, 27133, -1603, 3, 6,
+	 -15, 162, -1832, 8885, 27153, -1592, 1, 6,
+	 -15, 162, -1827, 8851, 27174, -1581, -1, 6,
+	 -15, 161, -1822, 8818, 27194, -1570, -3, 6,
+	 -15, 161, -1817, 8784, 27214, -1559, -5, 6,
+	 -15, 160, -1812, 8751, 27234, -1548, -8, 6,
+	 -16, 159, -1807, 8718, 27254, -1537, -10, 6,
+	 -16, 159, -1801, 8684, 27273, -1526, -12, 6,
+	 -16, 158, -1796, 8651, 27293, -1515, -14, 6,
+	 -16, 158, -1791, 8618, 27313, -1503, -16, 6,
+	 -16, 157, -1786, 8585, 27332, -1492, -18, 7,
+	 -16, 157, -1781, 8552, 27352, -1481, -20, 7,
+	 -16, 156, -1776, 8518, 27371, -1469, -23, 7,
+	 -16, 156, -1771, 8485, 27390, -1458, -25, 7,
+	 -17, 155, -1766, 8452, 27410, -1446, -27, 7,
+	 -17, 155, -1761, 8419, 27429, -1435, -29, 7,
+	 -17, 154, -1756, 8386, 27448, -1423, -31, 7,
+	 -17, 154, -1751, 8353, 27467, -1412, -34, 7,
+	 -17, 153, -1746, 8320, 27486, -1400, -36, 7,
+	 -17, 152, -1741, 8287, 27505, -1388, -38, 7,
+	 -17, 152, -1736, 8255, 27523, -1376, -40, 8,
+	 -17, 151, -1730, 8222, 27542, -1364, -43, 8,
+	 -18, 151, -1725, 8189, 27561, -1352, -45, 8,
+	 -18, 150, -1720, 8156, 27579, -1340, -47, 8,
+	 -18, 150, -1715, 8123, 27598, -1328, -50, 8,
+	 -18, 149, -1710, 8091, 27616, -1316, -52, 8,
+	 -18, 149, -1705, 8058, 27634, -1304, -54, 8,
+	 -18, 148, -1700, 8025, 27653, -1292, -57, 8,
+	 -18, 148, -1695, 7993, 27671, -1280, -59, 8,
+	 -18, 147, -1690, 7960, 27689, -1267, -61, 9,
+	 -19, 147, -1685, 7928, 27707, -1255, -64, 9,
+	 -19, 146, -1680, 7895, 27725, -1243, -66, 9,
+	 -19, 145, -1674, 7863, 27743, -1230, -68, 9,
+	 -19, 145, -1669, 7830, 27760, -1218, -71, 9,
+	 -19, 144, -1664, 7798, 27778, -1205, -73, 9,
+	 -19, 144, -1659, 7766, 27795, -1192, -76, 9,
+	 -19, 143, -1654, 7733, 27813, -1180, -78, 9,
+	 -19, 143, -1649, 7701, 27830, -1167, -81, 10,
+	 -20, 142, -1644, 7669, 27848, -1154, -83, 10,
+	 -20, 142, -1639, 7637, 27865, -1141, -85, 10,
+	 -20, 141, -1634, 7605, 27882, -1128, -88, 10,
+	 -20, 141, -1629, 7572, 27899, -1115, -90, 10,
+	 -20, 140, -1624, 7540, 27916, -1102, -93, 10,
+	 -20, 140, -1618, 7508, 27933, -1089, -95, 10,
+	 -20, 139, -1613, 7476, 27950, -1076, -98, 10,
+	 -21, 138, -1608, 7444, 27967, -1063, -100, 11,
+	 -21, 138, -1603, 7412, 27983, -1050, -103, 11,
+	 -21, 137, -1598, 7380, 28000, -1036, -105, 11,
+	 -21, 137, -1593, 7349, 28016, -1023, -108, 11,
+	 -21, 136, -1588, 7317, 28033, -1010, -110, 11,
+	 -21, 136, -1583, 7285, 28049, -996, -113, 11,
+	 -21, 135, -1578, 7253, 28065, -983, -116, 11,
+	 -21, 135, -1573, 7221, 28082, -969, -118, 12,
+	 -22, 134, -1567, 7190, 28098, -956, -121, 12,
+	 -22, 134, -1562, 7158, 28114, -942, -123, 12,
+	 -22, 133, -1557, 7127, 28130, -928, -126, 12,
+	 -22, 133, -1552, 7095, 28145, -914, -129, 12,
+	 -22, 132, -1547, 7063, 28161, -901, -131, 12,
+	 -22, 132, -1542, 7032, 28177, -887, -134, 12,
+	 -22, 131, -1537, 7001, 28192, -873, -136, 13,
+	 -23, 131, -1532, 6969, 28208, -859, -139, 13,
+	 -23, 130, -1527, 6938, 28223, -845, -142, 13,
+	 -23, 130, -1522, 6906, 28239, -831, -144, 13,
+	 -23, 129, -1517, 6875, 28254, -816, -147, 13,
+	 -23, 128, -1511, 6844, 28269, -802, -150, 13,
+	 -23, 128, -1506, 6813, 28284, -788, -153, 13,
+	 -23, 127, -1501, 6781, 28299, -774, -155, 14,
+	 -24, 127, -1496, 6750, 28314, -759, -158, 14,
+	 -24, 126, -1491, 6719, 28329, -745, -161, 14,
+	 -24, 126, -1486, 6688, 28344, -730, -163, 14,
+	 -24, 125, -1481, 6657, 28358, -716, -166, 14,
+	 -24, 125, -1476, 6626, 28373, -701, -169, 14,
+	 -24, 124, -1471, 6595, 28387, -687, -172, 15,
+	 -24, 124, -1466, 6564, 28402, -672, -175, 15,
+	 -25, 123, -1461, 6533, 28416, -657, -177, 15,
+	 -25, 123, -1456, 6503, 28430, -642, -180, 15,
+	 -25, 122, -1451, 6472, 28444, -627, -183, 15,
+	 -25, 122, -1445, 6441, 28458, -612, -186, 15,
+	 -25, 121, -1440, 6410, 28472, -597, -189, 16,
+	 -25, 121, -1435, 6380, 28486, -582, -191, 16,
+	 -25, 120, -1430, 6349, 28500, -567, -194, 16,
+	 -26, 120, -1425, 6319, 28514, -552, -197, 16,
+	 -26, 119, -1420, 6288, 28527, -537, -200, 16,
+	 -26, 119, -1415, 6258, 28541, -522, -203, 16,
+	 -26, 118, -1410, 6227, 28554, -506, -206, 17,
+	 -26, 118, -1405, 6197, 28568, -491, -209, 17,
+	 -26, 117, -1400, 6166, 28581, -476, -212, 17,
+	 -26, 117, -1395, 6136, 28594, -460, -215, 17,
+	 -27, 116, -1390, 6106, 28607, -444, -218, 17,
+	 -27, 116, -1385, 6076, 28620, -429, -220, 17,
+	 -27, 115, -1380, 6045, 28633, -413, -223, 18,
+	 -27, 115, -1375, 6015, 28646, -398, -226, 18,
+	 -27, 114, -1370, 5985, 28659, -382, -229, 18,
+	 -27, 114, -1365, 5955, 28672, -366, -232, 18,
+	 -28, 113, -1360, 5925, 28684, -350, -235, 18,
+	 -28, 113, -1355, 5895, 28697, -334, -238, 19,
+	 -28, 112, -1350, 5865, 28709, -318, -241, 19,
+	 -28, 112, -1345, 5835, 28721, -302, -244, 19,
+	 -28, 111, -1340, 5805, 28734, -286, -247, 19,
+	 -28, 111, -1335, 5776, 28746, -270, -250, 19,
+	 -28, 110, -1330, 5746, 28758, -254, -254, 19,
+	 -29, 110, -1325, 5716, 28770, -237, -257, 20,
+	 -29, 109, -1320, 5686, 28782, -221, -260, 20,
+	 -29, 109, -1315, 5657, 28793, -205, -263, 20,
+	 -29, 108, -1310, 5627, 28805, -188, -266, 20,
+	 -29, 108, -1305, 5598, 28817, -172, -269, 20,
+	 -29, 107, -1300, 5568, 28828, -155, -272, 21,
+	 -29, 107, -1295, 5539, 28840, -139, -275, 21,
+	 -30, 106, -1290, 5509, 28851, -122, -278, 21,
+	 -30, 106, -1285, 5480, 28862, -105, -281, 21,
+	 -30, 105, -1280, 5451, 28873, -88, -285, 21,
+	 -30, 105, -1275, 5421, 28885, -72, -288, 22,
+	 -30, 104, -1270, 5392, 28896, -55, -291, 22,
+	 -30, 104, -1265, 5363, 28906, -38, -294, 22,
+	 -31, 103, -1260, 5334, 28917, -21, -297, 22,
+	 -31, 103, -1255, 5305, 28928, -4, -300, 23,
+	 -31, 102, -1250, 5276, 28939, 13, -304, 23,
+	 -31, 102, -1245, 5247, 28949, 30, -307, 23,
+	 -31, 101, -1240, 5218, 28960, 48, -310, 23,
+	 -31, 101, -1235, 5189, 28970, 65, -313, 23,
+	 -31, 100, -1230, 5160, 28980, 82, -317, 24,
+	 -32, 100, -1225, 5131, 28990, 100, -320, 24,
+	 -32, 99, -1221, 5102, 29000, 117, -323, 24,
+	 -32, 99, -1216, 5074, 29010, 135, -326, 24,
+	 -32, 98, -1211, 5045, 29020, 152, -330, 24,
+	 -32, 98, -1206, 5016, 29030, 170, -333, 25,
+	 -32, 97, -1201, 4988, 29040, 187, -336, 25,
+	 -33, 97, -1196, 4959, 29050, 205, -340, 25,
+	 -33, 97, -1191, 4931, 29059, 223, -343, 25,
+	 -33, 96, -1186, 4902, 29069, 241, -346, 26,
+	 -33, 96, -1181, 4874, 29078, 259, -350, 26,
+	 -33, 95, -1176, 4845, 29087, 277, -353, 26,
+	 -33, 95, -1172, 4817, 29096, 295, -356, 26,
+	 -33, 94, -1167, 4789, 29106, 313, -360, 27,
+	 -34, 94, -1162, 4761, 29115, 331, -363, 27,
+	 -34, 93, -1157, 4732, 29124, 349, -366, 27,
+	 -34, 93, -1152, 4704, 29132, 367, -370, 27,
+	 -34, 92, -1147, 4676, 29141, 385, -373, 27,
+	 -34, 92, -1142, 4648, 29150, 404, -377, 28,
+	 -34, 91, -1138, 4620, 29158, 422, -380, 28,
+	 -35, 91, -1133, 4592, 29167, 441, -384, 28,
+	 -35, 91, -1128, 4564, 29175, 459, -387, 28,
+	 -35, 90, -1123, 4537, 29183, 478, -391, 29,
+	 -35, 90, -1118, 4509, 29192, 496, -394, 29,
+	 -35, 89, -1113, 4481, 29200, 515, -397, 29,
+	 -35, 89, -1109, 4453, 29208, 534, -401, 29,
+	 -35, 88, -1104, 4426, 29216, 552, -404, 30,
+	 -36, 88, -1099, 4398, 29223, 571, -408, 30,
+	 -36, 87, -1094, 4371, 29231, 590, -411, 30,
+	 -36, 87, -1089, 4343, 29239, 609, -415, 30,
+	 -36, 86, -1085, 4316, 29246, 628, -419, 31,
+	 -36, 86, -1080, 4288, 29254, 647, -422, 31,
+	 -36, 86, -1075, 4261, 29261, 666, -426, 31,
+	 -37, 85, -1070, 4234, 29268, 686, -429, 31,
+	 -37, 85, -1066, 4206, 29276, 705, -433, 32,
+	 -37, 84, -1061, 4179, 29283, 724, -436, 32,
+	 -37, 84, -1056, 4152, 29290, 743, -440, 32,
+	 -37, 83, -1051, 4125, 29297, 763, -444, 32,
+	 -37, 83, -1047, 4098, 29303, 782, -447, 33,
+	 -38, 82, -1042, 4071, 29310, 802, -451, 33,
+	 -38, 82, -1037, 4044, 29317, 821, -454, 33,
+	 -38, 82, -1032, 4017, 29323, 841, -458, 34,
+	 -38, 81, -1028, 3990, 29330, 861, -462, 34,
+	 -38, 81, -1023, 3963, 29336, 880, -465, 34,
+	 -38, 80, -1018, 3936, 29342, 900, -469, 34,
+	 -38, 80, -1014, 3910, 29349, 920, -473, 35,
+	 -39, 79, -1009, 3883, 29355, 940, -476, 35,
+	 -39, 79, -1004, 3856, 29361, 960, -480, 35,
+	 -39, 79, -999, 3830, 29367, 980, -484, 35,
+	 -39, 78, -995, 3803, 29372, 1000, -488, 36,
+	 -39, 78, -990, 3777, 29378, 1020, -491, 36,
+	 -39, 77, -985, 3750, 29384, 1040, -495, 36,
+	 -40, 77, -981, 3724, 29389, 1061, -499, 37,
+	 -40, 76, -976, 3698, 29395, 1081, -502, 37,
+	 -40, 76, -971, 3671, 29400, 1101, -506, 37,
+	 -40, 76, -967, 3645, 29405, 1122, -510, 37,
+	 -40, 75, -962, 3619, 29410, 1142, -514, 38,
+	 -40, 75, -958, 3593, 29415, 1163, -518, 38,
+	 -40, 74, -953, 3567, 29420, 1183, -521, 38,
+	 -41, 74, -948, 3541, 29425, 1204, -525, 39,
+	 -41, 74, -944, 3515, 29430, 1224, -529, 39,
+	 -41, 73, -939, 3489, 29435, 1245, -533, 39,
+	 -41, 73, -935, 3463, 29439, 1266, -537, 39,
+	 -41, 72, -930, 3437, 29444, 1287, -541, 40,
+	 -41, 72, -925, 3411, 29448, 1308, -544, 40,
+	 -42, 71, -921, 3386, 29452, 1329, -548, 40,
+	 -42, 71, -916, 3360, 29457, 1350, -552, 41,
+	 -42, 71, -912, 3334, 29461, 1371, -556, 41,
+	 -42, 70, -907, 3309, 29465, 1392, -560, 41,
+	 -42, 70, -903, 3283, 29469, 1413, -564, 42,
+	 -42, 69, -898, 3258, 29473, 1434, -568, 42,
+	 -42, 69, -894, 3232, 29476, 1456, -572, 42,
+	 -43, 69, -889, 3207, 29480, 1477, -576, 42,
+	 -43, 68, -885, 3182, 29484, 1498, -579, 43,
+	 -43, 68, -880, 3157, 29487, 1520, -583, 43,
+	 -43, 67, -876, 3131, 29490, 1541, -587, 43,
+	 -43, 67, -871, 3106, 29494, 1563, -591, 44,
+	 -43, 67, -867, 3081, 29497, 1585, -595, 44,
+	 -44, 66, -862, 3056, 29500, 1606, -599, 44,
+	 -44, 66, -858, 3031, 29503, 1628, -603, 45,
+	 -44, 65, -853, 3006, 29506, 1650, -607, 45,
+	 -44, 65, -849, 2981, 29509, 1672, -611, 45,
+	 -44, 65, -844, 2956, 29511, 1694, -615, 46,
+	 -44, 64, -840, 2932, 29514, 1716, -619, 46,
+	 -44, 64, -835, 2907, 29517, 1738, -623, 46,
+	 -45, 64, -831, 2882, 29519, 1760, -627, 47,
+	 -45, 63, -826, 2858, 29521, 1782, -631, 47,
+	 -45, 63, -822, 2833, 29524, 1804, -635, 47,
+	 -45, 62, -818, 2808, 29526, 1826, -640, 47,
+	 -45, 62, -813, 2784, 29528, 1848, -644, 48,
+	 -45, 62, -809, 2760, 29530, 1871, -648, 48,
+	 -46, 61, -804, 2735, 29532, 1893, -652, 48,
+	 -46, 61, -800, 2711, 29533, 1916, -656, 49,
+	 -46, 60, -796, 2687, 29535, 1938, -660, 49,
+	 -46, 60, -791, 2662, 29537, 1961, -664, 49,
+	 -46, 60, -787, 2638, 29538, 1983, -668, 50,
+	 -46, 59, -783, 2614, 29540, 2006, -672, 50,
+	 -46, 59, -778, 2590, 29541, 2029, -677, 50,
+	 -47, 59, -774, 2566, 29542, 2052, -681, 51,
+	 -47, 58, -770, 2542, 29543, 2074, -685, 51,
+	 -47, 58, -765, 2518, 29544, 2097, -689, 52,
+	 -47, 58, -761, 2494, 29545, 2120, -693, 52,
+	 -47, 57, -757, 2471, 29546, 2143, -697, 52,
+	 -47, 57, -752, 2447, 29547, 2166, -702, 53,
+	 -47, 56, -748, 2423, 29547, 2189, -706, 53,
+	 -48, 56, -744, 2400, 29548, 2213, -710, 53,
+	 -48, 56, -740, 2376, 29548, 2236, -714, 54,
+	 -48, 55, -735, 2353, 29549, 2259, -718, 54,
+	 -48, 55, -731, 2329, 29549, 2282, -723, 54,
+	 -48, 55, -727, 2306, 29549, 2306, -727, 55,
+};
+
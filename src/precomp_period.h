@@ -0,0 +1,422 @@
+/* Precomputed powers of two for the period conversion in period.c,
+ * rounded to the nearest double. Periods are computed from note offsets
+ * in 1/12800 semitones, 153600 per octave, split in 1536 steps of 1/128
+ * semitone and 100 fine steps.
+ */
+
+/* 2^(-i/1536) */
+static const double pow2_coarse[1536] = {
+	1.0, 0.9995488341102751, 0.9990978717712101, 0.9986471128909702,
+	0.9981965573777615, 0.9977462051398317, 0.9972960560854701, 0.9968461101230072,
+	0.9963963671608146, 0.9959468271073058, 0.9954974898709352, 0.9950483553601986,
+	0.9945994234836332, 0.9941506941498173, 0.9937021672673705, 0.9932538427449537,
+	0.9928057204912689, 0.9923578004150595, 0.9919100824251097, 0.9914625664302452,
+	0.9910152523393327, 0.99056814006128, 0.9901212295050361, 0.9896745205795909,
+	0.9892280131939755, 0.988781707257262, 0.9883356026785635, 0.9878896993670342,
+	0.9874439972318692, 0.9869984961823044, 0.9865531961276172, 0.9861080969771252,
+	0.9856631986401876, 0.9852185010262039, 0.9847740040446149, 0.9843297076049021,
+	0.9838856116165879, 0.9834417159892354, 0.9829980206324483, 0.9825545254558719,
+	0.9821112303691913, 0.9816681352821329, 0.9812252401044637, 0.9807825447459914,
+	0.9803400491165644, 0.9798977531260716, 0.9794556566844431, 0.979013759701649,
+	0.9785720620877001, 0.9781305637526484, 0.9776892646065857, 0.9772481645596449,
+	0.9768072635219993, 0.9763665614038626, 0.9759260581154892, 0.9754857535671737,
+	0.9750456476692515, 0.9746057403320985, 0.9741660314661305, 0.9737265209818042,
+	0.9732872087896166, 0.9728480948001051, 0.9724091789238475, 0.9719704610714616,
+	0.9715319411536059, 0.9710936190809791, 0.9706554947643202, 0.9702175681144084,
+	0.9697798390420633, 0.9693423074581445, 0.9689049732735522, 0.9684678363992263,
+	0.9680308967461472, 0.9675941542253355, 0.9671576087478517, 0.9667212602247968,
+	0.9662851085673114, 0.9658491536865766, 0.9654133954938136, 0.9649778339002832,
+	0.9645424688172868, 0.9641073001561653, 0.9636723278283, 0.963237551745112,
+	0.9628029718180625, 0.9623685879586523, 0.9619344000784226, 0.9615004080889542,
+	0.9610666119018678, 0.9606330114288242, 0.9601996065815237, 0.9597663972717069,
+	0.9593333834111536, 0.9589005649116841, 0.9584679416851579, 0.9580355136434747,
+	0.9576032806985737, 0.9571712427624337, 0.9567393997470737, 0.9563077515645518,
+	0.9558762981269664, 0.955445039346455, 0.9550139751351949, 0.9545831054054033,
+	0.9541524300693366, 0.9537219490392912, 0.9532916622276026, 0.9528615695466464,
+	0.9524316709088371, 0.9520019662266292, 0.9515724554125168, 0.9511431383790327,
+	0.9507140150387502, 0.9502850853042812, 0.9498563490882777, 0.9494278063034304,
+	0.9489994568624698, 0.948571300678166, 0.9481433376633279, 0.9477155677308042,
+	0.9472879907934828, 0.9468606067642907, 0.9464334155561944, 0.9460064170821996,
+	0.9455796112553512, 0.9451529979887333, 0.9447265771954696, 0.9443003487887224,
+	0.9438743126816935, 0.9434484687876239, 0.9430228170197937, 0.942597357291522,
+	0.9421720895161673, 0.9417470136071266, 0.9413221294778368, 0.9408974370417731,
+	0.9404729362124502, 0.9400486269034217, 0.9396245090282801, 0.939200582500657,
+	0.9387768472342228, 0.9383533031426873, 0.9379299501397985, 0.9375067881393441,
+	0.93708381705515, 0.9366610368010814, 0.9362384472910423, 0.9358160484389756,
+	0.9353938401588627, 0.9349718223647242, 0.9345499949706193, 0.9341283578906459,
+	0.9337069110389409, 0.9332856543296796, 0.9328645876770765, 0.9324437109953841,
+	0.9320230241988945, 0.9316025272019377, 0.9311822199188826, 0.9307621022641368,
+	0.9303421741521466, 0.9299224354973966, 0.9295028862144102, 0.9290835262177494,
+	0.9286643554220145, 0.9282453737418447, 0.9278265810919174, 0.9274079773869486,
+	0.9269895625416927, 0.9265713364709429, 0.9261532990895304, 0.925735450312325,
+	0.9253177900542349, 0.9249003182302067, 0.9244830347552254, 0.9240659395443145,
+	0.9236490325125355, 0.9232323135749884, 0.9228157826468114, 0.9223994396431814,
+	0.921983284479313, 0.9215673170704594, 0.9211515373319118, 0.9207359451789999,
+	0.9203205405270914, 0.9199053232915925, 0.9194902933879469, 0.919075450731637,
+	0.9186607952381833, 0.9182463268231442, 0.9178320454021164, 0.9174179508907345,
+	0.9170040432046712, 0.9165903222596374, 0.9161767879713819, 0.9157634402556915,
+	0.9153502790283908, 0.914937304205343, 0.9145245157024486, 0.9141119134356465,
+	0.9136994973209132, 0.9132872672742631, 0.9128752232117489, 0.9124633650494606,
+	0.9120516927035267, 0.9116402060901129, 0.9112289051254232, 0.9108177897256993,
+	0.9104068598072204, 0.9099961152863036, 0.9095855560793042, 0.9091751821026148,
+	0.9087649932726656, 0.9083549895059249, 0.9079451707188984, 0.9075355368281295,
+	0.9071260877501994, 0.9067168234017269, 0.9063077436993682, 0.9058988485598175,
+	0.9054901378998061, 0.9050816116361035, 0.904673269685516, 0.9042651119648879,
+	0.903857138391101, 0.9034493488810745, 0.9030417433517651, 0.9026343217201671,
+	0.902227083903312, 0.9018200298182687, 0.9014131593821441, 0.9010064725120815,
+	0.9005999691252627, 0.9001936491389061, 0.8997875124702676, 0.8993815590366405,
+	0.8989757887553556, 0.8985702015437805, 0.8981647973193206, 0.8977595759994185,
+	0.8973545375015536, 0.896949681743243, 0.8965450086420408, 0.8961405181155383,
+	0.8957362100813642, 0.8953320844571839, 0.8949281411607005, 0.8945243801096538,
+	0.894120801221821, 0.8937174044150161, 0.8933141896070906, 0.8929111567159326,
+	0.8925083056594675, 0.8921056363556578, 0.8917031487225027, 0.8913008426780388,
+	0.8908987181403393, 0.8904967750275147, 0.8900950132577122, 0.889693432749116,
+	0.8892920334199473, 0.8888908151884641, 0.8884897779729612, 0.8880889216917706,
+	0.8876882462632606, 0.8872877516058368, 0.8868874376379415, 0.8864873042780538,
+	0.8860873514446893, 0.8856875790564007, 0.8852879870317774, 0.8848885752894454,
+	0.8844893437480674, 0.8840902923263432, 0.8836914209430086, 0.8832927295168365,
+	0.8828942179666364, 0.8824958862112545, 0.8820977341695734, 0.8816997617605123,
+	0.8813019689030274, 0.8809043555161109, 0.880506921518792, 0.8801096668301359,
+	0.879712591369245, 0.8793156950552576, 0.8789189778073488, 0.8785224395447303,
+	0.8781260801866497, 0.8777298996523917, 0.8773338978612768, 0.8769380747326623,
+	0.8765424301859419, 0.8761469641405454, 0.8757516765159391, 0.8753565672316257,
+	0.874961636207144, 0.8745668833620694, 0.8741723086160134, 0.8737779118886237,
+	0.8733836930995845, 0.8729896521686159, 0.8725957890154746, 0.8722021035599532,
+	0.8718085957218806, 0.8714152654211218, 0.8710221125775782, 0.8706291371111871,
+	0.8702363389419218, 0.8698437179897921, 0.8694512741748436, 0.869059007417158,
+	0.8686669176368531, 0.8682750047540828, 0.8678832686890371, 0.8674917093619415,
+	0.8671003266930583, 0.866709120602685, 0.8663180910111555, 0.8659272378388396,
+	0.8655365610061431, 0.8651460604335072, 0.8647557360414097, 0.8643655877503638,
+	0.8639756154809188, 0.8635858191536596, 0.8631961986892074, 0.8628067540082185,
+	0.8624174850313857, 0.8620283916794371, 0.861639473873137, 0.8612507315332848,
+	0.8608621645807164, 0.8604737729363028, 0.860085556520951, 0.8596975152556036,
+	0.859309649061239, 0.858921957858871, 0.8585344415695493, 0.858147100114359,
+	0.857759933414421, 0.8573729413908917, 0.856986123964963, 0.8565994810578624,
+	0.856213012590853, 0.8558267184852334, 0.8554405986623376, 0.8550546530435352,
+	0.8546688815502315, 0.8542832841038666, 0.8538978606259167, 0.8535126110378932,
+	0.8531275352613428, 0.8527426332178477, 0.8523579048290256, 0.8519733500165293,
+	0.8515889687020471, 0.8512047608073028, 0.850820726254055, 0.8504368649640982,
+	0.8500531768592617, 0.8496696618614105, 0.8492863198924445, 0.848903150874299,
+	0.8485201547289445, 0.8481373313783866, 0.8477546807446663, 0.8473722027498597,
+	0.8469898973160779, 0.8466077643654671, 0.8462258038202092, 0.8458440156025204,
+	0.8454623996346526, 0.8450809558388924, 0.8446996841375618, 0.8443185844530174,
+	0.8439376567076514, 0.8435569008238905, 0.8431763167241967, 0.8427959043310668,
+	0.8424156635670327, 0.8420355943546612, 0.8416556966165541, 0.8412759702753481,
+	0.8408964152537145, 0.8405170314743601, 0.8401378188600259, 0.8397587773334884,
+	0.8393799068175584, 0.8390012072350818, 0.8386226785089392, 0.8382443205620462,
+	0.837866133317353, 0.8374881166978445, 0.8371102706265404, 0.8367325950264953,
+	0.8363550898207983, 0.8359777549325733, 0.8356005902849789, 0.8352235958012082,
+	0.8348467714044893, 0.8344701170180846, 0.8340936325652912, 0.833717317969441,
+	0.8333411731539002, 0.8329651980420698, 0.8325893925573853, 0.8322137566233165,
+	0.8318382901633682, 0.8314629931010794, 0.8310878653600235, 0.8307129068638088,
+	0.8303381175360776, 0.8299634973005069, 0.8295890460808081, 0.8292147638007269,
+	0.8288406503840436, 0.8284667057545729, 0.8280929298361637, 0.8277193225526992,
+	0.8273458838280972, 0.8269726135863096, 0.8265995117513227, 0.8262265782471573,
+	0.825853812997868, 0.8254812159275441, 0.8251087869603089, 0.8247365260203201,
+	0.8243644330317694, 0.823992507918883, 0.8236207506059211, 0.823249161017178,
+	0.8228777390769825, 0.8225064847096969, 0.8221353978397183, 0.8217644783914776,
+	0.8213937262894397, 0.8210231414581038, 0.8206527238220032, 0.8202824733057048,
+	0.81991238983381, 0.8195424733309541, 0.8191727237218064, 0.81880314093107,
+	0.8184337248834822, 0.8180644755038142, 0.8176953927168712, 0.8173264764474921,
+	0.8169577266205499, 0.8165891431609514, 0.8162207259936375, 0.8158524750435827,
+	0.8154843902357953, 0.8151164714953177, 0.8147487187472261, 0.8143811319166303,
+	0.8140137109286739, 0.8136464557085344, 0.8132793661814232, 0.812912442272585,
+	0.8125456839072985, 0.8121790910108764, 0.8118126635086644, 0.8114464013260425,
+	0.8110803043884242, 0.8107143726212563, 0.8103486059500199, 0.8099830043002291,
+	0.8096175675974319, 0.8092522957672098, 0.8088871887351781, 0.8085222464269852,
+	0.8081574687683136, 0.8077928556848788, 0.8074284071024304, 0.8070641229467508,
+	0.8067000031436564, 0.8063360476189969, 0.8059722562986557, 0.805608629108549,
+	0.8052451659746271, 0.8048818668228734, 0.8045187315793049, 0.8041557601699715,
+	0.803792952520957, 0.8034303085583782, 0.8030678282083855, 0.8027055113971623,
+	0.8023433580509257, 0.8019813680959258, 0.8016195414584459, 0.8012578780648029,
+	0.8008963778413467, 0.8005350407144604, 0.8001738666105604, 0.7998128554560965,
+	0.7994520071775512, 0.7990913217014405, 0.7987307989543135, 0.7983704388627526,
+	0.798010241353373, 0.7976502063528231, 0.7972903337877847, 0.7969306235849722,
+	0.7965710756711335, 0.7962116899730491, 0.795852466417533, 0.795493404931432,
+	0.7951345054416257, 0.7947757678750271, 0.794417192158582, 0.794058778219269,
+	0.7937005259840998, 0.793342435380119, 0.7929845063344041, 0.7926267387740656,
+	0.7922691326262469, 0.7919116878181239, 0.7915544042769058, 0.7911972819298346,
+	0.7908403207041848, 0.7904835205272639, 0.7901268813264123, 0.789770403029003,
+	0.789414085562442, 0.7890579288541678, 0.7887019328316518, 0.788346097422398,
+	0.7879904225539432, 0.787634908153857, 0.7872795541497413, 0.7869243604692311,
+	0.7865693270399937, 0.7862144537897293, 0.7858597406461707, 0.785505187537083,
+	0.7851507943902643, 0.784796561133545, 0.7844424876947881, 0.7840885740018891,
+	0.7837348199827765, 0.7833812255654105, 0.7830277906777845, 0.782674515247924,
+	0.7823213992038871, 0.7819684424737644, 0.7816156449856788, 0.7812630066677859,
+	0.7809105274482735, 0.7805582072553617, 0.7802060460173033, 0.779854043662383,
+	0.7795022001189185, 0.7791505153152593, 0.7787989891797874, 0.7784476216409172,
+	0.7780964126270953, 0.7777453620668006, 0.7773944698885443, 0.7770437360208697,
+	0.7766931603923527, 0.776342742931601, 0.7759924835672547, 0.7756423822279862,
+	0.7752924388425, 0.7749426533395326, 0.7745930256478528, 0.7742435556962617,
+	0.7738942434135921, 0.7735450887287094, 0.7731960915705107, 0.7728472518679255,
+	0.772498569549915, 0.7721500445454728, 0.7718016767836242, 0.7714534661934269,
+	0.7711054127039704, 0.770757516244376, 0.7704097767437975, 0.7700621941314201,
+	0.7697147683364612, 0.7693674992881703, 0.7690203869158284, 0.768673431148749,
+	0.7683266319162768, 0.7679799891477889, 0.767633502772694, 0.767287172720433,
+	0.766940998920478, 0.7665949813023335, 0.7662491197955356, 0.765903414329652,
+	0.7655578648342826, 0.7652124712390587, 0.7648672334736435, 0.764522151467732,
+	0.7641772251510506, 0.7638324544533577, 0.7634878393044434, 0.7631433796341295,
+	0.7627990753722692, 0.7624549264487475, 0.7621109327934811, 0.7617670943364181,
+	0.7614234110075386, 0.761079882736854, 0.7607365094544073, 0.760393291090273,
+	0.7600502275745574, 0.7597073188373981, 0.7593645648089642, 0.7590219654194567,
+	0.7586795205991074, 0.7583372302781801, 0.7579950943869701, 0.7576531128558038,
+	0.7573112856150395, 0.7569696125950661, 0.7566280937263049, 0.756286728939208,
+	0.755945518164259, 0.7556044613319728, 0.7552635583728958, 0.7549228092176057,
+	0.7545822137967114, 0.7542417720408532, 0.7539014838807027, 0.7535613492469626,
+	0.7532213680703672, 0.752881540281682, 0.7525418658117032, 0.752202344591259,
+	0.7518629765512084, 0.7515237616224414, 0.7511846997358795, 0.7508457908224754,
+	0.7505070348132128, 0.7501684316391064, 0.7498299812312024, 0.7494916835205777,
+	0.7491535384383408, 0.7488155459156306, 0.7484777058836177, 0.7481400182735034,
+	0.7478024830165202, 0.7474651000439315, 0.7471278692870319, 0.7467907906771467,
+	0.7464538641456324, 0.7461170896238766, 0.7457804670432974, 0.7454439963353443,
+	0.7451076774314975, 0.7447715102632683, 0.7444354947621985, 0.7440996308598613,
+	0.7437639184878604, 0.7434283575778305, 0.7430929480614371, 0.7427576898703767,
+	0.7424225829363762, 0.7420876271911938, 0.7417528225666182, 0.741418168994469,
+	0.7410836664065964, 0.7407493147348814, 0.7404151139112359, 0.7400810638676023,
+	0.7397471645359539, 0.7394134158482946, 0.7390798177366588, 0.7387463701331118,
+	0.7384130729697497, 0.7380799261786988, 0.7377469296921162, 0.7374140834421897,
+	0.7370813873611378, 0.7367488413812093, 0.7364164454346838, 0.7360841994538712,
+	0.7357521033711121, 0.7354201571187776, 0.7350883606292695, 0.7347567138350197,
+	0.7344252166684909, 0.7340938690621763, 0.7337626709485993, 0.7334316222603138,
+	0.7331007229299042, 0.7327699728899856, 0.7324393720732029, 0.732108920412232,
+	0.7317786178397786, 0.7314484642885791, 0.7311184596914004, 0.7307886039810395,
+	0.7304588970903235, 0.7301293389521102, 0.7297999294992876, 0.7294706686647738,
+	0.7291415563815175, 0.7288125925824972, 0.7284837772007219, 0.728155110169231,
+	0.7278265914210936, 0.7274982208894097, 0.7271699985073088, 0.7268419242079509,
+	0.7265139979245263, 0.726186219590255, 0.7258585891383876, 0.7255311065022044,
+	0.7252037716150163, 0.7248765844101637, 0.7245495448210175, 0.7242226527809785,
+	0.7238959082234776, 0.7235693110819758, 0.7232428612899637, 0.7229165587809626,
+	0.7225904034885233, 0.7222643953462267, 0.7219385342876836, 0.7216128202465351,
+	0.7212872531564516, 0.7209618329511339, 0.7206365595643128, 0.7203114329297486,
+	0.7199864529812319, 0.7196616196525827, 0.7193369328776512, 0.7190123925903175,
+	0.7186879987244912, 0.718363751214112, 0.7180396499931493, 0.7177156949956024,
+	0.7173918861555001, 0.7170682234069012, 0.7167447066838945, 0.7164213359205978,
+	0.7160981110511592, 0.7157750320097565, 0.7154520987305968, 0.7151293111479174,
+	0.714806669195985, 0.7144841728090958, 0.7141618219215761, 0.7138396164677812,
+	0.7135175563820966, 0.7131956415989371, 0.7128738720527471, 0.7125522476780008,
+	0.7122307684092016, 0.7119094341808828, 0.711588244927607, 0.7112672005839664,
+	0.7109463010845828, 0.7106255463641072, 0.7103049363572207, 0.709984470998633,
+	0.709664150223084, 0.7093439739653427, 0.7090239421602076, 0.7087040547425066,
+	0.708384311647097, 0.7080647128088655, 0.7077452581627283, 0.7074259476436306,
+	0.7071067811865476, 0.7067877587264829, 0.7064688801984704, 0.7061501455375727,
+	0.7058315546788818, 0.7055131075575192, 0.7051948041086353, 0.7048766442674103,
+	0.704558627969053, 0.7042407551488019, 0.7039230257419247, 0.7036054396837179,
+	0.7032879969095077, 0.7029706973546491, 0.7026535409545266, 0.7023365276445535,
+	0.7020196573601724, 0.701702930036855, 0.7013863456101024, 0.7010699040154442,
+	0.7007536051884398, 0.7004374490646769, 0.7001214355797729, 0.6998055646693742,
+	0.6994898362691556, 0.6991742503148216, 0.6988588067421055, 0.6985435054867697,
+	0.6982283464846051, 0.6979133296714322, 0.6975984549831001, 0.6972837223554869,
+	0.6969691317244996, 0.6966546830260744, 0.6963403761961758, 0.6960262111707979,
+	0.6957121878859631, 0.695398306277723, 0.695084566282158, 0.6947709678353773,
+	0.6944575108735187, 0.6941441953327493, 0.6938310211492645, 0.693517988259289,
+	0.6932050965990757, 0.6928923461049067, 0.6925797367130927, 0.6922672683599731,
+	0.691954940981916, 0.6916427545153183, 0.6913307088966055, 0.691018804062232,
+	0.6907070399486807, 0.6903954164924629, 0.690083933630119, 0.6897725912982179,
+	0.689461389433357, 0.6891503279721622, 0.6888394068512884, 0.6885286260074188,
+	0.6882179853772651, 0.6879074848975676, 0.6875971245050954, 0.6872869041366456,
+	0.6869768237290446, 0.6866668832191464, 0.6863570825438342, 0.6860474216400193,
+	0.6857379004446416, 0.6854285188946693, 0.6851192769270993, 0.6848101744789568,
+	0.6845012114872953, 0.6841923878891968, 0.6838837036217718, 0.6835751586221589,
+	0.6832667528275252, 0.6829584861750663, 0.682650358602006, 0.6823423700455962,
+	0.6820345204431175, 0.6817268097318787, 0.6814192378492167, 0.6811118047324967,
+	0.6808045103191124, 0.6804973545464855, 0.680190337352066, 0.6798834586733323,
+	0.6795767184477907, 0.6792701166129758, 0.6789636531064506, 0.6786573278658058,
+	0.6783511408286609, 0.678045091932663, 0.6777391811154876, 0.6774334083148381,
+	0.6771277734684463, 0.676822276514072, 0.6765169173895028, 0.6762116960325548,
+	0.6759066123810719, 0.675601666372926, 0.6752968579460172, 0.6749921870382735,
+	0.674687653587651, 0.6743832575321337, 0.6740789988097335, 0.6737748773584907,
+	0.6734708931164729, 0.6731670460217761, 0.6728633360125242, 0.6725597630268688,
+	0.6722563270029897, 0.6719530278790941, 0.6716498655934177, 0.6713468400842235,
+	0.6710439512898029, 0.6707411991484746, 0.6704385835985857, 0.6701361045785105,
+	0.6698337620266515, 0.669531555881439, 0.6692294860813307, 0.6689275525648127,
+	0.6686257552703982, 0.6683240941366286, 0.6680225691020729, 0.6677211801053275,
+	0.6674199270850172, 0.6671188099797937, 0.666817828728337, 0.6665169832693543,
+	0.6662162735415808, 0.665915699483779, 0.6656152610347397, 0.6653149581332805,
+	0.6650147907182469, 0.6647147587285123, 0.6644148621029772, 0.66411510078057,
+	0.6638154747002466, 0.6635159838009903, 0.6632166280218119, 0.6629174073017501,
+	0.6626183215798707, 0.662319370795267, 0.6620205548870601, 0.6617218737943983,
+	0.6614233274564574, 0.6611249158124406, 0.6608266388015788, 0.6605284963631299,
+	0.6602304884363795, 0.6599326149606406, 0.6596348758752534, 0.6593372711195855,
+	0.659039800633032, 0.6587424643550153, 0.6584452622249849, 0.658148194182418,
+	0.6578512601668188, 0.6575544601177189, 0.6572577939746773, 0.6569612616772801,
+	0.6566648631651406, 0.6563685983778996, 0.656072467255225, 0.6557764697368117,
+	0.6554806057623822, 0.6551848752716859, 0.6548892782044996, 0.6545938145006271,
+	0.6542984840998995, 0.6540032869421749, 0.6537082229673387, 0.6534132921153031,
+	0.6531184943260078, 0.6528238295394193, 0.6525292976955315, 0.6522348987343651,
+	0.6519406325959679, 0.651646499220415, 0.651352498547808, 0.6510586305182761,
+	0.6507648950719752, 0.6504712921490883, 0.6501778216898253, 0.6498844836344232,
+	0.6495912779231459, 0.6492982044962841, 0.6490052632941556, 0.6487124542571054,
+	0.6484197773255048, 0.6481272324397526, 0.6478348195402739, 0.6475425385675212,
+	0.6472503894619736, 0.6469583721641372, 0.6466664866145447, 0.646374732753756,
+	0.6460831105223573, 0.6457916198609623, 0.6455002607102108, 0.6452090330107698,
+	0.6449179367033329, 0.6446269717286206, 0.6443361380273799, 0.6440454355403848,
+	0.643754864208436, 0.6434644239723606, 0.6431741147730128, 0.6428839365512732,
+	0.642593889248049, 0.6423039728042746, 0.6420141871609105, 0.6417245322589441,
+	0.6414350080393891, 0.6411456144432863, 0.6408563514117027, 0.6405672188857322,
+	0.640278216806495, 0.6399893451151379, 0.6397006037528347, 0.6394119926607849,
+	0.6391235117802153, 0.6388351610523788, 0.638546940418555, 0.63825884982005,
+	0.637970889198196, 0.6376830584943524, 0.6373953576499042, 0.6371077866062635,
+	0.6368203453048686, 0.6365330336871842, 0.6362458516947014, 0.6359587992689377,
+	0.6356718763514372, 0.6353850828837699, 0.6350984188075327, 0.6348118840643485,
+	0.6345254785958666, 0.6342392023437627, 0.6339530552497389, 0.6336670372555233,
+	0.6333811483028705, 0.6330953883335615, 0.6328097572894031, 0.6325242551122291,
+	0.6322388817438988, 0.631953637126298, 0.631668521201339, 0.63138353391096,
+	0.6310986751971254, 0.6308139450018257, 0.6305293432670781, 0.6302448699349253,
+	0.6299605249474366, 0.6296763082467071, 0.6293922197748583, 0.6291082594740375,
+	0.6288244272864186, 0.6285407231542012, 0.6282571470196109, 0.6279736988248997,
+	0.6276903785123455, 0.6274071860242523, 0.6271241213029498, 0.6268411842907942,
+	0.6265583749301673, 0.6262756931634773, 0.6259931389331581, 0.6257107121816696,
+	0.6254284128514978, 0.6251462408851544, 0.6248641962251772, 0.62458227881413,
+	0.6243004885946024, 0.6240188255092098, 0.6237372895005939, 0.6234558805114218,
+	0.6231745984843865, 0.6228934433622073, 0.622612415087629, 0.6223315136034222,
+	0.6220507388523834, 0.621770090777335, 0.6214895693211251, 0.6212091744266275,
+	0.620928906036742, 0.6206487640943941, 0.6203687485425347, 0.6200888593241409,
+	0.6198090963822154, 0.6195294596597866, 0.6192499490999083, 0.6189705646456605,
+	0.6186913062401486, 0.6184121738265036, 0.6181331673478825, 0.6178542867474675,
+	0.6175755319684667, 0.6172969029541138, 0.617018399647668, 0.6167400219924143,
+	0.6164617699316631, 0.6161836434087504, 0.6159056423670379, 0.6156277667499128,
+	0.6153500165007877, 0.6150723915631009, 0.614794891880316, 0.6145175173959225,
+	0.614240268053435, 0.6139631437963938, 0.6136861445683646, 0.6134092703129385,
+	0.6131325209737322, 0.6128558964943878, 0.6125793968185728, 0.6123030218899799,
+	0.6120267716523277, 0.6117506460493596, 0.6114746450248449, 0.611198768522578,
+	0.6109230164863788, 0.6106473888600922, 0.6103718855875889, 0.6100965066127647,
+	0.6098212518795407, 0.6095461213318633, 0.6092711149137042, 0.6089962325690604,
+	0.6087214742419542, 0.6084468398764332, 0.60817232941657, 0.6078979428064627,
+	0.6076236799902345, 0.6073495409120337, 0.607075525516034, 0.6068016337464344,
+	0.6065278655474586, 0.6062542208633559, 0.6059806996384006, 0.6057073018168921,
+	0.605434027343155, 0.6051608761615389, 0.6048878482164187, 0.6046149434521944,
+	0.6043421618132908, 0.604069503244158, 0.6037969676892712, 0.6035245550931304,
+	0.6032522654002609, 0.6029800985552131, 0.6027080545025619, 0.6024361331869079,
+	0.6021643345528761, 0.601892658545117, 0.6016211051083056, 0.601349674187142,
+	0.6010783657263515, 0.6008071796706842, 0.600536115964915, 0.6002651745538437,
+	0.5999943553822952, 0.5997236583951192, 0.5994530835371903, 0.5991826307534078,
+	0.5989122999886962, 0.5986420911880046, 0.598372004296307, 0.5981020392586021,
+	0.5978321960199137, 0.5975624745252901, 0.5972928747198047, 0.5970233965485554,
+	0.5967540399566649, 0.5964848048892809, 0.5962156912915756, 0.5959466991087461,
+	0.595677828286014, 0.5954090787686259, 0.5951404505018529, 0.594871943430991,
+	0.5946035575013605, 0.5943352926583068, 0.5940671488471997, 0.5937991260134337,
+	0.5935312241024279, 0.5932634430596262, 0.5929957828304969, 0.5927282433605331,
+	0.5924608245952522, 0.5921935264801965, 0.5919263489609327, 0.5916592919830521,
+	0.5913923554921705, 0.5911255394339283, 0.5908588437539904, 0.5905922683980463,
+	0.5903258133118099, 0.5900594784410195, 0.5897932637314379, 0.5895271691288528,
+	0.5892611945790758, 0.5889953400279431, 0.5887296054213155, 0.5884639907050782,
+	0.5881984958251406, 0.5879331207274368, 0.587667865357925, 0.5874027296625881,
+	0.5871377135874329, 0.5868728170784913, 0.5866080400818187, 0.5863433825434953,
+	0.5860788444096258, 0.5858144256263387, 0.5855501261397873, 0.5852859458961488,
+	0.5850218848416251, 0.584757942922442, 0.5844941200848496, 0.5842304162751225,
+	0.5839668314395594, 0.5837033655244831, 0.5834400184762408, 0.5831767902412038,
+	0.5829136807657677, 0.5826506899963522, 0.5823878178794011, 0.5821250643613826,
+	0.5818624293887887, 0.5815999129081361, 0.5813375148659649, 0.5810752352088399,
+	0.5808130738833498, 0.5805510308361073, 0.5802891060137494, 0.580027299362937,
+	0.5797656108303552, 0.579504040362713, 0.5792425879067434, 0.5789812534092039,
+	0.5787200368168756, 0.5784589380765633, 0.5781979571350967, 0.5779370939393287,
+	0.5776763484361365, 0.5774157205724213, 0.577155210295108, 0.5768948175511458,
+	0.5766345422875077, 0.5763743844511904, 0.5761143439892148, 0.5758544208486256,
+	0.5755946149764913, 0.5753349263199046, 0.5750753548259816, 0.5748159004418627,
+	0.5745565631147118, 0.5742973427917168, 0.5740382394200895, 0.5737792529470654,
+	0.5735203833199038, 0.5732616304858879, 0.5730029943923245, 0.5727444749865445,
+	0.5724860722159021, 0.5722277860277757, 0.5719696163695671, 0.5717115631887021,
+	0.57145362643263, 0.571195806048824, 0.5709381019847808, 0.570680514188021,
+	0.5704230426060887, 0.5701656871865517, 0.5699084478770015, 0.5696513246250533,
+	0.5693943173783458, 0.5691374260845415, 0.5688806506913263, 0.5686239911464098,
+	0.5683674473975253, 0.5681110193924295, 0.5678547070789027, 0.567598510404749,
+	0.5673424293177957, 0.5670864637658938, 0.5668306136969179, 0.566574879058766,
+	0.5663192597993596, 0.5660637558666438, 0.5658083672085872, 0.5655530937731817,
+	0.5652979355084429, 0.5650428923624096, 0.564787964283144, 0.5645331512187324,
+	0.5642784531172835, 0.5640238699269302, 0.5637694015958286, 0.5635150480721578,
+	0.5632608093041209, 0.563006685239944, 0.5627526758278767, 0.5624987810161917,
+	0.5622450007531853, 0.5619913349871771, 0.56173778366651, 0.5614843467395498,
+	0.5612310241546865, 0.5609778158603325, 0.5607247218049239, 0.56047174193692,
+	0.5602188762048034, 0.5599661245570797, 0.5597134869422781, 0.5594609633089507,
+	0.559208553605673, 0.5589562577810437, 0.5587040757836846, 0.5584520075622407,
+	0.5582000530653802, 0.5579482122417945, 0.5576964850401979, 0.5574448714093283,
+	0.5571933712979462, 0.5569419846548358, 0.5566907114288038, 0.5564395515686804,
+	0.5561885050233187, 0.5559375717415951, 0.5556867516724088, 0.5554360447646821,
+	0.5551854509673606, 0.5549349702294125, 0.5546846024998295, 0.5544343477276259,
+	0.5541842058618394, 0.5539341768515301, 0.5536842606457819, 0.5534344571937009,
+	0.5531847664444166, 0.5529351883470814, 0.5526857228508706, 0.5524363699049823,
+	0.5521871294586377, 0.5519380014610809, 0.5516889858615787, 0.5514400826094209,
+	0.5511912916539204, 0.5509426129444128, 0.5506940464302563, 0.5504455920608324,
+	0.5501972497855451, 0.5499490195538214, 0.549700901315111, 0.5494528950188865,
+	0.5492050006146434, 0.5489572180518997, 0.5487095472801964, 0.5484619882490971,
+	0.5482145409081884, 0.5479672052070794, 0.5477199810954021, 0.5474728685228111,
+	0.5472258674389836, 0.54697897779362, 0.5467321995364429, 0.5464855326171978,
+	0.5462389769856527, 0.5459925325915985, 0.5457461993848487, 0.5454999773152392,
+	0.5452538663326288, 0.5450078663868989, 0.5447619774279534, 0.5445161994057187,
+	0.5442705322701442, 0.5440249759712015, 0.5437795304588848, 0.5435341956832112,
+	0.5432889715942197, 0.5430438581419728, 0.5427988552765545, 0.5425539629480719,
+	0.5423091811066546, 0.5420645097024547, 0.5418199486856464, 0.5415754980064269,
+	0.5413311576150156, 0.5410869274616544, 0.5408428074966076, 0.5405987976701621,
+	0.5403548979326269, 0.540111108234334, 0.5398674285256371, 0.5396238587569128,
+	0.5393803988785599, 0.5391370488409997, 0.5388938085946756, 0.5386506780900537,
+	0.5384076572776223, 0.5381647461078919, 0.5379219445313955, 0.5376792524986884,
+	0.5374366699603482, 0.5371941968669748, 0.5369518331691902, 0.5367095788176389,
+	0.5364674337629878, 0.5362253979559256, 0.5359834713471637, 0.5357416538874356,
+	0.5354999455274967, 0.5352583462181251, 0.5350168559101209, 0.5347754745543063,
+	0.534534202101526, 0.5342930385026464, 0.5340519837085566, 0.5338110376701672,
+	0.5335702003384118, 0.5333294716642454, 0.5330888515986455, 0.5328483400926115,
+	0.5326079370971651, 0.5323676425633501, 0.5321274564422322, 0.5318873786848994,
+	0.5316474092424616, 0.5314075480660507, 0.531167795106821, 0.5309281503159483,
+	0.530688613644631, 0.5304491850440891, 0.5302098644655648, 0.5299706518603223,
+	0.5297315471796477, 0.529492550374849, 0.5292536613972564, 0.5290148801982218,
+	0.5287762067291195, 0.5285376409413451, 0.5282991827863167, 0.528060832215474,
+	0.5278225891802786, 0.5275844536322142, 0.5273464255227861, 0.5271085048035218,
+	0.5268706914259705, 0.5266329853417033, 0.5263953865023132, 0.5261578948594148,
+	0.5259205103646447, 0.5256832329696615, 0.5254460626261451, 0.525208999285798,
+	0.5249720429003436, 0.5247351934215277, 0.5244984508011178, 0.5242618149909027,
+	0.5240252859426935, 0.5237888636083228, 0.5235525479396449, 0.523316338888536,
+	0.5230802364068937, 0.5228442404466377, 0.522608350959709, 0.5223725678980705,
+	0.5221368912137069, 0.5219013208586243, 0.5216658567848504, 0.5214304989444349,
+	0.521195247289449, 0.5209601017719853, 0.520725062344158, 0.5204901289581035,
+	0.5202553015659791, 0.5200205801199639, 0.5197859645722588, 0.519551454875086,
+	0.5193170509806894, 0.5190827528413343, 0.5188485604093078, 0.5186144736369183,
+	0.5183804924764956, 0.5181466168803914, 0.5179128468009786, 0.5176791821906516,
+	0.5174456230018265, 0.5172121691869406, 0.5169788206984528, 0.5167455774888434,
+	0.5165124395106142, 0.5162794067162884, 0.5160464790584106, 0.5158136564895468,
+	0.5155809389622844, 0.5153483264292322, 0.5151158188430205, 0.5148834161563008,
+	0.514651118321746, 0.5144189252920505, 0.5141868370199297, 0.5139548534581208,
+	0.5137229745593819, 0.5134912002764926, 0.5132595305622539, 0.513027965369488,
+	0.5127965046510383, 0.5125651483597695, 0.5123338964485679, 0.5121027488703404,
+	0.5118717055780156, 0.5116407665245435, 0.511409931662895, 0.5111792009460621,
+	0.5109485743270583, 0.5107180517589184, 0.5104876331946979, 0.5102573185874741,
+	0.5100271078903449, 0.5097970010564297, 0.509566998038869, 0.5093370987908243,
+	0.5091073032654784, 0.5088776114160352, 0.5086480231957196, 0.5084185385577776,
+	0.5081891574554765, 0.5079598798421046, 0.507730705670971, 0.5075016348954062,
+	0.5072726674687619, 0.5070438033444101, 0.5068150424757447, 0.5065863848161801,
+	0.506357830319152, 0.5061293789381168, 0.5059010306265523, 0.5056727853379569,
+	0.5054446430258502, 0.5052166036437727, 0.504988667145286, 0.5047608334839724,
+	0.5045331026134353, 0.504305474487299, 0.5040779490592088, 0.5038505262828308,
+	0.503623206111852, 0.5033959884999804, 0.5031688734009448, 0.502941860768495,
+	0.5027149505564014, 0.5024881427184555, 0.5022614372084698, 0.502034833980277,
+	0.5018083329877314, 0.5015819341847076, 0.5013556375251013, 0.5011294429628286,
+	0.5009033504518269, 0.5006773599460541, 0.5004514713994889, 0.5002256847661308,
+};
+
+/* 2^(-i/153600) */
+static const double pow2_fine[100] = {
+	1.0, 0.9999954873332253, 0.9999909746868149, 0.9999864620607685,
+	0.999981949455086, 0.9999774368697674, 0.9999729243048127, 0.9999684117602216,
+	0.999963899235994, 0.9999593867321301, 0.9999548742486296, 0.9999503617854925,
+	0.9999458493427186, 0.9999413369203077, 0.99993682451826, 0.9999323121365753,
+	0.9999277997752534, 0.9999232874342943, 0.9999187751136979, 0.9999142628134641,
+	0.9999097505335928, 0.9999052382740838, 0.9999007260349373, 0.9998962138161529,
+	0.9998917016177308, 0.9998871894396706, 0.9998826772819724, 0.9998781651446361,
+	0.9998736530276615, 0.9998691409310486, 0.9998646288547973, 0.9998601167989075,
+	0.9998556047633792, 0.9998510927482122, 0.9998465807534063, 0.9998420687789615,
+	0.9998375568248778, 0.9998330448911551, 0.9998285329777932, 0.9998240210847921,
+	0.9998195092121517, 0.9998149973598718, 0.9998104855279524, 0.9998059737163933,
+	0.9998014619251947, 0.9997969501543562, 0.9997924384038778, 0.9997879266737595,
+	0.999783414964001, 0.9997789032746025, 0.9997743916055637, 0.9997698799568846,
+	0.999765368328565, 0.9997608567206049, 0.9997563451330042, 0.9997518335657627,
+	0.9997473220188805, 0.9997428104923574, 0.9997382989861933, 0.999733787500388,
+	0.9997292760349417, 0.999724764589854, 0.999720253165125, 0.9997157417607546,
+	0.9997112303767427, 0.9997067190130892, 0.9997022076697939, 0.9996976963468568,
+	0.9996931850442777, 0.9996886737620567, 0.9996841625001937, 0.9996796512586884,
+	0.9996751400375409, 0.999670628836751, 0.9996661176563186, 0.9996616064962437,
+	0.9996570953565261, 0.9996525842371659, 0.9996480731381628, 0.9996435620595168,
+	0.9996390510012277, 0.9996345399632957, 0.9996300289457204, 0.9996255179485019,
+	0.9996210069716398, 0.9996164960151345, 0.9996119850789855, 0.9996074741631928,
+	0.9996029632677566, 0.9995984523926763, 0.9995939415379522, 0.9995894307035841,
+	0.9995849198895719, 0.9995804090959154, 0.9995758983226146, 0.9995713875696696,
+	0.99956687683708, 0.9995623661248458, 0.999557855432967, 0.9995533447614434,
+};
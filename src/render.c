@@ -0,0 +1,283 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2018 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "player.h"
+#include "mixer.h"
+#include "state.h"
+#include "mix_thread.h"
+
+/* Offline module renderer
+ *
+ * The module is first played in mixer bypass mode to find the split
+ * points: the player state is saved right before the first tick of the
+ * order that follows each equal share of the remaining time. Each segment
+ * is then rendered by a private copy of the player, restored from its
+ * split state and sharing the module data, and written at its own offset
+ * of the output buffer. Since restoring a state is exact, the result is
+ * the same as playing all ticks in sequence. Each segment still writes
+ * only to its own part of the buffer.
+ */
+
+struct render_segment {
+	void *state;		/* player state at the start of the segment */
+	int frames;		/* number of ticks in the segment */
+	long offset;		/* output buffer offset in bytes */
+};
+
+struct render_job {
+	char *buffer;
+	long size;		/* output size in bytes */
+	size_t state_size;
+	int framesize;		/* bytes per output frame */
+	int num;		/* number of segments */
+	struct render_segment *seg;
+	struct context_data **clone;
+};
+
+/* Create a player sharing the module data and settings of ctx */
+static struct context_data *clone_player(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct context_data *c;
+
+	c = malloc(sizeof(struct context_data));
+	if (c == NULL) {
+		return NULL;
+	}
+
+	memcpy(c, ctx, sizeof(struct context_data));
+	c->state = XMP_STATE_LOADED;
+	c->p.snapshot.slot = NULL;
+	c->p.snapshot.memory = 0;	/* not needed, we never seek */
+	c->s.numthreads = 1;
+	c->s.bypass = 0;
+
+	if (xmp_start_player((xmp_context)c, s->freq, s->format) < 0) {
+		free(c);
+		return NULL;
+	}
+
+	/* Restore settings reset by xmp_start_player() */
+	c->p.master_vol = p->master_vol;
+	c->p.smix_vol = p->smix_vol;
+	memcpy(c->p.channel_vol, p->channel_vol, sizeof(p->channel_vol));
+	memcpy(c->p.channel_mute, p->channel_mute, sizeof(p->channel_mute));
+	c->s.amplify = s->amplify;
+	c->s.mix = s->mix;
+	c->s.interp = s->interp;
+	c->s.dsp = s->dsp;
+
+	return c;
+}
+
+static void free_player(struct context_data *c)
+{
+	if (c != NULL) {
+		xmp_end_player((xmp_context)c);
+		free(c);
+	}
+}
+
+static void render_segment(struct context_data *ctx, void *arg, int index,
+						int num, int32 *buf32)
+{
+	struct render_job *job = (struct render_job *)arg;
+	struct render_segment *seg = &job->seg[index];
+	struct context_data *c = job->clone[index];
+	char *out = job->buffer + seg->offset;
+	long left;
+	int i, frames;
+
+	left = index + 1 < job->num ? job->seg[index + 1].offset : job->size;
+	left = (left - seg->offset) / job->framesize;
+
+	libxmp_state_restore(c, seg->state, job->state_size);
+
+	for (i = 0; i < seg->frames && left > 0; i++) {
+		libxmp_play_frame(c);
+		frames = c->s.ticksize;
+		if (frames > left) {
+			frames = left;
+		}
+		libxmp_mixer_downmix(c, out, 0, frames);
+		out += (long)frames * job->framesize;
+		left -= frames;
+	}
+}
+
+/* Play the rest of the sequence in bypass mode, saving the player state
+ * at the split points. Returns the output size in bytes.
+ */
+static long split_module(struct context_data *ctx, struct render_job *job,
+								int max)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct render_segment *seg;
+	double start, length, target;
+	int bypass, loop_count, ord, split;
+	long size;
+
+	start = p->play_time;
+	length = p->scan[p->sequence].time - start;
+	if (length < 0) {
+		length = 0;
+	}
+
+	loop_count = p->loop_count;
+	bypass = s->bypass;
+	s->bypass = 1;
+
+	libxmp_state_save(ctx, job->seg[0].state);
+	job->num = 1;
+	seg = &job->seg[0];
+	size = 0;
+
+	for (;;) {
+		/* Keep the state before each tick until the order changes */
+		target = start + length * job->num / max;
+		split = job->num < max && p->play_time >= target;
+		if (split) {
+			libxmp_state_save(ctx, job->seg[job->num].state);
+		}
+
+		ord = p->ord;
+		if (libxmp_play_frame(ctx) < 0 || p->loop_count != loop_count) {
+			break;
+		}
+
+		if (split && p->ord != ord) {
+			seg = &job->seg[job->num++];
+			seg->offset = size;
+		}
+
+		seg->frames++;
+		size += (long)s->ticksize * job->framesize;
+	}
+
+	s->bypass = bypass;
+
+	return size;
+}
+
+long xmp_render_module(xmp_context opaque, void *out_buffer, long size,
+								int threads)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct mixer_pool *pool;
+	struct render_job job;
+	long ret;
+	int i, record;
+
+	if (ctx->state < XMP_STATE_PLAYING)
+		return -XMP_ERROR_STATE;
+
+#ifdef MIXER_THREADS
+	if (threads < 1 || threads > MIXER_MAX_THREADS)
+#else
+	if (threads != 1)
+#endif
+		return -XMP_ERROR_INVALID;
+
+	libxmp_scan_wait(ctx);
+
+	job.buffer = (char *)out_buffer;
+	job.state_size = libxmp_state_size(ctx);
+	job.framesize = s->format & XMP_FORMAT_MONO ? 1 : 2;
+	if (s->format & XMP_FORMAT_FLOAT) {
+		job.framesize *= sizeof(float);
+	} else if (~s->format & XMP_FORMAT_8BIT) {
+		job.framesize *= 2;
+	}
+
+	job.seg = calloc(threads, sizeof(struct render_segment));
+	job.clone = calloc(threads, sizeof(struct context_data *));
+	if (job.seg == NULL || job.clone == NULL) {
+		ret = -XMP_ERROR_SYSTEM;
+		goto end;
+	}
+
+	for (i = 0; i < threads; i++) {
+		job.seg[i].state = malloc(job.state_size);
+		if (job.seg[i].state == NULL) {
+			ret = -XMP_ERROR_SYSTEM;
+			goto end;
+		}
+	}
+
+	record = p->snapshot.record;
+	ret = job.size = split_module(ctx, &job, threads);
+
+	if (out_buffer == NULL) {
+		goto restore;
+	}
+	if (size < ret) {
+		ret = -XMP_ERROR_INVALID;
+		goto restore;
+	}
+
+	for (i = 0; i < job.num; i++) {
+		job.clone[i] = clone_player(ctx);
+		if (job.clone[i] == NULL) {
+			ret = -XMP_ERROR_SYSTEM;
+			goto restore;
+		}
+	}
+
+	pool = libxmp_mixer_pool_create(ctx, job.num);
+	if (pool != NULL) {
+		libxmp_mixer_pool_run(pool, render_segment, &job, NULL, 0);
+		libxmp_mixer_pool_destroy(pool);
+	} else {
+		for (i = 0; i < job.num; i++) {
+			render_segment(ctx, &job, i, job.num, NULL);
+		}
+	}
+
+	goto end;
+
+    restore:
+	/* Leave the player where it was */
+	libxmp_state_restore(ctx, job.seg[0].state, job.state_size);
+	p->snapshot.record = record;
+    end:
+	if (job.clone != NULL) {
+		for (i = 0; i < threads; i++) {
+			free_player(job.clone[i]);
+		}
+	}
+	if (job.seg != NULL) {
+		for (i = 0; i < threads; i++) {
+			free(job.seg[i].state);
+		}
+	}
+	free(job.clone);
+	free(job.seg);
+
+	return ret;
+}
@@ -43,6 +43,19 @@
 #include "common.h"
 #include "effects.h"
 #include "mixer.h"
+#include "mix_thread.h"
+
+#ifdef MIXER_THREADS
+#include <pthread.h>
+#endif
+
+#ifndef LIBXMP_CORE_PLAYER
+#include <unistd.h>
+
+#ifdef _WIN32
+int mkstemp(char *);
+#endif
+#endif
 
 #define S3M_END		0xff
 #define S3M_SKIP	0xfe
@@ -503,6 +516,8 @@ int libxmp_scan_sequences(struct context_data *ctx)
 	int seq;
 	unsigned char temp_ep[XMP_MAX_MOD_LENGTH];
 
+	libxmp_scan_wait(ctx);
+
 	/* Initialize order data to prevent overwrite when a position is used
 	 * multiple times at different starting points (see janosik.xm).
 	 */
@@ -547,3 +562,474 @@ int libxmp_scan_sequences(struct context_data *ctx)
 
 	return 0;
 }
+
+/*
+ * Deferred scan
+ *
+ * With XMP_SCAN_DEFER, sequences are scanned in a background thread (or
+ * when first needed if we don't have threads) on a copy of the player and
+ * module data. Until the results are used, the player plays the first
+ * order with the initial module speed, tempo and volume, and end of module
+ * checks are counted to be replayed once the end point is known.
+ */
+
+#define SCAN_MAX_ROWS	256
+
+struct scan_job {
+	struct context_data ctx;	/* scan copy of the player context */
+	int ord;			/* order played while scanning */
+	int rows[SCAN_MAX_ROWS];	/* end of module checks in each row */
+#ifdef MIXER_THREADS
+	pthread_t thread;
+	pthread_mutex_t lock;
+	int done;
+#endif
+};
+
+static void free_job(struct scan_job *job)
+{
+	free(job->ctx.m.scan_cache);
+	free(job);
+}
+
+#ifdef MIXER_THREADS
+
+static void *scan_main(void *data)
+{
+	struct scan_job *job = (struct scan_job *)data;
+
+	libxmp_scan_sequences(&job->ctx);
+#ifndef LIBXMP_CORE_PLAYER
+	libxmp_scan_cache_save(&job->ctx);
+#endif
+
+	pthread_mutex_lock(&job->lock);
+	job->done = 1;
+	pthread_mutex_unlock(&job->lock);
+
+	return NULL;
+}
+
+#endif
+
+int libxmp_scan_defer(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	struct scan_job *job;
+	int i;
+
+	if (mod->len == 0) {
+		return -1;
+	}
+
+	if ((job = malloc(sizeof (struct scan_job))) == NULL) {
+		return -1;
+	}
+
+	job->ctx.p = *p;
+	job->ctx.m = *m;
+	job->ctx.m.scan_job = NULL;
+	job->ord = -1;
+	memset(job->rows, 0, sizeof (job->rows));
+
+	/* The context can change its cache while we scan */
+	if (m->scan_cache != NULL) {
+		job->ctx.m.scan_cache = strdup(m->scan_cache);
+	}
+
+#ifdef MIXER_THREADS
+	job->done = 0;
+	if (pthread_mutex_init(&job->lock, NULL) != 0) {
+		free_job(job);
+		return -1;
+	}
+	if (pthread_create(&job->thread, NULL, scan_main, job) != 0) {
+		pthread_mutex_destroy(&job->lock);
+		free_job(job);
+		return -1;
+	}
+#endif
+
+	/* Start of the first sequence until the scan is done */
+	for (i = 0; i < XMP_MAX_MOD_LENGTH; i++) {
+		struct ord_data *info = &m->xxo_info[i];
+		info->speed = mod->spd;
+		info->bpm = mod->bpm;
+		info->gvl = mod->gvl;
+		info->time = 0;
+		info->start_row = 0;
+#ifndef LIBXMP_CORE_PLAYER
+		info->st26_speed = 0;
+#endif
+	}
+	memset(p->sequence_control, 0, XMP_MAX_MOD_LENGTH);
+	memset(p->scan, 0, sizeof (p->scan));
+	m->num_sequences = 1;
+	m->seq_data[0].entry_point = 0;
+	m->seq_data[0].duration = 0;
+
+	m->scan_job = job;
+
+	return 0;
+}
+
+/* Finish a deferred scan and use its results */
+void libxmp_scan_wait(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct flow_control *f = &p->flow;
+	struct scan_job *job = m->scan_job;
+	int n;
+
+	if (job == NULL) {
+		return;
+	}
+
+#ifdef MIXER_THREADS
+	pthread_join(job->thread, NULL);
+	pthread_mutex_destroy(&job->lock);
+#else
+	libxmp_scan_sequences(&job->ctx);
+#ifndef LIBXMP_CORE_PLAYER
+	libxmp_scan_cache_save(&job->ctx);
+#endif
+#endif
+
+	memcpy(m->xxo_info, job->ctx.m.xxo_info, sizeof (m->xxo_info));
+	memcpy(m->seq_data, job->ctx.m.seq_data, sizeof (m->seq_data));
+	m->num_sequences = job->ctx.m.num_sequences;
+	memcpy(p->scan, job->ctx.p.scan, sizeof (p->scan));
+	memcpy(p->sequence_control, job->ctx.p.sequence_control,
+						XMP_MAX_MOD_LENGTH);
+	m->scan_job = NULL;
+
+	if (ctx->state < XMP_STATE_PLAYING) {
+		free_job(job);
+		return;
+	}
+
+	/* Replay the end of module checks done while scanning */
+	n = job->ord == p->scan[0].ord ? job->rows[p->scan[0].row] : 0;
+	f->end_point = p->scan[0].num;
+	while (n-- > 0) {
+		if (f->end_point == 0) {
+			p->loop_count++;
+			p->snapshot.record = 0;
+			f->end_point = p->scan[0].num;
+		}
+		f->end_point--;
+	}
+
+	free_job(job);
+}
+
+/* Use the results of a finished background scan, if any */
+void libxmp_scan_poll(struct context_data *ctx)
+{
+#ifdef MIXER_THREADS
+	struct scan_job *job = ctx->m.scan_job;
+	int done;
+
+	if (job == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&job->lock);
+	done = job->done;
+	pthread_mutex_unlock(&job->lock);
+
+	if (done) {
+		libxmp_scan_wait(ctx);
+	}
+#endif
+}
+
+/* Discard a deferred scan */
+void libxmp_scan_cancel(struct context_data *ctx)
+{
+	struct module_data *m = &ctx->m;
+	struct scan_job *job = m->scan_job;
+
+	if (job == NULL) {
+		return;
+	}
+
+#ifdef MIXER_THREADS
+	pthread_join(job->thread, NULL);
+	pthread_mutex_destroy(&job->lock);
+#endif
+	free_job(job);
+	m->scan_job = NULL;
+}
+
+/* Count an end of module check of the current row while scanning.
+ * Returns -1 if the scan results were needed and used instead.
+ */
+int libxmp_scan_visit(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct scan_job *job = ctx->m.scan_job;
+
+	if (job->ord < 0) {
+		job->ord = p->ord;
+	}
+
+	if (p->ord != job->ord || p->row < 0 || p->row >= SCAN_MAX_ROWS) {
+		libxmp_scan_wait(ctx);
+		return -1;
+	}
+
+	job->rows[p->row]++;
+
+	return 0;
+}
+
+#ifndef LIBXMP_CORE_PLAYER
+
+/*
+ * Scan cache
+ *
+ * Scan results are kept in the directory set with xmp_set_scan_cache(),
+ * in a file named after the module MD5 digest. The file is only used if
+ * the module was scanned with the same player flags and quirks, and all
+ * stored values are in range.
+ */
+
+#define SCAN_CACHE_MAGIC	0x53504d58	/* "XMPS" */
+#define SCAN_CACHE_VERSION	1
+#define SCAN_CACHE_HEADER	40
+#define SCAN_CACHE_SEQ		24
+#define SCAN_CACHE_ORD		25
+#define SCAN_CACHE_MAX		(SCAN_CACHE_HEADER + \
+				 MAX_SEQUENCES * SCAN_CACHE_SEQ + \
+				 XMP_MAX_MOD_LENGTH * SCAN_CACHE_ORD)
+
+static uint8 *put32l(uint8 *b, uint32 v)
+{
+	b[0] = v & 0xff;
+	b[1] = (v >> 8) & 0xff;
+	b[2] = (v >> 16) & 0xff;
+	b[3] = (v >> 24) & 0xff;
+
+	return b + 4;
+}
+
+static char *cache_file(struct module_data *m, const char *suffix)
+{
+	char *name;
+	int i, n, size;
+
+	size = strlen(m->scan_cache) + 34 + strlen(suffix) + 1;
+	if ((name = malloc(size)) == NULL) {
+		return NULL;
+	}
+
+	n = snprintf(name, size, "%s/", m->scan_cache);
+	for (i = 0; i < 16; i++) {
+		n += snprintf(name + n, size - n, "%02x", m->md5[i]);
+	}
+	snprintf(name + n, size - n, "%s", suffix);
+
+	return name;
+}
+
+static int cache_seq_valid(struct module_data *m, const uint8 *b)
+{
+	struct xmp_module *mod = &m->mod;
+	int ep = readmem32l(b);
+	int duration = readmem32l(b + 4);
+	int time = readmem32l(b + 8);
+	int ord = readmem32l(b + 12);
+	int row = readmem32l(b + 16);
+
+	return ep >= 0 && ep < mod->len && duration >= 0 && time >= 0 &&
+		ord >= 0 && ord < mod->len && row >= 0 && row < SCAN_MAX_ROWS;
+}
+
+/* Orders not reached by the scan keep a global volume of -1 */
+static int cache_ord_valid(struct module_data *m, const uint8 *b)
+{
+	int speed = readmem32l(b + 1);
+	int bpm = readmem32l(b + 5);
+	int gvl = readmem32l(b + 9);
+	int time = readmem32l(b + 13);
+	int row = readmem32l(b + 17);
+
+	if ((b[0] >= MAX_SEQUENCES && b[0] != 0xff) || time < 0 ||
+	    row < 0 || row >= SCAN_MAX_ROWS || gvl > m->gvolbase) {
+		return 0;
+	}
+
+	if (gvl < 0) {
+		return gvl == -1 && speed >= 0 && bpm >= 0;
+	}
+
+	return speed > 0 && bpm > 0;
+}
+
+/* Use cached scan results. Returns -1 if there are none for the module */
+int libxmp_scan_cache_load(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	uint8 buf[SCAN_CACHE_MAX + 1];
+	uint8 *b;
+	char *name;
+	FILE *f;
+	int i, num, size;
+
+	if (m->scan_cache == NULL || mod->len == 0) {
+		return -1;
+	}
+
+	if ((name = cache_file(m, ".scan")) == NULL) {
+		return -1;
+	}
+	f = fopen(name, "rb");
+	free(name);
+	if (f == NULL) {
+		return -1;
+	}
+	size = fread(buf, 1, sizeof (buf), f);
+	fclose(f);
+
+	if (size < SCAN_CACHE_HEADER ||
+	    readmem32l(buf) != SCAN_CACHE_MAGIC ||
+	    readmem32l(buf + 4) != SCAN_CACHE_VERSION ||
+	    readmem32l(buf + 8) != XMP_VERCODE ||
+	    memcmp(buf + 12, m->md5, 16) != 0 ||
+	    readmem32l(buf + 28) != (uint32)p->flags ||
+	    readmem32l(buf + 32) != (uint32)m->quirk) {
+		return -1;
+	}
+
+	num = readmem16l(buf + 36);
+	if (readmem16l(buf + 38) != mod->len || num < 1 ||
+	    num > MAX_SEQUENCES || size != SCAN_CACHE_HEADER +
+	    num * SCAN_CACHE_SEQ + mod->len * SCAN_CACHE_ORD) {
+		return -1;
+	}
+
+	/* Check everything first, a bad file is rescanned from scratch */
+	b = buf + SCAN_CACHE_HEADER;
+	for (i = 0; i < num; i++, b += SCAN_CACHE_SEQ) {
+		if (!cache_seq_valid(m, b)) {
+			return -1;
+		}
+	}
+	for (i = 0; i < mod->len; i++, b += SCAN_CACHE_ORD) {
+		if (!cache_ord_valid(m, b)) {
+			return -1;
+		}
+	}
+
+	b = buf + SCAN_CACHE_HEADER;
+	for (i = 0; i < num; i++, b += SCAN_CACHE_SEQ) {
+		m->seq_data[i].entry_point = readmem32l(b);
+		m->seq_data[i].duration = readmem32l(b + 4);
+		p->scan[i].time = readmem32l(b + 8);
+		p->scan[i].ord = readmem32l(b + 12);
+		p->scan[i].row = readmem32l(b + 16);
+		p->scan[i].num = readmem32l(b + 20);
+	}
+	m->num_sequences = num;
+
+	memset(p->sequence_control, 0xff, XMP_MAX_MOD_LENGTH);
+	for (i = 0; i < mod->len; i++, b += SCAN_CACHE_ORD) {
+		struct ord_data *info = &m->xxo_info[i];
+		p->sequence_control[i] = b[0];
+		info->speed = readmem32l(b + 1);
+		info->bpm = readmem32l(b + 5);
+		info->gvl = readmem32l(b + 9);
+		info->time = readmem32l(b + 13);
+		info->start_row = readmem32l(b + 17);
+		info->st26_speed = readmem32l(b + 21);
+	}
+
+	return 0;
+}
+
+/* Store scan results, replacing the cache file at once */
+void libxmp_scan_cache_save(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	struct xmp_module *mod = &m->mod;
+	uint8 buf[SCAN_CACHE_MAX];
+	uint8 *b;
+	char *name, *temp;
+	FILE *f;
+	int i, fd, size;
+
+	if (m->scan_cache == NULL || mod->len == 0) {
+		return;
+	}
+
+	b = put32l(buf, SCAN_CACHE_MAGIC);
+	b = put32l(b, SCAN_CACHE_VERSION);
+	b = put32l(b, XMP_VERCODE);
+	memcpy(b, m->md5, 16);
+	b = put32l(b + 16, p->flags);
+	b = put32l(b, m->quirk);
+	b = put32l(b, (mod->len << 16) | m->num_sequences);
+
+	for (i = 0; i < m->num_sequences; i++) {
+		b = put32l(b, m->seq_data[i].entry_point);
+		b = put32l(b, m->seq_data[i].duration);
+		b = put32l(b, p->scan[i].time);
+		b = put32l(b, p->scan[i].ord);
+		b = put32l(b, p->scan[i].row);
+		b = put32l(b, p->scan[i].num);
+	}
+
+	for (i = 0; i < mod->len; i++) {
+		struct ord_data *info = &m->xxo_info[i];
+		*b++ = p->sequence_control[i];
+		b = put32l(b, info->speed);
+		b = put32l(b, info->bpm);
+		b = put32l(b, info->gvl);
+		b = put32l(b, info->time);
+		b = put32l(b, info->start_row);
+		b = put32l(b, info->st26_speed);
+	}
+	size = b - buf;
+
+	name = cache_file(m, ".scan");
+	temp = cache_file(m, ".XXXXXX");
+	if (name == NULL || temp == NULL) {
+		goto err;
+	}
+
+	/* Other players may be writing the same file */
+	if ((fd = mkstemp(temp)) < 0) {
+		goto err;
+	}
+	if ((f = fdopen(fd, "wb")) == NULL) {
+		close(fd);
+		remove(temp);
+		goto err;
+	}
+	i = fwrite(buf, 1, size, f);
+	if (fclose(f) != 0 || i != size) {
+		remove(temp);
+		goto err;
+	}
+
+	/* Fails on some systems if the file exists */
+	if (rename(temp, name) != 0) {
+		remove(name);
+		if (rename(temp, name) != 0) {
+			remove(temp);
+		}
+	}
+
+    err:
+	free(temp);
+	free(name);
+}
+
+#endif
@@ -0,0 +1,468 @@
+/* Extended Module Player
+ * Copyright (C) 1996-2018 Claudio Matsuoka and Hipolito Carraro Jr
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Player state snapshots
+ *
+ * The playback state is everything the sequencer and the mixer carry from
+ * one tick to the next: struct player_data, the channel array with its LFOs
+ * and envelope positions, the pattern loop and virtual channel tables, the
+ * mixer voices and the Paula and channel extras they point to, and the loops
+ * of the sample copies changed by the invert loop effect. It is saved
+ * as a flat copy of those arrays, so it can only be restored into the same
+ * player (same module, voices, channels and mixer rate and format) it was
+ * taken from.
+ *
+ * If the application sets a memory budget with XMP_PLAYER_SEEK_MEMORY,
+ * snapshots of this state are taken while the module plays from the start,
+ * at most one per interval, so that seeking can restore the nearest one and
+ * play forward from there instead of resetting all channels at an order.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "player.h"
+#include "mixer.h"
+#include "virtual.h"
+#include "state.h"
+#ifndef LIBXMP_CORE_PLAYER
+#include "extras.h"
+#endif
+#ifdef LIBXMP_PAULA_SIMULATOR
+#include "paula.h"
+#endif
+
+#define STATE_MAGIC		0x584d5053	/* "XMPS" */
+#define SNAPSHOT_INTERVAL	1000		/* shortest interval, in ms */
+
+struct state_header {
+	uint32 magic;
+	uint32 size;
+	int virt_channels;
+	int maxvoc;
+	int freq;		/* mixer rate and format of the voices */
+	int format;
+	uint8 md5[16];		/* module the state belongs to */
+};
+
+struct player_snapshot {
+	double time;		/* playback time of the snapshot */
+	void *state;
+};
+
+#ifdef LIBXMP_PAULA_SIMULATOR
+static int has_paula(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+
+	return p->virt.maxvoc > 0 && p->virt.voice_array[0].paula != NULL;
+}
+#endif
+
+#ifndef LIBXMP_CORE_PLAYER
+/* Bytes of sample i changed by invert loop, from the loop start */
+static int invloop_size(struct context_data *ctx, int i)
+{
+	struct player_data *p = &ctx->p;
+	struct xmp_sample *xxs = &ctx->m.mod.xxs[i];
+
+	if (p->invloop_data == NULL || p->invloop_data[i] == NULL) {
+		return 0;
+	}
+
+	return xxs->lpe - xxs->lps + 1;
+}
+#endif
+
+size_t libxmp_state_size(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	size_t vc = p->virt.virt_channels;
+	size_t nv = p->virt.maxvoc;
+	size_t size;
+#ifndef LIBXMP_CORE_PLAYER
+	int i;
+#endif
+
+	size = sizeof(struct state_header) + sizeof(struct player_data);
+	size += vc * (sizeof(struct channel_data) +
+		sizeof(struct pattern_loop) + sizeof(struct virt_channel));
+#ifndef LIBXMP_CORE_PLAYER
+	size += vc * libxmp_channel_extras_size(ctx);
+	for (i = 0; i < ctx->m.mod.smp; i++) {
+		size += invloop_size(ctx, i);
+	}
+#endif
+	size += nv * sizeof(struct mixer_voice);
+#ifdef LIBXMP_PAULA_SIMULATOR
+	if (has_paula(ctx)) {
+		size += nv * sizeof(struct paula_state);
+	}
+#endif
+	size += 2 * sizeof(int);	/* anticlick */
+
+	return size;
+}
+
+#define PUT(src, size) do { \
+	memcpy(b, (src), (size)); b += (size); \
+} while (0)
+
+#define GET(dest, size) do { \
+	memcpy((dest), b, (size)); b += (size); \
+} while (0)
+
+void libxmp_state_save(struct context_data *ctx, void *buf)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct state_header h;
+	struct mixer_voice vi;
+#ifndef LIBXMP_CORE_PLAYER
+	size_t esize = libxmp_channel_extras_size(ctx);
+#endif
+	char *b = buf;
+	int i;
+
+	h.magic = STATE_MAGIC;
+	h.size = libxmp_state_size(ctx);
+	h.virt_channels = p->virt.virt_channels;
+	h.maxvoc = p->virt.maxvoc;
+	h.freq = s->freq;
+	h.format = s->format;
+	memcpy(h.md5, ctx->m.md5, 16);
+
+	PUT(&h, sizeof(struct state_header));
+	PUT(p, sizeof(struct player_data));
+	PUT(p->xc_data, p->virt.virt_channels * sizeof(struct channel_data));
+	PUT(p->flow.loop, p->virt.virt_channels * sizeof(struct pattern_loop));
+	PUT(p->virt.virt_channel,
+		p->virt.virt_channels * sizeof(struct virt_channel));
+
+#ifndef LIBXMP_CORE_PLAYER
+	for (i = 0; esize > 0 && i < p->virt.virt_channels; i++) {
+		void *extra = p->xc_data[i].extra;
+		if (extra != NULL) {
+			PUT(extra, esize);
+		} else {
+			memset(b, 0, esize);
+			b += esize;
+		}
+	}
+
+	for (i = 0; i < ctx->m.mod.smp; i++) {
+		size_t len = invloop_size(ctx, i);
+		if (len > 0) {
+			PUT(p->invloop_data[i] + ctx->m.mod.xxs[i].lps, len);
+		}
+	}
+#endif
+
+	for (i = 0; i < p->virt.maxvoc; i++) {
+		libxmp_mixer_savevoice(ctx, i, &vi);
+		PUT(&vi, sizeof(struct mixer_voice));
+	}
+#ifdef LIBXMP_PAULA_SIMULATOR
+	if (has_paula(ctx)) {
+		for (i = 0; i < p->virt.maxvoc; i++) {
+			PUT(p->virt.voice_array[i].paula,
+					sizeof(struct paula_state));
+		}
+	}
+#endif
+
+	PUT(&s->dtleft, sizeof(int));
+	PUT(&s->dtright, sizeof(int));
+}
+
+int libxmp_state_restore(struct context_data *ctx, const void *buf, size_t size)
+{
+	struct player_data *p = &ctx->p;
+	struct mixer_data *s = &ctx->s;
+	struct player_data live;
+	struct state_header h;
+#ifndef LIBXMP_CORE_PLAYER
+	size_t esize = libxmp_channel_extras_size(ctx);
+#endif
+	const char *b = buf;
+	int i;
+
+	if (size < sizeof(struct state_header))
+		return -1;
+
+	GET(&h, sizeof(struct state_header));
+	if (h.magic != STATE_MAGIC || h.size > size ||
+	    h.size != libxmp_state_size(ctx) ||
+	    h.virt_channels != p->virt.virt_channels ||
+	    h.maxvoc != p->virt.maxvoc ||
+	    h.freq != s->freq || h.format != s->format ||
+	    memcmp(h.md5, ctx->m.md5, 16) != 0) {
+		return -1;
+	}
+
+	/* Keep our arrays and everything set by the application */
+	memcpy(&live, p, sizeof(struct player_data));
+	GET(p, sizeof(struct player_data));
+
+	p->mode = live.mode;
+	p->flags = live.flags;
+	p->player_flags = live.player_flags;
+	p->master_vol = live.master_vol;
+	p->smix_vol = live.smix_vol;
+	memcpy(p->scan, live.scan, sizeof(live.scan));
+	memcpy(p->channel_vol, live.channel_vol, sizeof(live.channel_vol));
+	memcpy(p->channel_mute, live.channel_mute, sizeof(live.channel_mute));
+	memcpy(p->inject_event, live.inject_event, sizeof(live.inject_event));
+	p->xc_data = live.xc_data;
+	p->flow.loop = live.flow.loop;
+	p->virt.virt_channel = live.virt.virt_channel;
+	p->virt.voice_array = live.virt.voice_array;
+	p->virt.free_heap = live.virt.free_heap;
+	p->virt.steal_heap = live.virt.steal_heap;
+	p->buffer_data = live.buffer_data;
+	p->render_data = live.render_data;
+	p->snapshot = live.snapshot;
+#ifndef LIBXMP_CORE_PLAYER
+	p->invloop_data = live.invloop_data;
+#endif
+
+#ifndef LIBXMP_CORE_PLAYER
+	for (i = 0; i < p->virt.virt_channels; i++) {
+		struct channel_data *xc = &p->xc_data[i];
+		void *extra = xc->extra;
+		GET(xc, sizeof(struct channel_data));
+		xc->extra = extra;
+	}
+#else
+	GET(p->xc_data, p->virt.virt_channels * sizeof(struct channel_data));
+#endif
+	GET(p->flow.loop, p->virt.virt_channels * sizeof(struct pattern_loop));
+	GET(p->virt.virt_channel,
+		p->virt.virt_channels * sizeof(struct virt_channel));
+
+#ifndef LIBXMP_CORE_PLAYER
+	for (i = 0; esize > 0 && i < p->virt.virt_channels; i++) {
+		void *extra = p->xc_data[i].extra;
+		if (extra != NULL) {
+			GET(extra, esize);
+		} else {
+			b += esize;
+		}
+	}
+
+	for (i = 0; i < ctx->m.mod.smp; i++) {
+		size_t len = invloop_size(ctx, i);
+		if (len > 0) {
+			GET(p->invloop_data[i] + ctx->m.mod.xxs[i].lps, len);
+		}
+	}
+#endif
+
+	for (i = 0; i < p->virt.maxvoc; i++) {
+		struct mixer_voice *vi = &p->virt.voice_array[i];
+#ifdef LIBXMP_PAULA_SIMULATOR
+		struct paula_state *paula = vi->paula;
+		GET(vi, sizeof(struct mixer_voice));
+		vi->paula = paula;
+#else
+		GET(vi, sizeof(struct mixer_voice));
+#endif
+	}
+#ifdef LIBXMP_PAULA_SIMULATOR
+	if (has_paula(ctx)) {
+		for (i = 0; i < p->virt.maxvoc; i++) {
+			GET(p->virt.voice_array[i].paula,
+					sizeof(struct paula_state));
+		}
+	}
+#endif
+
+	libxmp_virt_reindex(ctx);
+
+	for (i = 0; i < p->virt.maxvoc; i++) {
+		libxmp_mixer_restorevoice(ctx, i);
+	}
+
+	GET(&s->dtleft, sizeof(int));
+	GET(&s->dtright, sizeof(int));
+
+	return 0;
+}
+
+/*
+ * Seek snapshots
+ */
+
+void libxmp_snapshot_free(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	int i;
+
+	if (p->snapshot.slot != NULL) {
+		for (i = 0; i < p->snapshot.num; i++) {
+			free(p->snapshot.slot[i].state);
+		}
+		free(p->snapshot.slot);
+	}
+
+	p->snapshot.slot = NULL;
+	p->snapshot.num = 0;
+	p->snapshot.record = 0;
+}
+
+/* Start a new snapshot timeline at the current (initial) player state */
+void libxmp_snapshot_init(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct module_data *m = &ctx->m;
+	size_t size;
+	int time, max;
+
+	libxmp_snapshot_free(ctx);
+
+	/* Snapshots are only taken if the application asked for them */
+	if (p->snapshot.memory <= 0 || m->mod.len <= 0) {
+		return;
+	}
+
+	/* Start recording when the sequence duration is known */
+	if (m->scan_job != NULL) {
+		p->snapshot.sequence = p->sequence;
+		p->snapshot.record = 1;
+		return;
+	}
+
+	/* Spread the snapshots over the whole sequence within our budget */
+	size = libxmp_state_size(ctx);
+	max = ((size_t)p->snapshot.memory << 10) / size;
+	if (max < 1) {
+		return;
+	}
+	time = p->scan[p->sequence].time;
+	p->snapshot.interval = time / max + 1;
+	if (p->snapshot.interval < SNAPSHOT_INTERVAL) {
+		p->snapshot.interval = SNAPSHOT_INTERVAL;
+	}
+	p->snapshot.num = time / p->snapshot.interval + 1;
+
+	p->snapshot.slot = calloc(p->snapshot.num,
+				sizeof(struct player_snapshot));
+	if (p->snapshot.slot == NULL) {
+		p->snapshot.num = 0;
+		return;
+	}
+
+	p->snapshot.sequence = p->sequence;
+	p->snapshot.record = 1;
+
+	libxmp_snapshot_save(ctx);
+}
+
+/* Called before each tick while playing along the snapshot timeline */
+void libxmp_snapshot_save(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	struct player_snapshot *ps;
+	int i;
+
+	if (!p->snapshot.record || p->sequence != p->snapshot.sequence) {
+		return;
+	}
+
+	if (p->snapshot.slot == NULL) {
+		if (ctx->m.scan_job == NULL) {
+			libxmp_snapshot_init(ctx);
+		}
+		return;
+	}
+
+	i = p->play_time / p->snapshot.interval;
+	if (i < 0 || i >= p->snapshot.num) {
+		return;
+	}
+
+	ps = &p->snapshot.slot[i];
+	if (ps->state != NULL) {
+		return;
+	}
+
+	ps->state = malloc(libxmp_state_size(ctx));
+	if (ps->state == NULL) {
+		p->snapshot.record = 0;
+		return;
+	}
+
+	libxmp_state_save(ctx, ps->state);
+	ps->time = p->play_time;
+}
+
+/* Go to the latest snapshot at or before the given time, in ms. Returns
+ * -1 if there is no such snapshot and the player state was not changed.
+ */
+int libxmp_snapshot_seek(struct context_data *ctx, int time)
+{
+	struct player_data *p = &ctx->p;
+	struct player_snapshot *ps = NULL;
+	int i, loop_count;
+
+	/* Recording waits for the sequence duration, known by now */
+	if (p->snapshot.slot == NULL) {
+		libxmp_snapshot_save(ctx);
+	}
+
+	if (p->snapshot.slot == NULL || p->sequence != p->snapshot.sequence) {
+		return -1;
+	}
+
+	i = time / p->snapshot.interval;
+	if (i >= p->snapshot.num) {
+		i = p->snapshot.num - 1;
+	}
+
+	for (; i >= 0; i--) {
+		ps = &p->snapshot.slot[i];
+		if (ps->state != NULL && ps->time <= time) {
+			break;
+		}
+	}
+	if (i < 0) {
+		return -1;
+	}
+
+	/* We're already between the snapshot and the target */
+	if (p->snapshot.record && p->play_time >= ps->time &&
+					p->play_time <= time) {
+		return 0;
+	}
+
+	loop_count = p->loop_count;
+	if (libxmp_state_restore(ctx, ps->state,
+				libxmp_state_size(ctx)) < 0) {
+		return -1;
+	}
+	p->loop_count = loop_count;
+	p->snapshot.record = 1;
+
+	return 0;
+}
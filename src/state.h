@@ -0,0 +1,15 @@
+#ifndef LIBXMP_STATE_H
+#define LIBXMP_STATE_H
+
+#include "common.h"
+
+size_t	libxmp_state_size	(struct context_data *);
+void	libxmp_state_save	(struct context_data *, void *);
+int	libxmp_state_restore	(struct context_data *, const void *, size_t);
+
+void	libxmp_snapshot_init	(struct context_data *);
+void	libxmp_snapshot_free	(struct context_data *);
+void	libxmp_snapshot_save	(struct context_data *);
+int	libxmp_snapshot_seek	(struct context_data *, int);
+
+#endif
@@ -22,7 +22,6 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <limits.h>
 #include "common.h"
 #include "virtual.h"
 #include "mixer.h"
@@ -38,6 +37,130 @@ void libxmp_player_set_release(struct context_data *, int);
 void libxmp_player_set_fadeout(struct context_data *, int);
 
 
+/*
+ * Voices are kept in two indexed min-heaps so that finding a voice for a
+ * new note doesn't scan the voice array: free voices ordered by number,
+ * and background voices (the ones that can be stolen) ordered by volume
+ * and then by number. This is the same order the linear search used, so
+ * voices are allocated and stolen exactly as before.
+ */
+
+static int heap_less(struct player_data *p, struct virt_heap *h, int a, int b)
+{
+	if (h->by_vol) {
+		int va = p->virt.voice_array[a].vol;
+		int vb = p->virt.voice_array[b].vol;
+
+		if (va != vb) {
+			return va < vb;
+		}
+	}
+
+	return a < b;
+}
+
+static void heap_set(struct virt_heap *h, int i, int voc)
+{
+	h->voc[i] = voc;
+	h->pos[voc] = i;
+}
+
+static void heap_up(struct player_data *p, struct virt_heap *h, int i)
+{
+	int voc = h->voc[i];
+
+	while (i > 0) {
+		int parent = (i - 1) / 2;
+		if (!heap_less(p, h, voc, h->voc[parent])) {
+			break;
+		}
+		heap_set(h, i, h->voc[parent]);
+		i = parent;
+	}
+
+	heap_set(h, i, voc);
+}
+
+static void heap_down(struct player_data *p, struct virt_heap *h, int i)
+{
+	int voc = h->voc[i];
+
+	for (;;) {
+		int child = 2 * i + 1;
+		if (child >= h->num) {
+			break;
+		}
+		if (child + 1 < h->num &&
+		    heap_less(p, h, h->voc[child + 1], h->voc[child])) {
+			child++;
+		}
+		if (!heap_less(p, h, h->voc[child], voc)) {
+			break;
+		}
+		heap_set(h, i, h->voc[child]);
+		i = child;
+	}
+
+	heap_set(h, i, voc);
+}
+
+/* Insert, remove or reorder a voice in a heap */
+static void heap_update(struct player_data *p, struct virt_heap *h, int voc, int in)
+{
+	int i = h->pos[voc];
+
+	if (i < 0) {
+		if (in) {
+			heap_set(h, h->num, voc);
+			heap_up(p, h, h->num++);
+		}
+		return;
+	}
+
+	if (!in) {
+		h->pos[voc] = -1;
+		if (i == --h->num) {
+			return;
+		}
+		voc = h->voc[h->num];
+		heap_set(h, i, voc);
+	}
+
+	heap_up(p, h, i);
+	if (h->pos[voc] == i) {
+		heap_down(p, h, i);
+	}
+}
+
+/* Must be called after the channel or the volume of a voice changes */
+static void update_voice(struct context_data *ctx, int voc)
+{
+	struct player_data *p = &ctx->p;
+	int chn = p->virt.voice_array[voc].chn;
+
+	heap_update(p, &p->virt.free_heap, voc, chn == FREE);
+	heap_update(p, &p->virt.steal_heap, voc, chn >= p->virt.num_tracks);
+}
+
+/* Rebuild the heaps from the voice array */
+void libxmp_virt_reindex(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	int i;
+
+	p->virt.free_heap.num = 0;
+	p->virt.steal_heap.num = 0;
+
+	for (i = 0; i < p->virt.maxvoc; i++) {
+		p->virt.free_heap.pos[i] = -1;
+		p->virt.steal_heap.pos[i] = -1;
+	}
+
+	for (i = 0; i < p->virt.maxvoc; i++) {
+		update_voice(ctx, i);
+	}
+}
+
 /* Get parent channel */
 int libxmp_virt_getroot(struct context_data *ctx, int chn)
 {
@@ -82,6 +205,7 @@ void libxmp_virt_resetvoice(struct context_data *ctx, int voc, int mute)
 	vi->paula = paula;
 #endif
 	vi->chn = vi->root = FREE;
+	update_voice(ctx, voc);
 }
 
 /* virt_on (number of tracks) */
@@ -137,10 +261,24 @@ int libxmp_virt_on(struct context_data *ctx, int num)
 		p->virt.virt_channel[i].count = 0;
 	}
 
+	/* One block for both heaps */
+	p->virt.free_heap.voc = malloc(4 * p->virt.maxvoc * sizeof(int));
+	if (p->virt.free_heap.voc == NULL)
+		goto err3;
+
+	p->virt.free_heap.pos = p->virt.free_heap.voc + p->virt.maxvoc;
+	p->virt.free_heap.by_vol = 0;
+	p->virt.steal_heap.voc = p->virt.free_heap.pos + p->virt.maxvoc;
+	p->virt.steal_heap.pos = p->virt.steal_heap.voc + p->virt.maxvoc;
+	p->virt.steal_heap.by_vol = 1;
+
 	p->virt.virt_used = 0;
+	libxmp_virt_reindex(ctx);
 
 	return 0;
 
+      err3:
+	free(p->virt.virt_channel);
       err2:
 #ifdef LIBXMP_PAULA_SIMULATOR
 	if (IS_AMIGA_MOD()) {
@@ -177,6 +315,8 @@ void libxmp_virt_off(struct context_data *ctx)
 
 	free(p->virt.voice_array);
 	free(p->virt.virt_channel);
+	free(p->virt.free_heap.voc);
+	p->virt.free_heap.voc = NULL;
 }
 
 void libxmp_virt_reset(struct context_data *ctx)
@@ -213,24 +353,16 @@ void libxmp_virt_reset(struct context_data *ctx)
 	}
 
 	p->virt.virt_used = 0;
+	libxmp_virt_reindex(ctx);
 }
 
 static int free_voice(struct context_data *ctx)
 {
 	struct player_data *p = &ctx->p;
-	int i, num, vol;
-
-	/* Find background voice with lowest volume*/
-	num = FREE;
-	vol = INT_MAX;
-	for (i = 0; i < p->virt.maxvoc; i++) {
-		struct mixer_voice *vi = &p->virt.voice_array[i];
+	int num;
 
-		if (vi->chn >= p->virt.num_tracks && vi->vol < vol) {
-			num = i;
-			vol = vi->vol;
-		}
-	}
+	/* Find background voice with lowest volume */
+	num = p->virt.steal_heap.num > 0 ? p->virt.steal_heap.voc[0] : FREE;
 
 	/* Free voice */
 	if (num >= 0) {
@@ -247,14 +379,10 @@ static int alloc_voice(struct context_data *ctx, int chn)
 	struct player_data *p = &ctx->p;
 	int i;
 
-	/* Find free voice */
-	for (i = 0; i < p->virt.maxvoc; i++) {
-		if (p->virt.voice_array[i].chn == FREE)
-			break;
-	}
-
-	/* not found */
-	if (i == p->virt.maxvoc) {
+	/* Find free voice with lowest number */
+	if (p->virt.free_heap.num > 0) {
+		i = p->virt.free_heap.voc[0];
+	} else {
 		i = free_voice(ctx);
 	}
 
@@ -265,6 +393,7 @@ static int alloc_voice(struct context_data *ctx, int chn)
 		p->virt.voice_array[i].chn = chn;
 		p->virt.voice_array[i].root = chn;
 		p->virt.virt_channel[chn].map = i;
+		update_voice(ctx, i);
 	}
 
 	return i;
@@ -317,6 +446,7 @@ void libxmp_virt_resetchannel(struct context_data *ctx, int chn)
 	vi->paula = paula;
 #endif
 	vi->chn = vi->root = FREE;
+	update_voice(ctx, voc);
 }
 
 void libxmp_virt_setvol(struct context_data *ctx, int chn, int vol)
@@ -334,6 +464,7 @@ void libxmp_virt_setvol(struct context_data *ctx, int chn, int vol)
 	}
 
 	libxmp_mixer_setvol(ctx, voc, vol);
+	update_voice(ctx, voc);
 
 	if (vol == 0 && chn >= p->virt.num_tracks) {
 		libxmp_virt_resetvoice(ctx, voc, 1);
@@ -376,7 +507,7 @@ void libxmp_virt_seteffect(struct context_data *ctx, int chn, int type, int val)
 	libxmp_mixer_seteffect(ctx, voc, type, val);
 }
 
-double libxmp_virt_getvoicepos(struct context_data *ctx, int chn)
+int libxmp_virt_getvoicepos(struct context_data *ctx, int chn)
 {
 	struct player_data *p = &ctx->p;
 	int voc;
@@ -385,7 +516,7 @@ double libxmp_virt_getvoicepos(struct context_data *ctx, int chn)
 		return -1;
 	}
 
-	return libxmp_mixer_getvoicepos(ctx, voc);
+	return VOICE_POS_INT(libxmp_mixer_getvoicepos(ctx, voc));
 }
 
 #ifndef LIBXMP_CORE_PLAYER
@@ -394,7 +525,7 @@ void libxmp_virt_setsmp(struct context_data *ctx, int chn, int smp)
 {
 	struct player_data *p = &ctx->p;
 	struct mixer_voice *vi;
-	double pos;
+	int64 pos;
 	int voc;
 
 	if ((voc = map_virt_channel(p, chn)) < 0) {
@@ -409,6 +540,7 @@ void libxmp_virt_setsmp(struct context_data *ctx, int chn, int smp)
 	pos = libxmp_mixer_getvoicepos(ctx, voc);
 	libxmp_mixer_setpatch(ctx, voc, smp, 0);
 	libxmp_mixer_voicepos(ctx, voc, pos, 0);	/* Restore old position */
+	update_voice(ctx, voc);
 }
 
 #endif
@@ -516,6 +648,7 @@ int libxmp_virt_setpatch(struct context_data *ctx, int chn, int ins, int smp,
 
 			p->virt.voice_array[voc].chn = --chn;
 			p->virt.virt_channel[chn].map = voc;
+			update_voice(ctx, voc);
 			voc = vfree;
 		}
 	} else {
@@ -531,6 +664,7 @@ int libxmp_virt_setpatch(struct context_data *ctx, int chn, int ins, int smp,
 	}
 
 	libxmp_mixer_setpatch(ctx, voc, smp, 1);
+	update_voice(ctx, voc);
 	libxmp_mixer_setnote(ctx, voc, note);
 	p->virt.voice_array[voc].ins = ins;
 	p->virt.voice_array[voc].act = nna;
@@ -550,7 +684,7 @@ void libxmp_virt_setperiod(struct context_data *ctx, int chn, double period)
 	libxmp_mixer_setperiod(ctx, voc, period);
 }
 
-void libxmp_virt_voicepos(struct context_data *ctx, int chn, double pos)
+void libxmp_virt_voicepos(struct context_data *ctx, int chn, int pos)
 {
 	struct player_data *p = &ctx->p;
 	int voc;
@@ -559,7 +693,7 @@ void libxmp_virt_voicepos(struct context_data *ctx, int chn, double pos)
 		return;
 	}
 
-	libxmp_mixer_voicepos(ctx, voc, pos, 1);
+	libxmp_mixer_voicepos(ctx, voc, VOICE_POS(pos), 1);
 }
 
 #ifndef LIBXMP_CORE_DISABLE_IT
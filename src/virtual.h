@@ -22,8 +22,8 @@ void	libxmp_virt_setsmp	(struct context_data *, int, int);
 void	libxmp_virt_setnna	(struct context_data *, int, int);
 void	libxmp_virt_pastnote	(struct context_data *, int, int);
 void	libxmp_virt_setvol	(struct context_data *, int, int);
-void	libxmp_virt_voicepos	(struct context_data *, int, double);
-double	libxmp_virt_getvoicepos	(struct context_data *, int);
+void	libxmp_virt_voicepos	(struct context_data *, int, int);
+int	libxmp_virt_getvoicepos	(struct context_data *, int);
 void	libxmp_virt_setperiod	(struct context_data *, int, double);
 void	libxmp_virt_setpan	(struct context_data *, int, int);
 void	libxmp_virt_seteffect	(struct context_data *, int, int, int);
@@ -32,6 +32,7 @@ int	libxmp_virt_mapchannel	(struct context_data *, int);
 void	libxmp_virt_resetchannel(struct context_data *, int);
 void	libxmp_virt_resetvoice	(struct context_data *, int, int);
 void	libxmp_virt_reset	(struct context_data *);
+void	libxmp_virt_reindex	(struct context_data *);
 void	libxmp_virt_release	(struct context_data *, int, int);
 int	libxmp_virt_getroot	(struct context_data *, int);
 
@@ -0,0 +1,96 @@
+#include "test.h"
+
+/* Play frame by frame until the module loops */
+static int play_checksum(xmp_context opaque)
+{
+	struct xmp_frame_info fi;
+	int sum, i;
+
+	sum = 0;
+	for (;;) {
+		if (xmp_play_frame(opaque) < 0)
+			break;
+		xmp_get_frame_info(opaque, &fi);
+		if (fi.loop_count > 0)
+			break;
+		for (i = 0; i < fi.buffer_size; i++) {
+			sum = sum * 31 + ((char *)fi.buffer)[i];
+		}
+	}
+
+	return sum;
+}
+
+TEST(test_api_attach_module)
+{
+	xmp_context ctx1, ctx2, ctx3;
+	struct xmp_module_info mi1, mi2;
+	int ret, sum;
+
+	ctx1 = xmp_create_context();
+	ctx2 = xmp_create_context();
+	ctx3 = xmp_create_context();
+
+	ret = xmp_attach_module(ctx2, ctx1);
+	fail_unless(ret == -XMP_ERROR_STATE, "state error");
+
+	ret = xmp_load_module(ctx1, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	ret = xmp_attach_module(ctx2, ctx1);
+	fail_unless(ret == -XMP_ERROR_STATE, "module not shared");
+
+	ret = xmp_load_shared(ctx1, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	ret = xmp_attach_module(ctx1, ctx1);
+	fail_unless(ret == -XMP_ERROR_INVALID, "same context");
+
+	ret = xmp_attach_module(ctx2, ctx1);
+	fail_unless(ret == 0, "attach error");
+	ret = xmp_attach_module(ctx3, ctx1);
+	fail_unless(ret == 0, "attach error");
+
+	/* Module data is not copied */
+	xmp_get_module_info(ctx1, &mi1);
+	xmp_get_module_info(ctx2, &mi2);
+	fail_unless(mi1.mod->xxs == mi2.mod->xxs, "samples not shared");
+	fail_unless(mi1.mod->xxp == mi2.mod->xxp, "patterns not shared");
+	fail_unless(mi1.seq_data[0].duration == mi2.seq_data[0].duration,
+						"duration mismatch");
+
+	xmp_start_player(ctx1, 8000, 0);
+	sum = play_checksum(ctx1);
+
+	/* Attached contexts play the same, also after the source is gone */
+	xmp_start_player(ctx2, 8000, 0);
+	fail_unless(play_checksum(ctx2) == sum, "attached replay mismatch");
+
+	xmp_start_player(ctx3, 8000, 0);
+	xmp_release_module(ctx1);
+	xmp_free_context(ctx1);
+	fail_unless(play_checksum(ctx3) == sum, "attached replay mismatch");
+
+	xmp_release_module(ctx2);
+	xmp_start_player(ctx3, 8000, 0);
+	fail_unless(play_checksum(ctx3) == sum, "attached replay mismatch");
+
+	/* Loading a module releases the attached one */
+	ret = xmp_load_module(ctx3, "data/storlek_01.it");
+	fail_unless(ret == 0, "module load error");
+
+	/* Samples changed by invert loop are not shared */
+	ret = xmp_load_shared(ctx3, "data/invloop.mod");
+	fail_unless(ret == 0, "module load error");
+	ret = xmp_attach_module(ctx2, ctx3);
+	fail_unless(ret == 0, "attach error");
+
+	xmp_start_player(ctx3, 8000, 0);
+	sum = play_checksum(ctx3);
+	xmp_start_player(ctx2, 8000, 0);
+	fail_unless(play_checksum(ctx2) == sum, "invert loop replay mismatch");
+
+	xmp_release_module(ctx2);
+	xmp_release_module(ctx3);
+	xmp_free_context(ctx2);
+	xmp_free_context(ctx3);
+}
+END_TEST
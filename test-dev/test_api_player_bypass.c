@@ -0,0 +1,117 @@
+#include "test.h"
+
+static int frame_sum(xmp_context opaque)
+{
+	struct xmp_frame_info fi;
+	int j, sum;
+	short *b;
+
+	xmp_get_frame_info(opaque, &fi);
+	b = fi.buffer;
+	sum = 0;
+	for (j = 0; j < fi.buffer_size / 2; j++) {
+		sum = sum * 31 + b[j];
+	}
+
+	return sum;
+}
+
+/* Play some frames with or without mixing, then checksum what follows */
+static int play_checksum(xmp_context opaque, int interp, int bypass)
+{
+	int i, sum;
+
+	xmp_start_player(opaque, 44100, 0);
+	xmp_set_player(opaque, XMP_PLAYER_INTERP, interp);
+	xmp_set_player(opaque, XMP_PLAYER_BYPASS, bypass);
+
+	for (i = 0; i < 700; i++) {
+		xmp_play_frame(opaque);
+	}
+
+	xmp_set_player(opaque, XMP_PLAYER_BYPASS, 0);
+
+	sum = 0;
+	for (i = 0; i < 100; i++) {
+		xmp_play_frame(opaque);
+		sum = sum * 7 + frame_sum(opaque);
+	}
+
+	xmp_end_player(opaque);
+
+	return sum;
+}
+
+TEST(test_api_player_bypass)
+{
+	xmp_context opaque;
+	int i, ret, interp;
+	short buf[2000];
+
+	opaque = xmp_create_context();
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+
+	ret = xmp_set_player(opaque, XMP_PLAYER_BYPASS, 1);
+	fail_unless(ret == -XMP_ERROR_STATE, "bypass set before playing");
+
+	xmp_start_player(opaque, 44100, 0);
+	ret = xmp_get_player(opaque, XMP_PLAYER_BYPASS);
+	fail_unless(ret == 0, "bypass enabled by default");
+	ret = xmp_set_player(opaque, XMP_PLAYER_BYPASS, 1);
+	fail_unless(ret == 0, "error setting bypass");
+	ret = xmp_get_player(opaque, XMP_PLAYER_BYPASS);
+	fail_unless(ret == 1, "bypass not set");
+
+	/* Nothing is mixed */
+	memset(buf, 0xff, sizeof(buf));
+	xmp_play_buffer(opaque, buf, sizeof(buf), 0);
+	for (ret = 0; ret < 2000; ret++) {
+		fail_unless(buf[ret] == 0, "bypass output not silent");
+	}
+	xmp_end_player(opaque);
+
+	/* Output is silent after bypass is set while playing */
+	xmp_start_player(opaque, 44100, 0);
+	xmp_set_player(opaque, XMP_PLAYER_BYPASS, 0);
+	for (i = 0; i < 50; i++) {
+		xmp_play_buffer(opaque, buf, sizeof(buf), 0);
+	}
+	for (ret = 0; ret < 2000 && buf[ret] == 0; ret++);
+	fail_unless(ret < 2000, "nothing mixed before bypass");
+	xmp_set_player(opaque, XMP_PLAYER_BYPASS, 1);
+	for (i = 0; i < 5; i++) {
+		memset(buf, 0xff, sizeof(buf));
+		xmp_play_buffer(opaque, buf, sizeof(buf), 0);
+		for (ret = 0; ret < 2000; ret++) {
+			fail_unless(buf[ret] == 0, "bypass buffer not silent");
+		}
+	}
+	xmp_set_player(opaque, XMP_PLAYER_BYPASS, 0);
+	for (i = 0; i < 50; i++) {
+		xmp_render(opaque, buf, 1000, 0);
+	}
+	for (ret = 0; ret < 2000 && buf[ret] == 0; ret++);
+	fail_unless(ret < 2000, "nothing rendered before bypass");
+	xmp_set_player(opaque, XMP_PLAYER_BYPASS, 1);
+	for (i = 0; i < 5; i++) {
+		memset(buf, 0xff, sizeof(buf));
+		xmp_render(opaque, buf, 1000, 0);
+		for (ret = 0; ret < 2000; ret++) {
+			fail_unless(buf[ret] == 0, "bypass render not silent");
+		}
+	}
+	xmp_end_player(opaque);
+
+	/* Voices end up in the same state as when mixing */
+	for (interp = XMP_INTERP_NEAREST; interp <= XMP_INTERP_SINC; interp++) {
+		ret = play_checksum(opaque, interp, 0);
+		fail_unless(play_checksum(opaque, interp, 1) == ret,
+					"bypass voice state mismatch");
+	}
+
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
@@ -0,0 +1,88 @@
+#include "test.h"
+
+static int render_checksum(xmp_context opaque, int threads, int frames)
+{
+	struct xmp_frame_info fi;
+	int i, j, sum;
+	short *b;
+
+	xmp_set_player(opaque, XMP_PLAYER_THREADS, threads);
+	xmp_start_player(opaque, 22050, 0);
+
+	sum = 0;
+	for (i = 0; i < frames; i++) {
+		xmp_play_frame(opaque);
+		xmp_get_frame_info(opaque, &fi);
+		b = fi.buffer;
+		for (j = 0; j < fi.buffer_size / 2; j++) {
+			sum = sum * 31 + b[j];
+		}
+	}
+
+	xmp_end_player(opaque);
+
+	return sum;
+}
+
+/* Compare threaded mixing with single thread output, if available */
+static void check_threads(xmp_context opaque, int threads, int frames)
+{
+	int ret, sum;
+
+	sum = render_checksum(opaque, 1, frames);
+
+	if (xmp_set_player(opaque, XMP_PLAYER_THREADS, threads) == 0) {
+		ret = render_checksum(opaque, threads, frames);
+		fail_unless(ret == sum, "threaded mixer output mismatch");
+	}
+}
+
+TEST(test_api_player_threads)
+{
+	xmp_context opaque;
+	struct xmp_module_info mi;
+	int i, j, ret;
+
+	opaque = xmp_create_context();
+
+	ret = xmp_set_player(opaque, XMP_PLAYER_THREADS, 0);
+	fail_unless(ret == -XMP_ERROR_INVALID, "error setting invalid threads");
+	ret = xmp_set_player(opaque, XMP_PLAYER_THREADS, 1);
+	fail_unless(ret == 0, "error setting threads");
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+
+	check_threads(opaque, 4, 200);
+
+	/* More threads than voices */
+	check_threads(opaque, 8, 200);
+
+	xmp_start_player(opaque, 44100, 0);
+	ret = xmp_set_player(opaque, XMP_PLAYER_THREADS, 2);
+	fail_unless(ret == -XMP_ERROR_STATE, "threads set while playing");
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+
+	/* Background voices from new note actions, resonant filters and
+	 * voices reset at sample end
+	 */
+	ret = xmp_load_module(opaque, "data/m/4th_Symmetriad.it");
+	fail_unless(ret == 0, "module load error");
+
+	/* Random volume and pan swing would change the output */
+	xmp_get_module_info(opaque, &mi);
+	for (i = 0; i < mi.mod->ins; i++) {
+		for (j = 0; j < mi.mod->xxi[i].nsm; j++) {
+			mi.mod->xxi[i].sub[j].rvv = 0;
+		}
+	}
+
+	check_threads(opaque, 3, 3000);
+	check_threads(opaque, 16, 3000);
+
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
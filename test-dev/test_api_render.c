@@ -0,0 +1,70 @@
+#include "test.h"
+#include "../src/loaders/loader.h"
+
+static int vals[] = { 5, 58, 156, 350, 555, 1999, 3535, 5018, -1 };
+static short buffer[10000];
+
+#define REFBUF_SIZE 59520
+
+TEST(test_api_render)
+{
+	xmp_context opaque;
+	FILE *f;
+	int i, ret, cmp, size, frames;
+	char *ref_buffer;
+
+	f = fopen("data/pcm_buffer.raw", "rb");
+	ref_buffer = calloc(1, REFBUF_SIZE);
+	fail_unless(ref_buffer != NULL, "buffer allocation error");
+
+	fread(ref_buffer, 1, REFBUF_SIZE, f);
+	if (is_big_endian()) {
+		convert_endian((unsigned char *)ref_buffer, REFBUF_SIZE / 2);
+	}
+
+	opaque = xmp_create_context();
+
+	ret = xmp_load_module(opaque, "data/storlek_03.it");
+	fail_unless(ret == 0, "module load error");
+
+	ret = xmp_render(opaque, buffer, 1, 0);
+	fail_unless(ret == -XMP_ERROR_STATE, "state check error");
+
+	xmp_start_player(opaque, 8000, XMP_FORMAT_MONO);
+	xmp_set_player(opaque, XMP_PLAYER_INTERP, XMP_INTERP_LINEAR);
+
+	/* Same output as xmp_play_buffer() for any number of frames */
+	for (i = 0; vals[i] > 0; i++) {
+		xmp_restart_module(opaque);
+		size = 0;
+		frames = vals[i];
+
+		xmp_render(opaque, NULL, 0, 0);
+
+		while ((ret = xmp_render(opaque, buffer, frames, 1)) == frames) {
+			cmp = memcmp(buffer, ref_buffer + size, frames * 2);
+			fail_unless(cmp == 0, "buffer comparison failed");
+
+			size += frames * 2;
+		}
+
+		/* check end of module */
+		fail_unless(ret >= 0 && ret < frames, "end of module");
+		cmp = memcmp(buffer, ref_buffer + size, ret * 2);
+		fail_unless(cmp == 0, "buffer comparison failed");
+		fail_unless(size + ret * 2 == REFBUF_SIZE, "module length");
+	}
+
+	fail_unless(vals[i] == -1, "didn't test all buffer sizes");
+
+	/* Nothing more to render after the end of the module */
+	ret = xmp_render(opaque, buffer, 1000, 1);
+	fail_unless(ret == 0, "render after end of module");
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+	free(ref_buffer);
+	fclose(f);
+}
+END_TEST
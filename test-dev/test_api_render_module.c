@@ -0,0 +1,131 @@
+#include "test.h"
+
+static int checksum(char *b, long size)
+{
+	long i;
+	int sum;
+
+	sum = 0;
+	for (i = 0; i < size; i++) {
+		sum = sum * 31 + b[i];
+	}
+
+	return sum;
+}
+
+/* Play frame by frame until the module loops */
+static int play_checksum(xmp_context opaque, long *size)
+{
+	struct xmp_frame_info fi;
+	int sum, i;
+
+	sum = 0;
+	*size = 0;
+	for (;;) {
+		if (xmp_play_frame(opaque) < 0)
+			break;
+		xmp_get_frame_info(opaque, &fi);
+		if (fi.loop_count > 0)
+			break;
+		for (i = 0; i < fi.buffer_size; i++) {
+			sum = sum * 31 + ((char *)fi.buffer)[i];
+		}
+		*size += fi.buffer_size;
+	}
+
+	return sum;
+}
+
+/* Render with 1 to 4 threads and compare with playing frame by frame */
+static void check_threads(xmp_context opaque)
+{
+	char *buffer;
+	long ret, size;
+	int i, sum;
+
+	xmp_start_player(opaque, 8000, 0);
+	sum = play_checksum(opaque, &size);
+
+	buffer = malloc(size);
+	fail_unless(buffer != NULL, "can't allocate buffer");
+
+	for (i = 1; i <= 4; i++) {
+		xmp_start_player(opaque, 8000, 0);
+		ret = xmp_render_module(opaque, buffer, size, i);
+		if (ret == -XMP_ERROR_INVALID) {
+			break;
+		}
+		fail_unless(ret == size, "render size mismatch");
+		fail_unless(checksum(buffer, size) == sum,
+					"threaded render mismatch");
+	}
+
+	free(buffer);
+}
+
+TEST(test_api_render_module)
+{
+	xmp_context opaque;
+	struct xmp_frame_info fi;
+	char *buffer;
+	long ret, size;
+	int sum;
+
+	opaque = xmp_create_context();
+	ret = xmp_render_module(opaque, NULL, 0, 1);
+	fail_unless(ret == -XMP_ERROR_STATE, "state error");
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+
+	xmp_start_player(opaque, 8000, 0);
+	sum = play_checksum(opaque, &size);
+
+	xmp_start_player(opaque, 8000, 0);
+	ret = xmp_render_module(opaque, NULL, 0, 0);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid threads");
+	ret = xmp_render_module(opaque, NULL, 0, 1);
+	fail_unless(ret == size, "render size mismatch");
+
+	/* Player state is kept when querying the size */
+	xmp_get_frame_info(opaque, &fi);
+	fail_unless(fi.pos == 0 && fi.row == 0 && fi.loop_count == 0,
+						"player state changed");
+
+	buffer = malloc(size);
+	fail_unless(buffer != NULL, "can't allocate buffer");
+
+	ret = xmp_render_module(opaque, buffer, size - 1, 1);
+	fail_unless(ret == -XMP_ERROR_INVALID, "buffer too small");
+
+	ret = xmp_render_module(opaque, buffer, size, 1);
+	fail_unless(ret == size, "render size mismatch");
+	fail_unless(checksum(buffer, size) == sum, "render mismatch");
+
+	/* Player is at the end of the module */
+	xmp_get_frame_info(opaque, &fi);
+	fail_unless(fi.loop_count == 1, "player not at module end");
+
+	/* Same output when rendered in parallel, if available */
+	xmp_start_player(opaque, 8000, 0);
+	ret = xmp_render_module(opaque, buffer, size, 4);
+	if (ret != -XMP_ERROR_INVALID) {
+		fail_unless(ret == size, "render size mismatch");
+		fail_unless(checksum(buffer, size) == sum,
+					"threaded render mismatch");
+	}
+
+	free(buffer);
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+
+	/* Samples changed by invert loop are restored with each segment */
+	ret = xmp_load_module(opaque, "data/invloop.mod");
+	fail_unless(ret == 0, "module load error");
+	check_threads(opaque);
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+
+	xmp_free_context(opaque);
+}
+END_TEST
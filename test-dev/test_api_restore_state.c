@@ -0,0 +1,101 @@
+#include "test.h"
+
+#define NUM_FRAMES 50
+
+static int frame_sum(xmp_context opaque)
+{
+	struct xmp_frame_info fi;
+	int j, sum;
+	short *b;
+
+	xmp_get_frame_info(opaque, &fi);
+	b = fi.buffer;
+	sum = 0;
+	for (j = 0; j < fi.buffer_size / 2; j++) {
+		sum = sum * 31 + b[j];
+	}
+
+	return sum;
+}
+
+static void check_restore(xmp_context opaque, char *state, int size, int *sum)
+{
+	int i, ret;
+
+	ret = xmp_restore_state(opaque, state, size);
+	fail_unless(ret == 0, "error restoring state");
+
+	for (i = 0; i < NUM_FRAMES; i++) {
+		xmp_play_frame(opaque);
+		fail_unless(frame_sum(opaque) == sum[i], "wrong output");
+	}
+}
+
+TEST(test_api_restore_state)
+{
+	xmp_context opaque, opaque2;
+	int sum[NUM_FRAMES];
+	int i, ret, size;
+	char *state;
+
+	opaque = xmp_create_context();
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_start_player(opaque, 44100, 0);
+
+	size = xmp_get_state_size(opaque);
+	fail_unless(size > 0, "invalid state size");
+	state = malloc(size);
+	fail_unless(state != NULL, "state allocation error");
+
+	for (i = 0; i < 500; i++) {
+		xmp_play_frame(opaque);
+	}
+
+	ret = xmp_save_state(opaque, state, size);
+	fail_unless(ret == 0, "error saving state");
+
+	for (i = 0; i < NUM_FRAMES; i++) {
+		xmp_play_frame(opaque);
+		sum[i] = frame_sum(opaque);
+	}
+
+	/* The saved state doesn't refer to the player it came from */
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+
+	opaque2 = xmp_create_context();
+	ret = xmp_load_module(opaque2, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_start_player(opaque2, 44100, 0);
+
+	for (i = 0; i < 100; i++) {
+		xmp_play_frame(opaque2);
+	}
+	check_restore(opaque2, state, size, sum);
+
+	/* But voices are only restored at the same rate and format */
+	xmp_end_player(opaque2);
+	xmp_start_player(opaque2, 22050, 0);
+	ret = xmp_restore_state(opaque2, state, size);
+	fail_unless(ret == -XMP_ERROR_INVALID, "restored at another rate");
+	xmp_end_player(opaque2);
+	xmp_start_player(opaque2, 44100, XMP_FORMAT_MONO);
+	ret = xmp_restore_state(opaque2, state, size);
+	fail_unless(ret == -XMP_ERROR_INVALID, "restored in another format");
+
+	/* Or to the module data it was played from */
+	xmp_end_player(opaque2);
+	xmp_release_module(opaque2);
+	ret = xmp_load_module(opaque2, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_start_player(opaque2, 44100, 0);
+	check_restore(opaque2, state, size, sum);
+
+	free(state);
+	xmp_end_player(opaque2);
+	xmp_release_module(opaque2);
+	xmp_free_context(opaque2);
+}
+END_TEST
@@ -0,0 +1,103 @@
+#include "test.h"
+
+#define NUM_FRAMES 50
+
+static int frame_sum(xmp_context opaque)
+{
+	struct xmp_frame_info fi;
+	int j, sum;
+	short *b;
+
+	xmp_get_frame_info(opaque, &fi);
+	b = fi.buffer;
+	sum = 0;
+	for (j = 0; j < fi.buffer_size / 2; j++) {
+		sum = sum * 31 + b[j];
+	}
+
+	return sum;
+}
+
+TEST(test_api_save_state)
+{
+	xmp_context opaque;
+	struct xmp_frame_info fi;
+	int sum[NUM_FRAMES];
+	int i, k, ret, size;
+	char *state, *state2;
+
+	opaque = xmp_create_context();
+
+	ret = xmp_get_state_size(opaque);
+	fail_unless(ret == -XMP_ERROR_STATE, "state size before playing");
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+
+	ret = xmp_save_state(opaque, NULL, 0);
+	fail_unless(ret == -XMP_ERROR_STATE, "state saved before playing");
+
+	xmp_start_player(opaque, 44100, 0);
+
+	size = xmp_get_state_size(opaque);
+	fail_unless(size > 0, "invalid state size");
+	state = malloc(size);
+	fail_unless(state != NULL, "state allocation error");
+
+	ret = xmp_save_state(opaque, state, size - 1);
+	fail_unless(ret == -XMP_ERROR_INVALID, "state saved in short buffer");
+
+	for (i = 0; i < 500; i++) {
+		xmp_play_frame(opaque);
+	}
+
+	ret = xmp_save_state(opaque, state, size);
+	fail_unless(ret == 0, "error saving state");
+
+	xmp_get_frame_info(opaque, &fi);
+	for (i = 0; i < NUM_FRAMES; i++) {
+		xmp_play_frame(opaque);
+		sum[i] = frame_sum(opaque);
+	}
+
+	/* Replay the same ticks a few times */
+	for (k = 0; k < 3; k++) {
+		struct xmp_frame_info fi2;
+
+		ret = xmp_restore_state(opaque, state, size);
+		fail_unless(ret == 0, "error restoring state");
+		xmp_get_frame_info(opaque, &fi2);
+		fail_unless(fi2.pos == fi.pos && fi2.row == fi.row &&
+			fi2.frame == fi.frame, "wrong position after restore");
+
+		for (i = 0; i < NUM_FRAMES; i++) {
+			xmp_play_frame(opaque);
+			fail_unless(frame_sum(opaque) == sum[i], "wrong output");
+		}
+	}
+
+	ret = xmp_restore_state(opaque, state, 16);
+	fail_unless(ret == -XMP_ERROR_INVALID, "restored truncated state");
+
+	state2 = malloc(size);
+	fail_unless(state2 != NULL, "state allocation error");
+	memset(state2, 0, size);
+	ret = xmp_restore_state(opaque, state2, size);
+	fail_unless(ret == -XMP_ERROR_INVALID, "restored invalid state");
+
+	/* States belong to the module they were saved from */
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	ret = xmp_load_module(opaque, "data/test.xm");
+	fail_unless(ret == 0, "module load error");
+	xmp_start_player(opaque, 44100, 0);
+	ret = xmp_restore_state(opaque, state, size);
+	fail_unless(ret == -XMP_ERROR_INVALID, "restored state of other module");
+
+	free(state2);
+	free(state);
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include "test.h"
+
+TEST(test_api_scan_cache)
+{
+	xmp_context opaque;
+	struct xmp_module_info mi;
+	char name[64];
+	FILE *f;
+	int i, ret, num, duration;
+
+	opaque = xmp_create_context();
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_get_module_info(opaque, &mi);
+	duration = mi.seq_data[0].duration;
+
+	ret = snprintf(name, sizeof(name), "./");
+	for (i = 0; i < 16; i++) {
+		ret += snprintf(name + ret, sizeof(name) - ret, "%02x", mi.md5[i]);
+	}
+	snprintf(name + ret, sizeof(name) - ret, ".scan");
+	remove(name);
+
+	ret = xmp_set_scan_cache(opaque, ".");
+	fail_unless(ret == 0, "can't set scan cache");
+
+	/* Scan results are stored */
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_get_module_info(opaque, &mi);
+	fail_unless(mi.seq_data[0].duration == duration, "duration mismatch");
+	xmp_release_module(opaque);
+
+	f = fopen(name, "r+b");
+	fail_unless(f != NULL, "cache file not created");
+
+	/* Change the cached duration of the first sequence */
+	fseek(f, 44, SEEK_SET);
+	fputc(0x39, f);
+	fputc(0x30, f);
+	fputc(0, f);
+	fputc(0, f);
+	fclose(f);
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_get_module_info(opaque, &mi);
+	fail_unless(mi.seq_data[0].duration == 12345, "cache not used");
+	xmp_release_module(opaque);
+
+	/* Cache file with an invalid tempo is ignored */
+	f = fopen(name, "r+b");
+	fail_unless(f != NULL, "can't open cache file");
+	fseek(f, 36, SEEK_SET);
+	num = fgetc(f);
+	fseek(f, 40 + num * 24 + 5, SEEK_SET);
+	for (i = 0; i < 4; i++) {
+		fputc(0, f);
+	}
+	fclose(f);
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_get_module_info(opaque, &mi);
+	fail_unless(mi.seq_data[0].duration == duration, "invalid cache used");
+	xmp_release_module(opaque);
+
+	/* Truncated cache file is ignored */
+	f = fopen(name, "wb");
+	fail_unless(f != NULL, "can't truncate cache file");
+	fclose(f);
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_get_module_info(opaque, &mi);
+	fail_unless(mi.seq_data[0].duration == duration, "duration mismatch");
+	xmp_release_module(opaque);
+
+	ret = xmp_set_scan_cache(opaque, NULL);
+	fail_unless(ret == 0, "can't disable scan cache");
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_get_module_info(opaque, &mi);
+	fail_unless(mi.seq_data[0].duration == duration, "duration mismatch");
+
+	remove(name);
+	xmp_free_context(opaque);
+}
+END_TEST
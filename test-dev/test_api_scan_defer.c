@@ -0,0 +1,96 @@
+#include "test.h"
+
+static int play_checksum(xmp_context opaque, int *frames)
+{
+	struct xmp_frame_info fi;
+	int sum, i;
+
+	sum = 0;
+	for (*frames = 0; ; (*frames)++) {
+		if (xmp_play_frame(opaque) < 0)
+			break;
+		xmp_get_frame_info(opaque, &fi);
+		if (fi.loop_count > 0)
+			break;
+		for (i = 0; i < fi.buffer_size; i++) {
+			sum = sum * 31 + ((char *)fi.buffer)[i];
+		}
+	}
+
+	return sum;
+}
+
+TEST(test_api_scan_defer)
+{
+	xmp_context opaque;
+	struct xmp_module_info mi;
+	struct xmp_frame_info fi;
+	int ret, sum, frames, duration, sum2, frames2;
+
+	opaque = xmp_create_context();
+
+	ret = xmp_set_player(opaque, XMP_PLAYER_SCAN, 2);
+	fail_unless(ret == -XMP_ERROR_INVALID, "invalid value");
+	ret = xmp_get_player(opaque, XMP_PLAYER_SCAN);
+	fail_unless(ret == XMP_SCAN_LOAD, "default value");
+
+	/* Scan when loading */
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	ret = xmp_set_player(opaque, XMP_PLAYER_SCAN, XMP_SCAN_DEFER);
+	fail_unless(ret == -XMP_ERROR_STATE, "set after load");
+	xmp_get_module_info(opaque, &mi);
+	duration = mi.seq_data[0].duration;
+	fail_unless(duration > 0, "no duration");
+	xmp_start_player(opaque, 8000, 0);
+	sum = play_checksum(opaque, &frames);
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+
+	ret = xmp_set_player(opaque, XMP_PLAYER_SCAN, XMP_SCAN_DEFER);
+	fail_unless(ret == 0, "can't defer scan");
+	ret = xmp_get_player(opaque, XMP_PLAYER_SCAN);
+	fail_unless(ret == XMP_SCAN_DEFER, "value not set");
+
+	/* Play before the scan results are used */
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_start_player(opaque, 8000, 0);
+	sum2 = play_checksum(opaque, &frames2);
+	fail_unless(sum2 == sum, "checksum mismatch");
+	fail_unless(frames2 == frames, "end of module mismatch");
+	xmp_get_frame_info(opaque, &fi);
+	fail_unless(fi.total_time == duration, "total time mismatch");
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+
+	/* Module information waits for the scan */
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_get_module_info(opaque, &mi);
+	fail_unless(mi.num_sequences == 1, "sequences mismatch");
+	fail_unless(mi.seq_data[0].duration == duration, "duration mismatch");
+
+	xmp_release_module(opaque);
+
+	/* Seek right after starting */
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_set_player(opaque, XMP_PLAYER_SEEK_MEMORY, 1024);
+	xmp_start_player(opaque, 8000, 0);
+	ret = xmp_seek_time(opaque, duration / 2);
+	fail_unless(ret > 0, "seek error");
+	xmp_play_frame(opaque);
+	xmp_get_frame_info(opaque, &fi);
+	fail_unless(fi.time >= duration / 2 - 100 && fi.time <= duration / 2 + 100,
+							"seek time mismatch");
+	xmp_end_player(opaque);
+
+	/* Release while the scan may still be running */
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	xmp_release_module(opaque);
+
+	xmp_free_context(opaque);
+}
+END_TEST
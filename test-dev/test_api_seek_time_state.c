@@ -0,0 +1,78 @@
+#include "test.h"
+
+#define NUM_FRAMES 1500
+
+static int frame_sum(xmp_context opaque)
+{
+	struct xmp_frame_info fi;
+	int j, sum;
+	short *b;
+
+	xmp_get_frame_info(opaque, &fi);
+	b = fi.buffer;
+	sum = 0;
+	for (j = 0; j < fi.buffer_size / 2; j++) {
+		sum = sum * 31 + b[j];
+	}
+
+	return sum;
+}
+
+static const int seek[] = {
+	21230, 12345, 2000, 29000, 7777, 0, 15010, 15030, -1
+};
+
+TEST(test_api_seek_time_state)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	static double start[NUM_FRAMES];
+	static int sum[NUM_FRAMES];
+	int i, j, ret;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+
+	/* Snapshots are only taken if enabled */
+	ret = xmp_get_player(opaque, XMP_PLAYER_SEEK_MEMORY);
+	fail_unless(ret == 0, "seek memory set by default");
+	xmp_start_player(opaque, 8000, 0);
+	xmp_play_frame(opaque);
+	fail_unless(ctx->p.snapshot.slot == NULL, "snapshots taken by default");
+
+	ret = xmp_set_player(opaque, XMP_PLAYER_SEEK_MEMORY, -1);
+	fail_unless(ret == -XMP_ERROR_INVALID, "negative seek memory set");
+	ret = xmp_set_player(opaque, XMP_PLAYER_SEEK_MEMORY, 1024);
+	fail_unless(ret == 0, "error setting seek memory");
+
+	xmp_start_player(opaque, 8000, 0);
+	for (i = 0; i < NUM_FRAMES; i++) {
+		start[i] = ctx->p.play_time;
+		xmp_play_frame(opaque);
+		sum[i] = frame_sum(opaque);
+	}
+
+	/* Seeking must land on the same tick as continuous playback, with
+	 * the same channel and voice state */
+	xmp_start_player(opaque, 8000, 0);
+	for (i = 0; seek[i] >= 0; i++) {
+		for (j = 0; j < NUM_FRAMES - 1; j++) {
+			if (start[j + 1] > seek[i])
+				break;
+		}
+		xmp_seek_time(opaque, seek[i]);
+		fail_unless(ctx->p.play_time == start[j], "wrong seek time");
+		xmp_play_frame(opaque);
+		fail_unless(frame_sum(opaque) == sum[j], "wrong seek state");
+		xmp_play_frame(opaque);
+		fail_unless(frame_sum(opaque) == sum[j + 1], "wrong seek state");
+	}
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
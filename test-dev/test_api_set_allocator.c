@@ -0,0 +1,93 @@
+#include "test.h"
+
+/* Counting allocator, the block size is stored before the data */
+
+#define HDR 16
+
+static int live, total;
+static size_t bytes;
+
+static void *count_malloc(size_t size)
+{
+	char *p = malloc(size + HDR);
+	if (p == NULL)
+		return NULL;
+	*(size_t *)p = size;
+	live++;
+	total++;
+	bytes += size;
+	return p + HDR;
+}
+
+static void *count_calloc(size_t num, size_t size)
+{
+	void *p = count_malloc(num * size);
+	if (p != NULL)
+		memset(p, 0, num * size);
+	return p;
+}
+
+static void count_free(void *ptr)
+{
+	char *p = (char *)ptr - HDR;
+	live--;
+	bytes -= *(size_t *)p;
+	free(p);
+}
+
+static void *count_realloc(void *ptr, size_t size)
+{
+	void *p;
+	size_t old;
+
+	if (ptr == NULL)
+		return count_malloc(size);
+
+	old = *(size_t *)((char *)ptr - HDR);
+	if ((p = count_malloc(size)) == NULL)
+		return NULL;
+	memcpy(p, ptr, old < size ? old : size);
+	count_free(ptr);
+	return p;
+}
+
+TEST(test_api_set_allocator)
+{
+	xmp_context opaque;
+	int ret;
+
+	ret = xmp_set_allocator(count_malloc, NULL, count_realloc, count_free);
+	fail_unless(ret == -XMP_ERROR_INVALID, "incomplete allocator");
+
+	ret = xmp_set_allocator(count_malloc, count_calloc, count_realloc,
+								count_free);
+	fail_unless(ret == 0, "can't set allocator");
+
+	opaque = xmp_create_context();
+	fail_unless(opaque != NULL, "can't create context");
+
+	/* Compressed module, the depacker also uses the allocator */
+	ret = xmp_load_module(opaque, "data/xzdata");
+	fail_unless(ret == 0, "can't load module");
+	fail_unless(live > 0 && bytes > 0, "allocator not used");
+
+	xmp_start_player(opaque, 44100, 0);
+	xmp_play_frame(opaque);
+	xmp_end_player(opaque);
+
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+	fail_unless(live == 0, "allocations not released");
+	fail_unless(bytes == 0, "bytes not released");
+	fail_unless(total > 0, "allocator not used");
+
+	ret = xmp_set_allocator(NULL, NULL, NULL, NULL);
+	fail_unless(ret == 0, "can't reset allocator");
+
+	/* The C library functions are used again */
+	total = 0;
+	opaque = xmp_create_context();
+	xmp_free_context(opaque);
+	fail_unless(total == 0, "allocator not reset");
+}
+END_TEST
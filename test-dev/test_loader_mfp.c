@@ -4,6 +4,7 @@ TEST(test_loader_mfp)
 {
 	xmp_context opaque;
 	struct xmp_module_info info;
+	struct xmp_test_info ti;
 	FILE *f;
 	int ret;
 
@@ -20,5 +21,11 @@ TEST(test_loader_mfp)
 
 	xmp_release_module(opaque);
 	xmp_free_context(opaque);
+
+	/* Packed modules are still recognized */
+	ret = xmp_test_module("data/mfp.gz", &ti);
+	fail_unless(ret == 0, "packed module not recognized");
+	fail_unless(strcmp(ti.type, "Magnetic Fields Packer") == 0,
+						"wrong packed module format");
 }
 END_TEST
@@ -0,0 +1,61 @@
+#include "test.h"
+#include "../src/format.h"
+
+/* Formats that only accept their listed signatures are not probed for
+ * modules without one of them */
+
+static int test_none(HIO_HANDLE *f, char *t, const int start)
+{
+	return -1;
+}
+
+static const struct format_loader loader_a = { "A", test_none, NULL };
+static const struct format_loader loader_b = { "B", test_none, NULL };
+static const struct format_loader loader_c = { "C", test_none, NULL };
+
+static const struct format_loader *const loader[] = {
+	&loader_a, &loader_b, &loader_c, NULL
+};
+
+static const struct format_magic magic[] = {
+	{ &loader_a, 0, 4, "AAAA", 1 },
+	{ &loader_a, 0, 4, "AAAB", 1 },
+	{ &loader_b, 4, 4, "BBBB", 0 },
+	{ NULL }
+};
+
+TEST(test_loader_unknown)
+{
+	uint8 buf[16];
+	char match[4];
+	int ret;
+
+	/* Unknown file */
+	memset(buf, 0, 16);
+	libxmp_match_formats(loader, magic, buf, 16, match);
+	fail_unless(match[0] == 0, "format A probed");
+	fail_unless(match[1] == FORMAT_PROBE, "format B not probed");
+	fail_unless(match[2] == FORMAT_PROBE, "format C not probed");
+
+	/* Any of the signatures of a format */
+	memcpy(buf, "AAAB", 4);
+	libxmp_match_formats(loader, magic, buf, 16, match);
+	fail_unless(match[0] == FORMAT_MATCH, "format A not matched");
+	fail_unless(match[1] == FORMAT_PROBE, "format B not probed");
+
+	memcpy(buf + 4, "BBBB", 4);
+	libxmp_match_formats(loader, magic, buf, 16, match);
+	fail_unless(match[0] == FORMAT_MATCH, "format A not matched");
+	fail_unless(match[1] == FORMAT_MATCH, "format B not matched");
+
+	/* Signatures past the end of a short file don't match */
+	libxmp_match_formats(loader, magic, buf, 6, match);
+	fail_unless(match[0] == FORMAT_MATCH, "format A not matched");
+	fail_unless(match[1] == FORMAT_PROBE, "format B not probed");
+	libxmp_match_formats(loader, magic, buf, 2, match);
+	fail_unless(match[0] == 0, "format A probed");
+
+	ret = xmp_test_module("data/beep.raw", NULL);
+	fail_unless(ret == -XMP_ERROR_FORMAT, "unknown file accepted");
+}
+END_TEST
@@ -0,0 +1,57 @@
+#include "test.h"
+#include "../src/mixer.h"
+#include "../src/virtual.h"
+
+/* 16-bit samples in Amiga modules are played by the Paula mixers */
+
+TEST(test_mixer_a500_16bit)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	struct mixer_data *s;
+	struct xmp_frame_info info;
+	int i, j, ret, peak;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+	s = &ctx->s;
+
+	ret = xmp_load_module(opaque, "data/mod.loving_is_easy.pp");
+	fail_unless(ret == 0, "load module");
+
+	xmp_start_smix(opaque, 1, 1);
+	ret = xmp_smix_load_sample(opaque, 0, "data/blip.wav");
+	fail_unless(ret == 0, "load sample");
+
+	xmp_start_player(opaque, 44100, XMP_FORMAT_MONO);
+	xmp_set_player(opaque, XMP_PLAYER_CFLAGS, XMP_FLAGS_A500);
+	fail_unless(xmp_get_player(opaque, XMP_PLAYER_MIXER_TYPE)
+			== XMP_MIXER_A500, "mixer type");
+
+	for (i = 0; i < 4; i++) {
+		xmp_channel_mute(opaque, i, 1);
+	}
+
+	xmp_play_frame(opaque);
+	ret = xmp_smix_play_sample(opaque, 0, 60, 64, 0);
+	fail_unless(ret == 0, "play sample");
+
+	peak = 0;
+	for (i = 0; i < 5; i++) {
+		xmp_play_frame(opaque);
+		xmp_get_frame_info(opaque, &info);
+		for (j = 0; j < info.buffer_size / 2; j++) {
+			int val = s->buf32[j] < 0 ? -s->buf32[j] : s->buf32[j];
+			if (val > peak) {
+				peak = val;
+			}
+		}
+	}
+	fail_unless(peak > 0, "sample not mixed");
+
+	xmp_end_smix(opaque);
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
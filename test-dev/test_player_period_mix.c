@@ -0,0 +1,26 @@
+#include "test.h"
+#include "../src/period.h"
+#include <math.h>
+
+/* Mixer periods come from lookup tables, check them against pow() */
+
+TEST(test_player_period_mix)
+{
+	double per, ref;
+	int n, b;
+
+	for (n = 0; n < 128; n++) {
+		for (b = -25600; b < 25600; b += 37) {
+			per = libxmp_note_to_period_mix(n, b);
+			ref = PERIOD_BASE / pow(2, ((double)n + (double)b / 12800) / 12);
+			fail_unless(fabs(per - ref) <= ref * 1e-13, "bad period");
+		}
+	}
+
+	/* whole octaves are exact */
+	for (n = 0; n < 128; n += 12) {
+		per = libxmp_note_to_period_mix(n, 0);
+		fail_unless(per == ldexp(PERIOD_BASE, -n / 12), "bad octave");
+	}
+}
+END_TEST
@@ -0,0 +1,102 @@
+#include <limits.h>
+#include "test.h"
+#include "../src/mixer.h"
+
+/* Free and stolen voices must be the ones a linear search would find */
+
+static void check_voices(struct context_data *ctx)
+{
+	struct player_data *p = &ctx->p;
+	int i, free_voc, steal_voc, vol, num_free, num_bg;
+
+	free_voc = steal_voc = -1;
+	vol = INT_MAX;
+	num_free = num_bg = 0;
+
+	for (i = 0; i < p->virt.maxvoc; i++) {
+		struct mixer_voice *vi = &p->virt.voice_array[i];
+
+		if (vi->chn < 0) {
+			if (free_voc < 0) {
+				free_voc = i;
+			}
+			num_free++;
+		} else if (vi->chn >= p->virt.num_tracks) {
+			if (vi->vol < vol) {
+				steal_voc = i;
+				vol = vi->vol;
+			}
+			num_bg++;
+		}
+	}
+
+	fail_unless(p->virt.free_heap.num == num_free, "free voice count");
+	fail_unless(p->virt.steal_heap.num == num_bg, "background voice count");
+
+	if (num_free > 0) {
+		fail_unless(p->virt.free_heap.voc[0] == free_voc, "free voice");
+	}
+	if (num_bg > 0) {
+		fail_unless(p->virt.steal_heap.voc[0] == steal_voc, "stolen voice");
+	}
+}
+
+TEST(test_player_voice_steal)
+{
+	xmp_context opaque;
+	struct context_data *ctx;
+	struct module_data *m;
+	struct xmp_frame_info fi;
+	int i, j, max_used;
+
+	opaque = xmp_create_context();
+	ctx = (struct context_data *)opaque;
+	m = &ctx->m;
+
+ 	create_simple_module(ctx, 2, 2);
+	set_instrument_nna(ctx, 0, 0, XMP_INST_NNA_CONT, XMP_INST_DCT_OFF,
+							XMP_INST_DCA_CUT);
+	set_instrument_nna(ctx, 1, 0, XMP_INST_NNA_FADE, XMP_INST_DCT_OFF,
+							XMP_INST_DCA_CUT);
+	set_instrument_fadeout(ctx, 1, 0x100);
+
+	m->mod.spd = 3;
+	xmp_scan_module(opaque);
+
+	set_instrument_envelope(ctx, 0, 0, 0, 64);
+	set_instrument_envelope(ctx, 0, 1, 120, 0);
+
+	for (i = 0; i < 64; i++) {
+		for (j = 0; j < 4; j++) {
+			new_event(ctx, 0, i, j, 50 + (i + j) % 24, 1 + (i + j) % 2,
+					1 + (i * 7 + j * 13) % 64, 0, 0, 0, 0);
+		}
+	}
+	set_quirk(ctx, QUIRKS_IT, READ_EVENT_IT);
+
+	xmp_start_player(opaque, 44100, 0);
+	check_voices(ctx);
+
+	max_used = 0;
+	for (i = 0; i < 64 * 3; i++) {
+		xmp_play_frame(opaque);
+		xmp_get_frame_info(opaque, &fi);
+		check_voices(ctx);
+
+		if (fi.virt_used > max_used) {
+			max_used = fi.virt_used;
+		}
+	}
+
+	/* make sure voices were stolen */
+	fail_unless(max_used == ctx->p.virt.maxvoc, "all voices used");
+
+	xmp_restart_module(opaque);
+	xmp_play_frame(opaque);
+	check_voices(ctx);
+
+	xmp_end_player(opaque);
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST
@@ -0,0 +1,69 @@
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "test.h"
+#include "../src/hio.h"
+
+TEST(test_read_file_hio)
+{
+	uint8 buf[100], buf2[100];
+	FILE *f;
+	int i;
+	int x;
+	long size;
+	HIO_HANDLE *h;
+
+	f = fopen("data/test.mmcmp", "rb");
+	fail_unless(f != NULL, "can't open data file");
+	x = fread(buf, 1, 100, f);
+	fail_unless(x == 100, "fread");
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	fclose(f);
+
+	h = hio_open("data/test.mmcmp", "rb");
+	fail_unless(h != NULL, "hio_open");
+	fail_unless(HIO_HANDLE_FILE(h) != NULL, "hio file");
+
+	x = hio_size(h);
+	fail_unless(x == size, "hio_size");
+
+	x = hio_read8(h);
+	fail_unless(x == buf[0], "hio_read8");
+
+	x = hio_read16l(h);
+	fail_unless(x == readmem16l(buf + 1), "hio_read16l");
+
+	x = hio_read32b(h);
+	fail_unless(x == readmem32b(buf + 3), "hio_read32b");
+
+	x = hio_tell(h);
+	fail_unless(x == 7, "hio_tell");
+
+	x = hio_seek(h, 10, SEEK_SET);
+	fail_unless(x == 0, "hio_seek SEEK_SET");
+
+	x = hio_read(buf2, 1, 50, h);
+	fail_unless(x == 50, "hio_read");
+	for (i = 0; i < 50; i++)
+		fail_unless(buf2[i] == buf[i + 10], "hio_read data");
+
+	x = hio_seek(h, -20, SEEK_CUR);
+	fail_unless(x == 0, "hio_seek SEEK_CUR");
+	x = hio_read32l(h);
+	fail_unless(x == readmem32l(buf + 40), "hio_read32l");
+
+	x = hio_seek(h, 0, SEEK_END);
+	fail_unless(x == 0, "hio_seek SEEK_END");
+	fail_unless(hio_tell(h) == size, "hio_tell end");
+
+	x = hio_read8(h);
+	x = hio_eof(h);
+	fail_unless(x != 0, "read8 eof");
+
+	x = hio_read(buf2, 1, 10, h);
+	fail_unless(x == 0, "hio_read eof");
+
+	x = hio_close(h);
+	fail_unless(x == 0, "hio_close");
+}
+END_TEST
@@ -0,0 +1,119 @@
+#include "test.h"
+#include "../src/med_extras.h"
+
+/* Play frame by frame until the module loops */
+static int play_checksum(xmp_context opaque)
+{
+	struct xmp_frame_info fi;
+	int sum, i;
+
+	sum = 0;
+	xmp_start_player(opaque, 8000, 0);
+	for (;;) {
+		if (xmp_play_frame(opaque) < 0)
+			break;
+		xmp_get_frame_info(opaque, &fi);
+		if (fi.loop_count > 0)
+			break;
+		for (i = 0; i < fi.buffer_size; i++) {
+			sum = sum * 31 + ((char *)fi.buffer)[i];
+		}
+	}
+	xmp_end_player(opaque);
+
+	return sum;
+}
+
+/* Load a synth module with an envelope on a waveform never played */
+static int load_envelope(xmp_context opaque)
+{
+	struct context_data *ctx = (struct context_data *)opaque;
+	struct med_module_extras *me;
+	uint8 *vt;
+	int ret;
+
+	ret = xmp_load_module(opaque, "data/m/Synth-a-sysmic.med");
+	if (ret < 0)
+		return ret;
+
+	/* EN1 on waveform 5 (128 bytes), then END */
+	me = MED_MODULE_EXTRAS(ctx->m);
+	vt = me->vol_table[3];
+	vt[0] = 0xf4;
+	vt[1] = 5;
+	vt[2] = 0xff;
+
+	return 0;
+}
+
+TEST(test_sample_load_lazy)
+{
+	xmp_context opaque;
+	struct xmp_module_info mi;
+	int ret, sum, i, loaded;
+	FILE *f;
+	void *buf;
+	long size;
+
+	opaque = xmp_create_context();
+
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+	sum = play_checksum(opaque);
+	xmp_release_module(opaque);
+
+	xmp_set_player(opaque, XMP_PLAYER_SMPCTL, XMP_SMPCTL_LAZY);
+	ret = xmp_load_module(opaque, "data/ode2ptk.mod");
+	fail_unless(ret == 0, "module load error");
+
+	/* No sample data is loaded with the module */
+	xmp_get_module_info(opaque, &mi);
+	loaded = 0;
+	for (i = 0; i < mi.mod->smp; i++) {
+		if (mi.mod->xxs[i].data != NULL)
+			loaded++;
+	}
+	fail_unless(loaded == 0, "sample data loaded");
+
+	/* Samples are loaded when played */
+	fail_unless(play_checksum(opaque) == sum, "lazy replay mismatch");
+	for (i = 0; i < mi.mod->smp; i++) {
+		if (mi.mod->xxs[i].data != NULL)
+			loaded++;
+	}
+	fail_unless(loaded > 0, "sample data not loaded");
+	xmp_release_module(opaque);
+
+	/* Modules loaded from memory are loaded at once */
+	f = fopen("data/ode2ptk.mod", "rb");
+	fail_unless(f != NULL, "can't open module");
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	buf = malloc(size);
+	fail_unless(fread(buf, 1, size, f) == size, "can't read module");
+	fclose(f);
+
+	ret = xmp_load_module_from_memory(opaque, buf, size);
+	fail_unless(ret == 0, "module load error");
+	free(buf);
+	fail_unless(play_checksum(opaque) == sum, "replay mismatch");
+
+	xmp_release_module(opaque);
+
+	/* Synth envelopes read waveforms that were not played yet */
+	xmp_set_player(opaque, XMP_PLAYER_SMPCTL, 0);
+	ret = load_envelope(opaque);
+	fail_unless(ret == 0, "module load error");
+	sum = play_checksum(opaque);
+	xmp_release_module(opaque);
+
+	xmp_set_player(opaque, XMP_PLAYER_SMPCTL, XMP_SMPCTL_LAZY);
+	ret = load_envelope(opaque);
+	fail_unless(ret == 0, "module load error");
+	fail_unless(play_checksum(opaque) == sum, "lazy synth replay mismatch");
+
+	xmp_release_module(opaque);
+	xmp_free_context(opaque);
+}
+END_TEST